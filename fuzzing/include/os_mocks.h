@@ -0,0 +1,30 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Deterministic mocks of the APDU trace replayer, enabled with APDU_REPLAY.
+// Fuzzers are built without it and keep the plain mocks.
+
+// Every byte of mocked hash digests. Non-zero to pass "is zero" checks.
+#define MOCK_DIGEST_BYTE 0x01
+
+// Max response data length (without status word), longer responses abort
+#define MOCK_RESPONSE_MAX_LEN 256
+
+/**
+ * Last response sent by the application through io_send_response_buffers.
+ */
+typedef struct {
+    bool sent;
+    uint16_t sw;
+    size_t len;
+    uint8_t data[MOCK_RESPONSE_MAX_LEN];
+} mock_response_t;
+
+extern mock_response_t G_mock_response;
+
+/**
+ * Disables printing of displayed texts.
+ */
+extern bool G_mock_display_silent;
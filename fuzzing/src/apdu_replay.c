@@ -0,0 +1,349 @@
+#include <cx.h>
+#include <os_io.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <parser.h>
+#include <offsets.h>
+#include <ux.h>
+#include <buffer_ext.h>
+
+#include "os_mocks.h"
+#include "apdu_dispatcher.h"
+#include "sw.h"
+#include "context.h"
+#include "helpers/input_frame.h"
+#include "commands/attestinput/ainpt_handler.h"
+#include "commands/signtx/stx_handler.h"
+
+// Replays APDU trace recorded by tests/helpers/trace.js through the apdu_dispatcher.
+//
+// Trace format (all integers are big-endian):
+//   magic "EAPT" | version (1 byte) | records...
+//   record: command length (2 bytes) | command | response length (2 bytes) | response data || SW
+//
+// UI flows are approved automatically, only BAGL flows are supported. Status words,
+// response lengths and response data are compared with the recorded ones. Data computed
+// by mocked cryptography or depending on the build flags is skipped, see masked_byte,
+// unless in strict mode. Session ids and input frame signatures are rebound to the
+// values of the replayed session.
+
+#define TRACE_MAGIC         "EAPT"
+#define TRACE_MAGIC_LEN     4
+#define TRACE_VERSION       1
+#define TRACE_MAX_APDU_LEN  (5 + 255)
+#define UI_MAX_BUTTON_PRESS 4096
+
+typedef struct {
+    const uint8_t *command;
+    uint16_t command_len;
+    const uint8_t *response;
+    uint16_t response_len;
+} trace_record_t;
+
+typedef struct {
+    bool strict;
+    bool verbose;
+    uint32_t repeat;
+} replay_options_t;
+
+// Recorded session id -> replayed session id
+static uint8_t G_session_map[2][UINT8_MAX + 1];
+
+// Steps with approving callbacks
+extern const ux_flow_step_t ux_approve_step;
+extern const ux_flow_step_t ux_sign_step;
+
+static uint8_t *read_file(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+    fseek(file, 0, SEEK_END);
+    long len = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *data = len > 0 ? malloc(len) : NULL;
+    if (data != NULL && fread(data, 1, len, file) != (size_t) len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = data != NULL ? (size_t) len : 0;
+    return data;
+}
+
+static bool read_chunk(buffer_t *trace, const uint8_t **ptr, uint16_t *len) {
+    if (!buffer_read_u16(trace, len, BE)) return false;
+    if (!buffer_can_read(trace, *len)) return false;
+    *ptr = buffer_read_ptr(trace);
+    return buffer_seek_cur(trace, *len);
+}
+
+static bool read_record(buffer_t *trace, trace_record_t *record) {
+    return read_chunk(trace, &record->command, &record->command_len) &&
+           read_chunk(trace, &record->response, &record->response_len) &&
+           record->command_len >= 5 && record->command_len <= TRACE_MAX_APDU_LEN &&
+           record->response_len >= 2;
+}
+
+static inline int session_slot(uint8_t ins) {
+    switch (ins) {
+        case CMD_ATTEST_INPUT_BOX:
+            return 0;
+        case CMD_SIGN_TRANSACTION:
+            return 1;
+        default:
+            return -1;
+    }
+}
+
+static inline bool is_session_start(uint8_t ins, uint8_t p1) {
+    return (ins == CMD_ATTEST_INPUT_BOX && p1 == ATTEST_INPUT_SUBCOMMAND_INIT) ||
+           (ins == CMD_SIGN_TRANSACTION && p1 == SIGN_TRANSACTION_SUBCOMMAND_SIGN_PK);
+}
+
+// Replaces recorded session id and input frame signature with the replayed ones
+static void rebind_command(uint8_t *apdu, uint16_t len) {
+    uint8_t ins = apdu[OFFSET_INS], p1 = apdu[OFFSET_P1];
+    int slot = session_slot(ins);
+    if (slot < 0 || is_session_start(ins, p1)) return;
+
+    apdu[OFFSET_P2] = G_session_map[slot][apdu[OFFSET_P2]];
+
+    if (ins == CMD_SIGN_TRANSACTION && p1 == SIGN_TRANSACTION_SUBCOMMAND_INPUT_FRAME) {
+        buffer_t frame;
+        buffer_init(&frame, apdu + OFFSET_CDATA, len - OFFSET_CDATA);
+        uint8_t data_len = input_frame_data_length(&frame);
+        if (data_len == 0) return;
+        uint8_t signature[CX_SHA256_SIZE];
+        cx_hmac_sha256(app_session_key(),
+                       SESSION_KEY_LEN,
+                       apdu + OFFSET_CDATA,
+                       data_len,
+                       signature,
+                       CX_SHA256_SIZE);
+        memcpy(apdu + OFFSET_CDATA + data_len, signature, INPUT_FRAME_SIGNATURE_LEN);
+    }
+}
+
+// Stores mapping between recorded and replayed session ids
+static void rebind_response(const uint8_t *apdu, const trace_record_t *record) {
+    int slot = session_slot(apdu[OFFSET_INS]);
+    if (slot < 0 || !is_session_start(apdu[OFFSET_INS], apdu[OFFSET_P1])) return;
+    if (record->response_len != 3 || G_mock_response.len != 1) return;
+    G_session_map[slot][record->response[0]] = G_mock_response.data[0];
+}
+
+static bool press_buttons(unsigned int mask) {
+    ux_stack_slot_t *slot = &G_ux.stack[G_ux.stack_count - 1];
+    if (slot->button_push_callback == NULL) return false;
+    slot->button_push_callback(mask, 0);
+    return true;
+}
+
+// Scrolls current flow to the approve step and validates it
+static bool auto_approve(void) {
+    for (int i = 0; i < UI_MAX_BUTTON_PRESS && !G_mock_response.sent; i++) {
+        const ux_flow_step_t *step = ux_flow_get_current();
+        if (step == &ux_approve_step || step == &ux_sign_step) {
+            if (!press_buttons(BUTTON_EVT_RELEASED | BUTTON_LEFT | BUTTON_RIGHT)) return false;
+        } else if (!press_buttons(BUTTON_EVT_RELEASED | BUTTON_RIGHT)) {
+            return false;
+        }
+    }
+    return G_mock_response.sent;
+}
+
+// Response bytes which can't match the device: computed by mocked cryptography,
+// random session ids and the build dependent version, limits and counters
+static bool masked_byte(const uint8_t *apdu, const trace_record_t *record, size_t i) {
+    uint8_t p1 = apdu[OFFSET_P1];
+    switch (apdu[OFFSET_INS]) {
+        case CMD_GET_APP_NAME:
+            return false;
+        case CMD_ATTEST_INPUT_BOX: {
+            if (p1 == ATTEST_INPUT_SUBCOMMAND_INIT) return true;
+            if (p1 != ATTEST_INPUT_SUBCOMMAND_GET_RESPONSE_FRAME) return false;
+            // box id and signature of the frame
+            buffer_t frame;
+            buffer_init(&frame, record->response, record->response_len - 2);
+            uint8_t data_len = input_frame_data_length(&frame);
+            return i < ERGO_ID_LEN || data_len == 0 || i >= data_len;
+        }
+        case CMD_SIGN_TRANSACTION:
+            return p1 == SIGN_TRANSACTION_SUBCOMMAND_SIGN_PK ||
+                   p1 == SIGN_TRANSACTION_SUBCOMMAND_CONFIRM;
+        default:
+            return true;
+    }
+}
+
+static bool check_response(size_t index,
+                           const uint8_t *apdu,
+                           const trace_record_t *record,
+                           const replay_options_t *options) {
+    uint16_t sw = (record->response[record->response_len - 2] << 8) |
+                  record->response[record->response_len - 1];
+    size_t data_len = record->response_len - 2;
+
+    if (!G_mock_response.sent) {
+        fprintf(stderr, "#%zu: no response, expected %04X\n", index, sw);
+        return false;
+    }
+    if (G_mock_response.sw != sw) {
+        fprintf(stderr, "#%zu: SW %04X, expected %04X\n", index, G_mock_response.sw, sw);
+        return false;
+    }
+    if (G_mock_response.len != data_len) {
+        fprintf(stderr,
+                "#%zu: response length %zu, expected %zu\n",
+                index,
+                G_mock_response.len,
+                data_len);
+        return false;
+    }
+    for (size_t i = 0; i < data_len; i++) {
+        if (G_mock_response.data[i] == record->response[i]) continue;
+        if (!options->strict && masked_byte(apdu, record, i)) continue;
+        fprintf(stderr,
+                "#%zu: response byte %zu is %02X, expected %02X\n",
+                index,
+                i,
+                G_mock_response.data[i],
+                record->response[i]);
+        return false;
+    }
+    return true;
+}
+
+static int dispatch(uint8_t *apdu, uint16_t len) {
+    command_t cmd;
+    if (!apdu_parser(&cmd, apdu, len)) {
+        return io_send_sw(SW_WRONG_APDU_DATA_LENGTH);
+    }
+    volatile int result = 0;
+    BEGIN_TRY {
+        TRY {
+            result = apdu_dispatcher(&cmd);
+        }
+        CATCH_ALL {
+            result = -1;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+    return result;
+}
+
+static size_t replay(const uint8_t *data, size_t size, const replay_options_t *options) {
+    size_t failed = 0;
+    size_t index = 0;
+    uint8_t apdu[TRACE_MAX_APDU_LEN];
+    trace_record_t record;
+    buffer_t trace;
+    buffer_init(&trace, data, size);
+    buffer_seek_cur(&trace, TRACE_MAGIC_LEN + 1);
+
+    memset(&G_ux, 0, sizeof(G_ux));
+    ux_stack_push();
+    for (int i = 0; i <= UINT8_MAX; i++) {
+        G_session_map[0][i] = G_session_map[1][i] = (uint8_t) i;
+    }
+    app_init();
+
+    while (buffer_can_read(&trace, 1)) {
+        if (!read_record(&trace, &record)) {
+            fprintf(stderr, "#%zu: malformed record\n", index);
+            return failed + 1;
+        }
+        memcpy(apdu, record.command, record.command_len);
+        rebind_command(apdu, record.command_len);
+
+        memset(&G_mock_response, 0, sizeof(G_mock_response));
+        if (options->verbose) {
+            printf("#%zu: INS=%02X P1=%02X P2=%02X Lc=%u\n",
+                   index,
+                   apdu[OFFSET_INS],
+                   apdu[OFFSET_P1],
+                   apdu[OFFSET_P2],
+                   record.command_len - OFFSET_CDATA);
+        }
+        if (dispatch(apdu, record.command_len) >= 0 && !G_mock_response.sent) {
+            auto_approve();
+        }
+        rebind_response(apdu, &record);
+
+        if (!check_response(index, apdu, &record, options)) {
+            failed++;
+        }
+        index++;
+    }
+    return failed;
+}
+
+static double elapsed_ms(const struct timespec *from, const struct timespec *to) {
+    return (to->tv_sec - from->tv_sec) * 1e3 + (to->tv_nsec - from->tv_nsec) / 1e6;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [-s] [-v] [-n repeat] trace...\n", name);
+    fprintf(stderr, "  -s  compare also response data of mocked cryptography (strict mode)\n");
+    fprintf(stderr, "  -v  print replayed APDUs and displayed texts\n");
+    fprintf(stderr, "  -n  replay every trace given number of times\n");
+}
+
+int main(int argc, char *argv[]) {
+    replay_options_t options = {.strict = false, .verbose = false, .repeat = 1};
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (strcmp(argv[arg], "-s") == 0) {
+            options.strict = true;
+        } else if (strcmp(argv[arg], "-v") == 0) {
+            options.verbose = true;
+        } else if (strcmp(argv[arg], "-n") == 0 && arg + 1 < argc) {
+            options.repeat = (uint32_t) strtoul(argv[++arg], NULL, 10);
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (arg == argc || options.repeat == 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    G_mock_display_silent = !options.verbose;
+
+    int status = EXIT_SUCCESS;
+    for (; arg < argc; arg++) {
+        size_t size;
+        uint8_t *data = read_file(argv[arg], &size);
+        if (data == NULL || size < TRACE_MAGIC_LEN + 1 ||
+            memcmp(data, TRACE_MAGIC, TRACE_MAGIC_LEN) != 0 ||
+            data[TRACE_MAGIC_LEN] != TRACE_VERSION) {
+            fprintf(stderr, "%s: not a trace file\n", argv[arg]);
+            free(data);
+            status = EXIT_FAILURE;
+            continue;
+        }
+
+        size_t failed = 0;
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint32_t i = 0; i < options.repeat; i++) {
+            failed += replay(data, size, &options);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        double total = elapsed_ms(&start, &end);
+        printf("%s: %s, %u run(s), %.3f ms total, %.3f ms per run\n",
+               argv[arg],
+               failed == 0 ? "OK" : "FAILED",
+               options.repeat,
+               total,
+               total / options.repeat);
+        if (failed != 0) status = EXIT_FAILURE;
+        free(data);
+    }
+    return status;
+}
@@ -8,10 +8,14 @@
 #include "sw.h"
 #include "commands/app_name.h"
 #include "commands/app_version.h"
+#include "commands/app_limits.h"
+#include "commands/app_capabilities.h"
 #include "commands/extpubkey/epk_handler.h"
 #include "commands/deriveaddress/da_handler.h"
 #include "commands/attestinput/ainpt_handler.h"
 #include "commands/signtx/stx_handler.h"
+#include "commands/app_stats.h"
+#include "commands/app_stack_profile.h"
 
 int apdu_dispatcher(const command_t *cmd) {
     if (cmd->cla != CLA) {
@@ -32,11 +36,24 @@ int apdu_dispatcher(const command_t *cmd) {
                 return io_send_sw(SW_WRONG_P1P2);
             }
             return handler_get_app_name();
+        case CMD_GET_APP_LIMITS:
+            if (cmd->p1 != 0 || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+            return handler_get_app_limits();
+        case CMD_GET_APP_CAPABILITIES:
+            if (cmd->p1 != 0 || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+            return handler_get_app_capabilities();
         case CMD_GET_EXTENDED_PUBLIC_KEY:
-            if (cmd->p1 == 0 || cmd->p1 > 2 || cmd->p2 > 0) {
+            if (cmd->p1 == 0 || cmd->p1 > 2 || cmd->p2 > 2) {
                 return io_send_sw(SW_WRONG_P1P2);
             }
-            return handler_get_extended_public_key(&buf, cmd->p1 == 2);
+            if (cmd->p2 == 0) {
+                return handler_get_extended_public_key(&buf, cmd->p1 == 2);
+            }
+            return handler_get_extended_public_keys_range(&buf, cmd->p1 == 2, cmd->p2 == 2);
         case CMD_DERIVE_ADDRESS:
             if (cmd->p1 == 0 || cmd->p1 > 2 || cmd->p2 == 0 || cmd->p2 > 2) {
                 return io_send_sw(SW_WRONG_P1P2);
@@ -52,6 +69,20 @@ int apdu_dispatcher(const command_t *cmd) {
                 return io_send_sw(SW_WRONG_P1P2);
             }
             return handler_sign_transaction(&buf, cmd->p1, cmd->p2);
+#ifdef HAVE_APP_STATS
+        case CMD_GET_APP_STATS:
+            if (cmd->lc != 0) {
+                return io_send_sw(SW_WRONG_APDU_DATA_LENGTH);
+            }
+            return handler_get_app_stats(cmd->p1, cmd->p2);
+#endif
+#ifdef HAVE_STACK_PROFILE
+        case CMD_GET_APP_STACK_PROFILE:
+            if (cmd->lc != 0) {
+                return io_send_sw(SW_WRONG_APDU_DATA_LENGTH);
+            }
+            return handler_get_app_stack_profile(cmd->p1, cmd->p2);
+#endif
         default:
             return io_send_sw(SW_INS_NOT_SUPPORTED);
     }
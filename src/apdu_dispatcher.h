@@ -9,10 +9,18 @@ typedef enum {
     CMD_NONE = 0x00,                     /// empty command
     CMD_GET_APP_VERSION = 0x01,          /// version of the application
     CMD_GET_APP_NAME = 0x02,             /// application name
+    CMD_GET_APP_LIMITS = 0x03,           /// limits of the device build
+    CMD_GET_APP_CAPABILITIES = 0x04,     /// versioned capabilities record
     CMD_GET_EXTENDED_PUBLIC_KEY = 0x10,  /// extended public key of corresponding BIP32 path
     CMD_DERIVE_ADDRESS = 0x11,           /// derive address for corresponding BIP32 path
     CMD_ATTEST_INPUT_BOX = 0x20,         /// attest input box command
-    CMD_SIGN_TRANSACTION = 0x21          /// sign transaction with BIP32 path
+    CMD_SIGN_TRANSACTION = 0x21,         /// sign transaction with BIP32 path
+#ifdef HAVE_APP_STATS
+    CMD_GET_APP_STATS = 0xF0,  /// per-APDU counters (debug builds only)
+#endif
+#ifdef HAVE_STACK_PROFILE
+    CMD_GET_APP_STACK_PROFILE = 0xF1,  /// per-APDU stack high-water marks (debug builds only)
+#endif
 } command_e;
 
 /**
@@ -29,6 +29,8 @@
 #include "apdu_dispatcher.h"
 #include "ui/ui_menu.h"
 #include "common/macros_ext.h"
+#include "helpers/stats.h"
+#include "helpers/stack_profile.h"
 
 /**
  * Handle APDU command received and send back APDU response using handlers.
@@ -42,17 +44,24 @@ void app_main() {
     // Initialize the NVM data if required
     if (N_storage.initialized != 0x01) {
         internal_storage_t storage;
+        memset(&storage, 0, sizeof(internal_storage_t));
         storage.blind_signing_enabled = 0x00;
         storage.initialized = 0x01;
         nvm_write((void *) &N_storage, &storage, sizeof(internal_storage_t));
     }
 
+    // Paint the stack for high-water mark profiling
+    STACK_PROFILE_INIT();
+
     // Initialize I/O
     io_init();
 
     // Initialize Global App Context
     app_init();
 
+    // Prepare nonce of the first signature before any command is received
+    app_prepare_schnorr_nonce();
+
     // Show main menu
     ui_menu_main();
 
@@ -80,7 +89,12 @@ void app_main() {
                cmd.data);
 
         // Dispatch structured APDU command to handler
-        if (apdu_dispatcher(&cmd) < 0) {
+        STACK_PROFILE_BEGIN(cmd.ins, cmd.p1);
+        APP_STATS_BEGIN(cmd.ins, cmd.p1, cmd.lc);
+        int result = apdu_dispatcher(&cmd);
+        APP_STATS_END();
+        STACK_PROFILE_END();
+        if (result < 0) {
             PRINTF("=> apdu_dispatcher failure\n");
             return;
         }
@@ -0,0 +1,47 @@
+#include <stdint.h>  // uint*_t
+
+#include "app_capabilities.h"
+#include "app_limits.h"
+#include "../sw.h"
+#include "../constants.h"
+#include "../helpers/response.h"
+#include "../common/rwbuffer.h"
+
+// features(4) + build flags(1) + own addresses window(1) + limits
+#define APP_CAPABILITIES_DATA_LEN (4 + 1 + 1 + APP_LIMITS_LEN)
+// version(1) + data length(1) + data
+#define APP_CAPABILITIES_LEN (2 + APP_CAPABILITIES_DATA_LEN)
+
+static const uint32_t C_APP_FEATURES =
+    APP_FEATURE_SESSION_RESUME | APP_FEATURE_WIDE_TOKENS_COUNT | APP_FEATURE_INLINE_INPUT_BOXES |
+    APP_FEATURE_CHANGE_PATHS | APP_FEATURE_EXT_PUB_KEYS_RANGE | APP_FEATURE_OWN_ADDRESSES |
+    APP_FEATURE_TRUSTED_APPS;
+
+static uint8_t build_flags(void) {
+    uint8_t flags = 0;
+#ifdef DEBUG_BUILD
+    flags |= APP_BUILD_FLAG_DEBUG;
+#endif
+#ifdef HAVE_APP_STATS
+    flags |= APP_BUILD_FLAG_STATS;
+#endif
+#ifdef HAVE_APP_BLAKE2B
+    flags |= APP_BUILD_FLAG_BLAKE2B;
+#endif
+#ifdef HAVE_STACK_PROFILE
+    flags |= APP_BUILD_FLAG_STACK_PROFILE;
+#endif
+    return flags;
+}
+
+int handler_get_app_capabilities() {
+    RW_BUFFER_NEW_LOCAL_EMPTY(buf, APP_CAPABILITIES_LEN);
+    if (!rw_buffer_write_u8(&buf, APP_CAPABILITIES_VERSION) ||
+        !rw_buffer_write_u8(&buf, APP_CAPABILITIES_DATA_LEN) ||
+        !rw_buffer_write_u32(&buf, C_APP_FEATURES, BE) ||
+        !rw_buffer_write_u8(&buf, build_flags()) ||
+        !rw_buffer_write_u8(&buf, OWN_ADDRESSES_WINDOW) || !app_limits_write(&buf)) {
+        return res_error(SW_BUFFER_ERROR);
+    }
+    return res_ok_data(&buf);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * Version of the capabilities record.
+ */
+#define APP_CAPABILITIES_VERSION 1
+
+/**
+ * Protocol features supported by the application.
+ */
+typedef enum {
+    APP_FEATURE_SESSION_RESUME = 0x0001,      /// sign transaction resume, P1 0x0F
+    APP_FEATURE_WIDE_TOKENS_COUNT = 0x0002,   /// 16-bit distinct tokens count in Start Transaction
+    APP_FEATURE_INLINE_INPUT_BOXES = 0x0004,  /// inline input boxes, P1 0x1B-0x1E
+    APP_FEATURE_CHANGE_PATHS = 0x0008,        /// registered change paths, P1 0x1F
+    APP_FEATURE_EXT_PUB_KEYS_RANGE = 0x0010,  /// extended public keys range, INS 0x10 P2 0x01-0x02
+    APP_FEATURE_OWN_ADDRESSES = 0x0020,       /// outputs to own addresses are approved silently
+    APP_FEATURE_TRUSTED_APPS = 0x0040         /// application tokens remembered in NVM
+} app_feature_e;
+
+/**
+ * Build flags of the application.
+ */
+typedef enum {
+    APP_BUILD_FLAG_DEBUG = 0x01,         /// debug build
+    APP_BUILD_FLAG_STATS = 0x02,         /// APDU statistics, INS 0xF0
+    APP_BUILD_FLAG_BLAKE2B = 0x04,       /// in-app BLAKE2b engine
+    APP_BUILD_FLAG_STACK_PROFILE = 0x08  /// stack high-water marks, INS 0xF1
+} app_build_flag_e;
+
+/**
+ * Handler for CMD_GET_APP_CAPABILITIES command. Send APDU response with the versioned
+ * capabilities record: supported protocol features, build flags and limits.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_app_capabilities(void);
@@ -0,0 +1,29 @@
+#include <stdint.h>  // uint*_t
+
+#include "app_limits.h"
+#include "../sw.h"
+#include "../constants.h"
+#include "../helpers/response.h"
+#include "../helpers/input_frame.h"
+
+bool app_limits_write(rw_buffer_t *buf) {
+    _Static_assert(REVIEW_MAX_TOKENS <= UINT16_MAX, "REVIEW_MAX_TOKENS must fit 2 bytes!");
+
+    return rw_buffer_write_u16(buf, TOKEN_MAX_COUNT, BE) &&
+           rw_buffer_write_u8(buf, FRAME_MAX_TOKENS_COUNT) &&
+           rw_buffer_write_u32(buf, MAX_TX_DATA_PART_LEN, BE) &&
+           rw_buffer_write_u8(buf, MAX_DATA_CHUNK_LEN) &&
+           rw_buffer_write_u8(buf, REVIEW_MAX_OUTPUTS) &&
+           rw_buffer_write_u16(buf, REVIEW_MAX_TOKENS, BE) &&
+           rw_buffer_write_u8(buf, CHANGE_PATHS_MAX_COUNT) &&
+           rw_buffer_write_u8(buf, EXT_PUB_KEY_RANGE_MAX_COUNT) &&
+           rw_buffer_write_u8(buf, MAX_NUMBER_OF_SCREENS);
+}
+
+int handler_get_app_limits() {
+    RW_BUFFER_NEW_LOCAL_EMPTY(buf, APP_LIMITS_LEN);
+    if (!app_limits_write(&buf)) {
+        return res_error(SW_BUFFER_ERROR);
+    }
+    return res_ok_data(&buf);
+}
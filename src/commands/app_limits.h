@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+
+#include "../common/rwbuffer.h"
+
+/**
+ * Length of the limits record.
+ * tokens(2) + frame tokens(1) + data part(4) + chunk(1) + review outputs(1) + review tokens(2)
+ * + change paths(1) + public keys range(1) + screens(1)
+ */
+#define APP_LIMITS_LEN 14
+
+/**
+ * Write limits record of the build. Shared with the capabilities record.
+ *
+ * @param[out] buf
+ *   Output buffer.
+ *
+ * @return true if written, false if the buffer is too small.
+ *
+ */
+bool app_limits_write(rw_buffer_t *buf);
+
+/**
+ * Handler for CMD_GET_APP_LIMITS command. Send APDU response with the limits
+ * the application was built with for the device model.
+ *
+ * @see Device limits section in Makefile.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_app_limits(void);
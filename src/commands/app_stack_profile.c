@@ -0,0 +1,59 @@
+#ifdef HAVE_STACK_PROFILE
+
+#include <stdint.h>  // uint*_t
+
+#include "app_stack_profile.h"
+#include "../sw.h"
+#include "../constants.h"
+#include "../helpers/stack_profile.h"
+#include "../helpers/response.h"
+#include "../common/rwbuffer.h"
+#include "../common/macros_ext.h"
+
+// ins(1) + p1(1) + max depth(2)
+#define APP_STACK_PROFILE_ENTRY_SIZE 4
+// stack size(2) + idle max depth(2) + entries count(1)
+#define APP_STACK_PROFILE_HEADER_SIZE 5
+#define APP_STACK_PROFILE_ENTRIES_PER_APDU \
+    ((MAX_DATA_CHUNK_LEN - APP_STACK_PROFILE_HEADER_SIZE) / APP_STACK_PROFILE_ENTRY_SIZE)
+
+static inline bool write_entry(rw_buffer_t *buf, const stack_profile_entry_t *entry) {
+    return rw_buffer_write_u8(buf, entry->ins) && rw_buffer_write_u8(buf, entry->p1) &&
+           rw_buffer_write_u16(buf, entry->max_depth, BE);
+}
+
+int handler_get_app_stack_profile(app_stack_profile_subcommand_e subcommand, uint8_t index) {
+    switch (subcommand) {
+        case APP_STACK_PROFILE_SUBCOMMAND_GET: {
+            if (index > G_stack_profile.count) {
+                return res_error(SW_WRONG_P1P2);
+            }
+            RW_BUFFER_NEW_LOCAL_EMPTY(
+                buf,
+                APP_STACK_PROFILE_HEADER_SIZE +
+                    APP_STACK_PROFILE_ENTRIES_PER_APDU * APP_STACK_PROFILE_ENTRY_SIZE);
+            if (!rw_buffer_write_u16(&buf, stack_profile_size(), BE) ||
+                !rw_buffer_write_u16(&buf, G_stack_profile.idle_max_depth, BE) ||
+                !rw_buffer_write_u8(&buf, G_stack_profile.count)) {
+                return res_error(SW_BUFFER_ERROR);
+            }
+            uint8_t end = MIN(G_stack_profile.count, index + APP_STACK_PROFILE_ENTRIES_PER_APDU);
+            for (uint8_t i = index; i < end; i++) {
+                if (!write_entry(&buf, &G_stack_profile.entries[i])) {
+                    return res_error(SW_BUFFER_ERROR);
+                }
+            }
+            return res_ok_data(&buf);
+        }
+        case APP_STACK_PROFILE_SUBCOMMAND_RESET:
+            if (index != 0) {
+                return res_error(SW_WRONG_P1P2);
+            }
+            stack_profile_reset();
+            return res_ok();
+        default:
+            return res_error(SW_WRONG_P1P2);
+    }
+}
+
+#endif
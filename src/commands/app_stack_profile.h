@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef HAVE_STACK_PROFILE
+
+/**
+ * Subcommands of CMD_GET_APP_STACK_PROFILE.
+ */
+typedef enum {
+    APP_STACK_PROFILE_SUBCOMMAND_GET = 0x01,   /// read entries starting from index in P2
+    APP_STACK_PROFILE_SUBCOMMAND_RESET = 0x02  /// clear all entries
+} app_stack_profile_subcommand_e;
+
+/**
+ * Handler for CMD_GET_APP_STACK_PROFILE command. Debug only, available with STACK_PROFILE=1
+ * build.
+ *
+ * @param[in] subcommand
+ *   Subcommand identifier.
+ * @param[in] index
+ *   Index of the first entry to send.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_app_stack_profile(app_stack_profile_subcommand_e subcommand, uint8_t index);
+
+#endif
@@ -0,0 +1,56 @@
+#ifdef HAVE_APP_STATS
+
+#include <stdint.h>  // uint*_t
+
+#include "app_stats.h"
+#include "../sw.h"
+#include "../constants.h"
+#include "../helpers/stats.h"
+#include "../helpers/response.h"
+#include "../common/rwbuffer.h"
+#include "../common/macros_ext.h"
+
+// ins(1) + p1(1) + 5 counters (4 each)
+#define APP_STATS_ENTRY_SIZE 22
+// entries count(1) + entries
+#define APP_STATS_ENTRIES_PER_APDU ((MAX_DATA_CHUNK_LEN - 1) / APP_STATS_ENTRY_SIZE)
+
+static inline bool write_entry(rw_buffer_t *buf, const app_stats_entry_t *entry) {
+    return rw_buffer_write_u8(buf, entry->ins) && rw_buffer_write_u8(buf, entry->p1) &&
+           rw_buffer_write_u32(buf, entry->calls, BE) &&
+           rw_buffer_write_u32(buf, entry->bytes_in, BE) &&
+           rw_buffer_write_u32(buf, entry->blake2b_updates, BE) &&
+           rw_buffer_write_u32(buf, entry->hmac_calls, BE) &&
+           rw_buffer_write_u32(buf, entry->derivations, BE);
+}
+
+int handler_get_app_stats(app_stats_subcommand_e subcommand, uint8_t index) {
+    switch (subcommand) {
+        case APP_STATS_SUBCOMMAND_GET: {
+            if (index > G_app_stats.count) {
+                return res_error(SW_WRONG_P1P2);
+            }
+            RW_BUFFER_NEW_LOCAL_EMPTY(buf, 1 + APP_STATS_ENTRIES_PER_APDU * APP_STATS_ENTRY_SIZE);
+            if (!rw_buffer_write_u8(&buf, G_app_stats.count)) {
+                return res_error(SW_BUFFER_ERROR);
+            }
+            uint8_t end = MIN(G_app_stats.count, index + APP_STATS_ENTRIES_PER_APDU);
+            for (uint8_t i = index; i < end; i++) {
+                if (!write_entry(&buf, &G_app_stats.entries[i])) {
+                    return res_error(SW_BUFFER_ERROR);
+                }
+            }
+            return res_ok_data(&buf);
+        }
+        case APP_STATS_SUBCOMMAND_RESET:
+            if (index != 0) {
+                return res_error(SW_WRONG_P1P2);
+            }
+            app_stats_reset();
+            return res_ok();
+        default:
+            return res_error(SW_WRONG_P1P2);
+    }
+}
+
+#endif
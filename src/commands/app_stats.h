@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef HAVE_APP_STATS
+
+/**
+ * Subcommands of CMD_GET_APP_STATS.
+ */
+typedef enum {
+    APP_STATS_SUBCOMMAND_GET = 0x01,   /// read entries starting from index in P2
+    APP_STATS_SUBCOMMAND_RESET = 0x02  /// clear all counters
+} app_stats_subcommand_e;
+
+/**
+ * Handler for CMD_GET_APP_STATS command. Debug only, available with APP_STATS=1 build.
+ *
+ * @param[in] subcommand
+ *   Subcommand identifier.
+ * @param[in] index
+ *   Index of the first entry to send.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_app_stats(app_stats_subcommand_e subcommand, uint8_t index);
+
+#endif
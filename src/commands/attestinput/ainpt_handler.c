@@ -58,7 +58,7 @@ static NOINLINE ergo_tx_serializer_box_result_e box_token_cb(ergo_tx_serializer_
     if (ctx->tokens_table.count >= TOKEN_MAX_COUNT) {
         return ERGO_TX_SERIALIZER_BOX_RES_ERR_TOO_MANY_TOKENS;
     }
-    for (uint8_t i = 0; i < ctx->tokens_table.count; i++) {
+    for (uint16_t i = 0; i < ctx->tokens_table.count; i++) {
         if (memcmp(id, ctx->tokens_table.tokens[i], ERGO_ID_LEN) == 0) {
             return ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_ID;
         }
@@ -70,8 +70,7 @@ static NOINLINE ergo_tx_serializer_box_result_e box_token_cb(ergo_tx_serializer_
 
 static inline int handle_init(attest_input_ctx_t *ctx,
                               buffer_t *cdata,
-                              bool has_token,
-                              uint32_t app_session_id) {
+                              bool has_token) {
     uint64_t value;
     uint32_t ergo_tree_size, creation_height, registers_size, app_session_id_in = 0;
     uint8_t tokens_count;
@@ -108,7 +107,7 @@ static inline int handle_init(attest_input_ctx_t *ctx,
     ctx->state = ATTEST_INPUT_STATE_INITIALIZED;
     ctx->session = session_id_new_random(ctx->session);
 
-    if (is_known_application(app_session_id, app_session_id_in)) {
+    if (app_is_known_application(app_session_id_in)) {
         ctx->state = ATTEST_INPUT_STATE_APPROVED;
         return send_response_attested_input_session_id(ctx->session);
     }
@@ -158,7 +157,7 @@ int handler_attest_input(buffer_t *cdata,
                 return handler_err(ctx, SW_WRONG_P1P2);
             }
             app_set_current_command(CMD_ATTEST_INPUT_BOX);
-            return handle_init(ctx, cdata, session_or_token == 0x02, app_connected_app_id());
+            return handle_init(ctx, cdata, session_or_token == 0x02);
         case ATTEST_INPUT_SUBCOMMAND_TREE_CHUNK:
             CHECK_COMMAND(ctx, CMD_ATTEST_INPUT_BOX);
             CHECK_SESSION(ctx, session_or_token);
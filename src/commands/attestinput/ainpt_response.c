@@ -4,11 +4,12 @@
 #include "ainpt_context.h"
 #include "../../helpers/response.h"
 #include "../../helpers/input_frame.h"
+#include "../../helpers/stats.h"
 
 #define WRITE_ERROR_HANDLER send_error
 #include "../../helpers/cmd_macros.h"
 
-static inline uint8_t get_frames_count(uint8_t tokens_count) {
+static inline uint8_t get_frames_count(uint16_t tokens_count) {
     uint8_t frames_count = (tokens_count + (FRAME_MAX_TOKENS_COUNT - 1)) / FRAME_MAX_TOKENS_COUNT;
     return frames_count == 0 ? 1 : frames_count;
 }
@@ -49,6 +50,7 @@ int send_response_attested_input_frame(attest_input_ctx_t *ctx,
     }
 
     CHECK_WRITE_PARAM(rw_buffer_can_write(&output, CX_SHA256_SIZE));
+    APP_STATS_INC(hmac_calls);
     cx_hmac_sha256(session_key,
                    SESSION_KEY_LEN,
                    rw_buffer_read_ptr(&output),
@@ -60,7 +62,7 @@ int send_response_attested_input_frame(attest_input_ctx_t *ctx,
     return res_ok_data(&output);
 }
 
-int send_response_attested_input_frame_count(uint8_t tokens_count) {
+int send_response_attested_input_frame_count(uint16_t tokens_count) {
     uint8_t frames_count = get_frames_count(tokens_count);
     RW_BUFFER_FROM_VAR_FULL(buf, frames_count);
     return res_ok_data(&buf);
@@ -24,7 +24,7 @@ int send_response_attested_input_frame(attest_input_ctx_t *ctx,
  * @return zero or positive integer if success, -1 otherwise.
  *
  */
-int send_response_attested_input_frame_count(uint8_t tokens_count);
+int send_response_attested_input_frame_count(uint16_t tokens_count);
 
 /**
  * Send APDU response with session_id
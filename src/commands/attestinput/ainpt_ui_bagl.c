@@ -23,6 +23,7 @@ static NOINLINE void ui_action_attest_input(bool approved, void* context) {
 
     if (approved) {
         app_set_connected_app_id(ctx->ui.app_token_value);
+        app_trust_connected_app();
         ctx->state = ATTEST_INPUT_STATE_APPROVED;
         send_response_attested_input_session_id(ctx->session);
     } else {
@@ -41,6 +41,7 @@ int ui_display_access_token(uint32_t app_access_token, attest_input_ctx_t* conte
 
     if (approved) {
         app_set_connected_app_id(context->ui.app_token_value);
+        app_trust_connected_app();
         context->state = ATTEST_INPUT_STATE_APPROVED;
         send_response_attested_input_session_id(context->session);
 
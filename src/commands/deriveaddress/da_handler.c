@@ -15,7 +15,6 @@
 #include "../../common/rwbuffer.h"
 #include "../../common/macros_ext.h"
 #include "../../helpers/response.h"
-#include "../../helpers/session_id.h"
 #include "../../ergo/address.h"
 
 #define COMMAND_ERROR_HANDLER handler_err
@@ -66,7 +65,7 @@ int handler_derive_address(buffer_t *cdata, bool display, bool has_access_token)
         return res_error(SW_ADDRESS_GENERATION_FAILED);
     }
 
-    if (!display && is_known_application(access_token, app_connected_app_id())) {
+    if (!display && app_is_known_application(access_token)) {
         return send_response_address(ctx->raw_address);
     }
 
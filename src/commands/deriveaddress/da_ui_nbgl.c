@@ -2,7 +2,6 @@
 
 #include <os.h>
 #include <glyphs.h>
-#include <base58.h>
 #include <nbgl_use_case.h>
 
 #include "da_ui.h"
@@ -11,6 +10,7 @@
 #include "../../sw.h"
 #include "../../context.h"
 #include "../../common/macros_ext.h"
+#include "../../common/base58_fast.h"
 #include "../../ergo/address.h"
 #include "../../helpers/response.h"
 #include "../../ui/ui_bip32_path.h"
@@ -52,10 +52,10 @@ int ui_display_address(derive_address_ctx_t* ctx,
 
     memset(ctx->address, 0, MEMBER_SIZE(derive_address_ctx_t, address));
     if (!send) {
-        int result = base58_encode(raw_address,
-                                   P2PK_ADDRESS_LEN,
-                                   ctx->address,
-                                   MEMBER_SIZE(derive_address_ctx_t, address));
+        int result = base58_fast_encode(raw_address,
+                                        P2PK_ADDRESS_LEN,
+                                        ctx->address,
+                                        MEMBER_SIZE(derive_address_ctx_t, address));
 
         if (result == -1 || result >= P2PK_ADDRESS_STRING_MAX_LEN) {
             return send_error(SW_ADDRESS_FORMATTING_FAILED);
@@ -115,6 +115,7 @@ int ui_display_address(derive_address_ctx_t* ctx,
 
     if (approved) {
         app_set_connected_app_id(ctx->app_token_value);
+        app_trust_connected_app();
         if (ctx->send) {
             send_response_address(ctx->raw_address);
         } else {
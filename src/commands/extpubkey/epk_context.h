@@ -1,13 +1,30 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "../../constants.h"
 #include "../../ui/ui_application_id.h"
 
+/**
+ * Length of the account path: 44'/429'/account'.
+ */
+#define EXT_PUB_KEY_RANGE_PATH_LEN 3
+
+/**
+ * Account range export state.
+ */
+typedef struct {
+    uint32_t path[EXT_PUB_KEY_RANGE_PATH_LEN];  // path of the next account to send
+    uint8_t remaining;                          // accounts left, 0 for the single key export
+    uint8_t count;                              // accounts in the range
+    bool approved;                              // range is approved by the user
+} extended_public_key_range_t;
+
 typedef struct {
     uint32_t app_token_value;
     uint8_t chain_code[CHAIN_CODE_LEN];
     uint8_t raw_public_key[PUBLIC_KEY_LEN];
     char bip32_path[MAX_BIP32_STRING_LEN];   // Bip32 path string
     char app_token[APPLICATION_ID_STR_LEN];  // hexified app token
+    extended_public_key_range_t range;
 } extended_public_key_ctx_t;
\ No newline at end of file
@@ -15,7 +15,6 @@
 #include "../../helpers/crypto.h"
 #include "../../helpers/response.h"
 #include "../../common/macros_ext.h"
-#include "../../helpers/session_id.h"
 
 #define COMMAND_ERROR_HANDLER handler_err
 #include "../../helpers/cmd_macros.h"
@@ -60,7 +59,7 @@ int handler_get_extended_public_key(buffer_t *cdata, bool has_access_token) {
         return handler_err(ctx, SW_INTERNAL_CRYPTO_ERROR);
     }
 
-    if (is_known_application(access_token, app_connected_app_id())) {
+    if (app_is_known_application(access_token)) {
         return send_response_extended_pubkey(ctx->raw_public_key, ctx->chain_code);
     }
 
@@ -70,4 +69,75 @@ int handler_get_extended_public_key(buffer_t *cdata, bool has_access_token) {
                               bip32_path_len,
                               ctx->raw_public_key,
                               ctx->chain_code);
-}
\ No newline at end of file
+}
+
+static inline int handle_range_init(extended_public_key_ctx_t *ctx,
+                                    buffer_t *cdata,
+                                    bool has_access_token) {
+    uint8_t bip32_path_len;
+    uint32_t bip32_path[MAX_BIP32_PATH];
+    uint8_t count;
+    uint32_t access_token = 0;
+
+    CHECK_READ_PARAM(ctx, buffer_read_u8(cdata, &bip32_path_len));
+    CHECK_READ_PARAM(ctx, buffer_read_bip32_path(cdata, bip32_path, (size_t) bip32_path_len));
+    CHECK_READ_PARAM(ctx, buffer_read_u8(cdata, &count));
+    if (has_access_token) {
+        CHECK_READ_PARAM(ctx, buffer_read_u32(cdata, &access_token, BE));
+    }
+    CHECK_PARAMS_FINISHED(ctx, cdata);
+
+    if (!bip32_path_validate(bip32_path,
+                             bip32_path_len,
+                             BIP32_HARDENED(44),
+                             BIP32_HARDENED(BIP32_ERGO_COIN),
+                             BIP32_PATH_VALIDATE_ACCOUNT_E3)) {
+        return handler_err(ctx, SW_BIP32_BAD_PATH);
+    }
+    // Last account of the range should be a valid index
+    if (count == 0 || count > EXT_PUB_KEY_RANGE_MAX_COUNT ||
+        UINT32_MAX - bip32_path[EXT_PUB_KEY_RANGE_PATH_LEN - 1] < (uint32_t) count - 1) {
+        return handler_err(ctx, SW_WRONG_APDU_DATA_LENGTH);
+    }
+
+    memmove(ctx->range.path, bip32_path, sizeof(ctx->range.path));
+    ctx->range.count = count;
+    ctx->range.remaining = count;
+
+    if (app_is_known_application(access_token)) {
+        ctx->range.approved = true;
+        return send_response_extended_pubkeys_chunk(ctx);
+    }
+
+    // Keys are derived after approval, chunk by chunk
+    return ui_display_account(ctx,
+                              access_token,
+                              bip32_path,
+                              bip32_path_len,
+                              ctx->raw_public_key,
+                              ctx->chain_code);
+}
+
+static inline int handle_range_next(extended_public_key_ctx_t *ctx, buffer_t *cdata) {
+    CHECK_COMMAND(ctx, CMD_GET_EXTENDED_PUBLIC_KEY);
+    CHECK_PARAMS_FINISHED(ctx, cdata);
+    if (!ctx->range.approved || ctx->range.remaining == 0) {
+        return handler_err(ctx, SW_BAD_STATE);
+    }
+    return send_response_extended_pubkeys_chunk(ctx);
+}
+
+int handler_get_extended_public_keys_range(buffer_t *cdata, bool has_access_token, bool is_next) {
+    if (app_is_ui_busy()) {
+        return res_ui_busy();
+    }
+
+    extended_public_key_ctx_t *ctx = app_extended_public_key_context();
+
+    if (is_next) {
+        return handle_range_next(ctx, cdata);
+    }
+
+    app_set_current_command(CMD_GET_EXTENDED_PUBLIC_KEY);
+    return handle_range_init(ctx, cdata, has_access_token);
+}
@@ -18,4 +18,22 @@
  * @return zero or positive integer if success, negative integer otherwise.
  *
  */
-int handler_get_extended_public_key(buffer_t *cdata, bool has_access_token);
\ No newline at end of file
+int handler_get_extended_public_key(buffer_t *cdata, bool has_access_token);
+
+/**
+ * Handler for CMD_GET_EXTENDED_PUBLIC_KEY account range export. The first call parses
+ * the account path and count and asks the user approval once for the whole range.
+ * Following calls return next chunks of public keys/chain codes.
+ *
+ * @param[in,out] cdata
+ *   Command data with account BIP32 path, accounts count and optional access token.
+ *   Empty for the next chunk.
+ * @param[in]     has_access_token
+ *   Whether data has access token or not
+ * @param[in]     is_next
+ *   Whether it's a request of the next chunk
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_extended_public_keys_range(buffer_t *cdata, bool has_access_token, bool is_next);
@@ -7,6 +7,7 @@
 #include "../../constants.h"
 #include "../../context.h"
 #include "../../common/rwbuffer.h"
+#include "../../helpers/crypto.h"
 #include "../../helpers/response.h"
 
 #define WRITE_ERROR_HANDLER send_error
@@ -17,16 +18,57 @@ static inline int send_error(uint16_t error) {
     return res_error(error);
 }
 
+// Ends the range: wipes the keys and the range state and releases the command
+static inline void range_finish(extended_public_key_ctx_t *ctx) {
+    explicit_bzero(ctx, sizeof(extended_public_key_ctx_t));
+    app_set_current_command(CMD_NONE);
+}
+
+static inline bool write_extended_pubkey(rw_buffer_t *response,
+                                         const uint8_t raw_public_key[static PUBLIC_KEY_LEN],
+                                         const uint8_t chain_code[static CHAIN_CODE_LEN]) {
+    // Compressed pubkey
+    return rw_buffer_write_u8(response, ((raw_public_key[64] & 1) ? 0x03 : 0x02)) &&
+           rw_buffer_write_bytes(response, raw_public_key + 1, 32) &&
+           rw_buffer_write_bytes(response, chain_code, CHAIN_CODE_LEN);
+}
+
 int send_response_extended_pubkey(uint8_t raw_public_key[static PUBLIC_KEY_LEN],
                                   uint8_t chain_code[static CHAIN_CODE_LEN]) {
     RW_BUFFER_NEW_LOCAL_EMPTY(response, EXTENDED_PUBLIC_KEY_LEN);
 
-    // Compressed pubkey
-    CHECK_WRITE_PARAM(rw_buffer_write_u8(&response, ((raw_public_key[64] & 1) ? 0x03 : 0x02)));
-    CHECK_WRITE_PARAM(rw_buffer_write_bytes(&response, raw_public_key + 1, 32));
-    CHECK_WRITE_PARAM(rw_buffer_write_bytes(&response, chain_code, CHAIN_CODE_LEN));
+    CHECK_WRITE_PARAM(write_extended_pubkey(&response, raw_public_key, chain_code));
 
     app_set_current_command(CMD_NONE);
 
     return res_ok_data(&response);
-}
\ No newline at end of file
+}
+
+int send_response_extended_pubkeys_chunk(extended_public_key_ctx_t *ctx) {
+    RW_BUFFER_NEW_LOCAL_EMPTY(response, EXT_PUB_KEY_CHUNK_COUNT * EXTENDED_PUBLIC_KEY_LEN);
+
+    uint8_t count = ctx->range.remaining < EXT_PUB_KEY_CHUNK_COUNT ? ctx->range.remaining
+                                                                   : EXT_PUB_KEY_CHUNK_COUNT;
+    for (uint8_t i = 0; i < count; i++) {
+        if (crypto_generate_public_key(ctx->range.path,
+                                       EXT_PUB_KEY_RANGE_PATH_LEN,
+                                       ctx->raw_public_key,
+                                       ctx->chain_code) != 0) {
+            range_finish(ctx);
+            return res_error(SW_INTERNAL_CRYPTO_ERROR);
+        }
+        if (!write_extended_pubkey(&response, ctx->raw_public_key, ctx->chain_code)) {
+            range_finish(ctx);
+            return res_error(SW_BUFFER_ERROR);
+        }
+        ctx->range.path[EXT_PUB_KEY_RANGE_PATH_LEN - 1]++;
+    }
+    ctx->range.remaining -= count;
+
+    // Range is finished, clear the context
+    if (ctx->range.remaining == 0) {
+        range_finish(ctx);
+    }
+
+    return res_ok_data(&response);
+}
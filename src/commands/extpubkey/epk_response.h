@@ -1,8 +1,14 @@
 #pragma once
 
 #include <stdint.h>
+#include "epk_context.h"
 #include "../../constants.h"
 
+/**
+ * Number of extended public keys in a single range export response.
+ */
+#define EXT_PUB_KEY_CHUNK_COUNT (MAX_DATA_CHUNK_LEN / EXTENDED_PUBLIC_KEY_LEN)
+
 /**
  * Send APDU response with public key and chain code.
  *
@@ -13,4 +19,15 @@
  *
  */
 int send_response_extended_pubkey(uint8_t raw_public_key[static PUBLIC_KEY_LEN],
-                                  uint8_t chain_code[static CHAIN_CODE_LEN]);
\ No newline at end of file
+                                  uint8_t chain_code[static CHAIN_CODE_LEN]);
+
+/**
+ * Derive and send the next chunk of the approved account range.
+ * Command is finished after the last chunk.
+ *
+ * response = (compressed public key (33) || chain code (32)) * chunk keys count
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int send_response_extended_pubkeys_chunk(extended_public_key_ctx_t *ctx);
@@ -2,8 +2,28 @@
 
 #include <stdint.h>   // uint*
 #include <stdbool.h>  // bool
+#include <stdio.h>    // snprintf
+#include <string.h>   // strlen
 #include "epk_context.h"
 #include "../../constants.h"
+#include "../../common/bip32_ext.h"
+
+/**
+ * Append the last account of the range to the formatted account path: m/44'/429'/0'-19'.
+ * Does nothing for the single key export.
+ */
+static inline bool ui_epk_format_range(const extended_public_key_ctx_t* ctx,
+                                       char* buffer,
+                                       size_t buffer_len) {
+    if (ctx->range.count <= 1) return true;
+    uint32_t first = ctx->range.path[EXT_PUB_KEY_RANGE_PATH_LEN - 1] - BIP32_HARDENED_CONSTANT;
+    size_t len = strlen(buffer);
+    int written = snprintf(buffer + len,
+                           buffer_len - len,
+                           "-%u'",
+                           (unsigned int) (first + ctx->range.count - 1));
+    return written > 0 && (size_t) written < buffer_len - len;
+}
 
 /**
  * Display account on the device and ask confirmation to export.
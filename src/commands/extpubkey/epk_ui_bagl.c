@@ -20,6 +20,9 @@
 
 // Step with icon and text
 UX_STEP_NOCB(ux_epk_display_confirm_ext_pubkey_step, pn, {&C_icon_warning, "Ext PubKey Export"});
+UX_STEP_NOCB(ux_epk_display_confirm_ext_pubkeys_step,
+             pn,
+             {&C_icon_warning, "Ext PubKeys Export"});
 
 static NOINLINE void ui_action_get_extended_pubkey(bool approved, void* context) {
     extended_public_key_ctx_t* ctx = (extended_public_key_ctx_t*) context;
@@ -27,15 +30,21 @@ static NOINLINE void ui_action_get_extended_pubkey(bool approved, void* context)
 
     if (approved) {
         app_set_connected_app_id(ctx->app_token_value);
-        send_response_extended_pubkey(ctx->raw_public_key, ctx->chain_code);
-        explicit_bzero(ctx, sizeof(extended_public_key_ctx_t));
+        app_trust_connected_app();
+        if (ctx->range.count > 0) {
+            // Command stays active until the last chunk of the range is sent
+            ctx->range.approved = true;
+            send_response_extended_pubkeys_chunk(ctx);
+        } else {
+            send_response_extended_pubkey(ctx->raw_public_key, ctx->chain_code);
+            explicit_bzero(ctx, sizeof(extended_public_key_ctx_t));
+        }
     } else {
         explicit_bzero(ctx, sizeof(extended_public_key_ctx_t));
         res_deny();
+        app_set_current_command(CMD_NONE);
     }
 
-    app_set_current_command(CMD_NONE);
-
     ui_menu_main();
 }
 
@@ -54,7 +63,11 @@ int ui_display_account(extended_public_key_ctx_t* ctx,
     }
 
     uint8_t screen = 0;
-    ui_add_screen(&ux_epk_display_confirm_ext_pubkey_step, &screen);
+    if (ctx->range.count > 1) {
+        ui_add_screen(&ux_epk_display_confirm_ext_pubkeys_step, &screen);
+    } else {
+        ui_add_screen(&ux_epk_display_confirm_ext_pubkey_step, &screen);
+    }
 
     const ux_flow_step_t* b32_step =
         ui_bip32_path_screen(bip32_path,
@@ -64,7 +77,10 @@ int ui_display_account(extended_public_key_ctx_t* ctx,
                              MEMBER_SIZE(extended_public_key_ctx_t, bip32_path),
                              NULL,
                              NULL);
-    if (b32_step == NULL) {
+    if (b32_step == NULL ||
+        !ui_epk_format_range(ctx,
+                             ctx->bip32_path,
+                             MEMBER_SIZE(extended_public_key_ctx_t, bip32_path))) {
         app_set_current_command(CMD_NONE);
         return res_error(SW_BIP32_FORMATTING_FAILED);
     }
@@ -43,7 +43,10 @@ int ui_display_account(extended_public_key_ctx_t* ctx,
     if (!ui_bip32_path_screen(bip32_path,
                               bip32_path_len,
                               ctx->bip32_path,
-                              MEMBER_SIZE(derive_address_ctx_t, bip32_path))) {
+                              MEMBER_SIZE(derive_address_ctx_t, bip32_path)) ||
+        !ui_epk_format_range(ctx,
+                             ctx->bip32_path,
+                             MEMBER_SIZE(extended_public_key_ctx_t, bip32_path))) {
         return res_error(SW_BIP32_BAD_PATH);
     }
 
@@ -64,7 +67,8 @@ int ui_display_account(extended_public_key_ctx_t* ctx,
     memmove(ctx->chain_code, chain_code, CHAIN_CODE_LEN);
 
     nbgl_useCaseChoice(&C_app_logo_64px,
-                       "Export Extended Public Key",
+                       ctx->range.count > 1 ? "Export Extended Public Keys"
+                                            : "Export Extended Public Key",
                        pk_appid,
                        "Confirm",
                        "Cancel",
@@ -73,15 +77,21 @@ int ui_display_account(extended_public_key_ctx_t* ctx,
 
     if (approved) {
         app_set_connected_app_id(ctx->app_token_value);
-        send_response_extended_pubkey(ctx->raw_public_key, ctx->chain_code);
-        explicit_bzero(ctx, sizeof(extended_public_key_ctx_t));
+        app_trust_connected_app();
+        if (ctx->range.count > 0) {
+            // Command stays active until the last chunk of the range is sent
+            ctx->range.approved = true;
+            send_response_extended_pubkeys_chunk(ctx);
+        } else {
+            send_response_extended_pubkey(ctx->raw_public_key, ctx->chain_code);
+            explicit_bzero(ctx, sizeof(extended_public_key_ctx_t));
+        }
     } else {
         explicit_bzero(ctx, sizeof(extended_public_key_ctx_t));
         res_deny();
+        app_set_current_command(CMD_NONE);
     }
 
-    app_set_current_command(CMD_NONE);
-
     ui_menu_main();
 
     return 0;
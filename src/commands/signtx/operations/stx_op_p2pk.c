@@ -9,6 +9,7 @@
 #include "../../../ergo/schnorr.h"
 #include "../../../ergo/network_id.h"
 #include "../stx_ui.h"
+#include "../stx_ui_common.h"
 #include "../../../ui/ui_main.h"
 #include "../../../ui/display.h"
 #include "../../../ui/ui_menu.h"
@@ -46,6 +47,24 @@ p2pk_input_token_cb(const uint8_t box_id[static ERGO_ID_LEN],
     return stx_amounts_add_input_token(&ctx->amounts, box_id, tn_id, value);
 }
 
+static NOINLINE ergo_tx_serializer_box_result_e
+p2pk_input_box_token_cb(ergo_tx_serializer_box_type_e type,
+                        const uint8_t tn_id[static ERGO_ID_LEN],
+                        uint64_t value,
+                        void *context) {
+    UNUSED(type);
+    sign_transaction_operation_p2pk_ctx_t *ctx = (sign_transaction_operation_p2pk_ctx_t *) context;
+    // Box id is not known yet. It isn't used by amounts, so tx id is passed instead.
+    switch (stx_amounts_add_input_token(&ctx->amounts, ctx->transaction.input.tx_id, tn_id, value)) {
+        case ERGO_TX_SERIALIZER_INPUT_RES_OK:
+            return ERGO_TX_SERIALIZER_BOX_RES_OK;
+        case ERGO_TX_SERIALIZER_INPUT_RES_ERR_U64_OVERFLOW:
+            return ERGO_TX_SERIALIZER_BOX_RES_ERR_U64_OVERFLOW;
+        default:
+            return ERGO_TX_SERIALIZER_BOX_RES_ERR_TOO_MANY_TOKENS;
+    }
+}
+
 static NOINLINE ergo_tx_serializer_box_result_e
 p2pk_output_type_cb(ergo_tx_serializer_box_type_e type, uint64_t value, void *context) {
     sign_transaction_operation_p2pk_ctx_t *ctx = (sign_transaction_operation_p2pk_ctx_t *) context;
@@ -91,7 +110,12 @@ uint16_t stx_operation_p2pk_init(sign_transaction_operation_p2pk_ctx_t *ctx,
         explicit_bzero(secret, PRIVATE_KEY_LEN);
         return SW_INTERNAL_CRYPTO_ERROR;
     }
-    bool inited = ergo_secp256k1_schnorr_p2pk_sign_init(&ctx->tx_hash, ctx->schnorr_key, secret);
+    // Nonce is usually precomputed while the app is idle
+    app_prepare_schnorr_nonce();
+    bool inited = ergo_secp256k1_schnorr_p2pk_sign_init(&ctx->tx_hash,
+                                                        ctx->schnorr_key,
+                                                        secret,
+                                                        app_schnorr_nonce());
     explicit_bzero(secret, PRIVATE_KEY_LEN);
 
     if (!inited) {
@@ -104,6 +128,8 @@ uint16_t stx_operation_p2pk_init(sign_transaction_operation_p2pk_ctx_t *ctx,
     ctx->network_id = network_id;
     ctx->state = SIGN_TRANSACTION_OPERATION_P2PK_STATE_INITIALIZED;
     ctx->blind_signing_required = 0;
+    stx_own_keys_init(&ctx->own_keys);
+    stx_change_paths_init(&ctx->change_paths);
 
     return SW_OK;
 }
@@ -112,7 +138,7 @@ uint16_t stx_operation_p2pk_start_tx(sign_transaction_operation_p2pk_ctx_t *ctx,
                                      uint16_t inputs_count,
                                      uint16_t data_inputs_count,
                                      uint16_t outputs_count,
-                                     uint8_t tokens_count) {
+                                     uint16_t tokens_count) {
     CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_INITIALIZED);
     CHECK_TX_CALL_RESULT_OK(ctx,
                             ergo_tx_serializer_full_init(&ctx->transaction.tx,
@@ -123,6 +149,7 @@ uint16_t stx_operation_p2pk_start_tx(sign_transaction_operation_p2pk_ctx_t *ctx,
                                                          &ctx->tx_hash,
                                                          &ctx->amounts.tokens_table));
     stx_amounts_init(&ctx->amounts);
+    stx_review_init(&ctx->review);
     ctx->state = SIGN_TRANSACTION_OPERATION_P2PK_STATE_TX_STARTED;
     return SW_OK;
 }
@@ -173,6 +200,102 @@ uint16_t stx_operation_p2pk_add_input_tokens(sign_transaction_operation_p2pk_ctx
     return SW_OK;
 }
 
+// Adds input with calculated box id to the transaction when inline box is finished
+static NOINLINE uint16_t input_box_finished(sign_transaction_operation_p2pk_ctx_t *ctx) {
+    sign_transaction_operation_p2pk_input_box_ctx_t *input = &ctx->transaction.input;
+    uint8_t box_id[ERGO_ID_LEN];
+    buffer_t no_tokens = {0};
+
+    if (!ergo_tx_serializer_box_is_finished(&input->box)) {
+        return SW_OK;
+    }
+    CHECK_CALL_RESULT_SW_OK(
+        ctx,
+        sw_from_tx_box_result(
+            ergo_tx_serializer_box_id_hash(&input->box, input->tx_id, input->box_index, box_id)));
+    // Tokens are already in the amounts. Input has one empty frame.
+    CHECK_TX_CALL_RESULT_OK(ctx,
+                            ergo_tx_serializer_full_add_input(&ctx->transaction.tx,
+                                                              box_id,
+                                                              1,
+                                                              input->extension_length));
+    CHECK_TX_CALL_RESULT_OK(
+        ctx,
+        ergo_tx_serializer_full_add_input_tokens(&ctx->transaction.tx, box_id, 0, &no_tokens));
+    CHECK_CALL_RESULT_SW_OK(ctx, stx_amounts_add_input(&ctx->amounts, input->value));
+    ctx->state = SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUTS_STARTED;
+    return SW_OK;
+}
+
+uint16_t stx_operation_p2pk_add_input_box(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                          const uint8_t tx_id[static ERGO_ID_LEN],
+                                          uint16_t box_index,
+                                          uint64_t value,
+                                          uint32_t ergo_tree_size,
+                                          uint32_t creation_height,
+                                          uint8_t tokens_count,
+                                          uint32_t registers_size,
+                                          uint32_t extension_length) {
+    CHECK_PROPER_STATES(ctx,
+                        SIGN_TRANSACTION_OPERATION_P2PK_STATE_TX_STARTED,
+                        SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUTS_STARTED);
+    sign_transaction_operation_p2pk_input_box_ctx_t *input = &ctx->transaction.input;
+    memset(input, 0, sizeof(sign_transaction_operation_p2pk_input_box_ctx_t));
+
+    if (!ergo_tx_serializer_box_id_hash_init(&input->hash)) {
+        return handler_err(ctx, SW_HASHER_ERROR);
+    }
+    CHECK_CALL_RESULT_SW_OK(ctx,
+                            sw_from_tx_box_result(ergo_tx_serializer_box_init(&input->box,
+                                                                              value,
+                                                                              ergo_tree_size,
+                                                                              creation_height,
+                                                                              tokens_count,
+                                                                              registers_size,
+                                                                              &input->hash)));
+    ergo_tx_serializer_box_set_callbacks(&input->box,
+                                         NULL,
+                                         &p2pk_input_box_token_cb,
+                                         NULL,
+                                         (void *) ctx);
+    memmove(input->tx_id, tx_id, ERGO_ID_LEN);
+    input->box_index = box_index;
+    input->value = value;
+    input->extension_length = extension_length;
+    ctx->state = SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUT_BOX_STARTED;
+    return SW_OK;
+}
+
+uint16_t stx_operation_p2pk_add_input_box_tree_chunk(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                     buffer_t *data) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUT_BOX_STARTED);
+    CHECK_CALL_RESULT_SW_OK(
+        ctx,
+        sw_from_tx_box_result(ergo_tx_serializer_box_add_tree(&ctx->transaction.input.box, data)));
+    return input_box_finished(ctx);
+}
+
+uint16_t stx_operation_p2pk_add_input_box_tokens(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                 buffer_t *data) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUT_BOX_STARTED);
+    CHECK_CALL_RESULT_SW_OK(ctx,
+                            sw_from_tx_box_result(ergo_tx_serializer_box_add_tokens(
+                                &ctx->transaction.input.box,
+                                data,
+                                NULL)));
+    return input_box_finished(ctx);
+}
+
+uint16_t stx_operation_p2pk_add_input_box_registers(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                    buffer_t *data) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUT_BOX_STARTED);
+    CHECK_CALL_RESULT_SW_OK(ctx,
+                            sw_from_tx_box_result(ergo_tx_serializer_box_add_registers(
+                                &ctx->transaction.input.box,
+                                data)));
+    return input_box_finished(ctx);
+}
+
 uint16_t stx_operation_p2pk_add_input_context_extension(sign_transaction_operation_p2pk_ctx_t *ctx,
                                                         buffer_t *data) {
     CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUTS_STARTED);
@@ -264,11 +387,30 @@ uint16_t stx_operation_p2pk_add_output_tree_fee(sign_transaction_operation_p2pk_
     return SW_OK;
 }
 
-uint16_t stx_operation_p2pk_add_output_tree_change(sign_transaction_operation_p2pk_ctx_t *ctx,
-                                                   const uint32_t path[static MAX_BIP32_PATH],
-                                                   uint8_t path_len,
-                                                   const uint8_t pub_key[static PUBLIC_KEY_LEN]) {
-    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_OUTPUTS_STARTED);
+// Validates change path and derives its compressed public key
+static NOINLINE uint16_t change_key_derive(const uint32_t path[static MAX_BIP32_PATH],
+                                           uint8_t path_len,
+                                           uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
+    uint8_t raw_public_key[PUBLIC_KEY_LEN];
+    if (!bip32_path_validate(path,
+                             path_len,
+                             BIP32_HARDENED(44),
+                             BIP32_HARDENED(BIP32_ERGO_COIN),
+                             BIP32_PATH_VALIDATE_ADDRESS_GE5)) {
+        return SW_BIP32_BAD_PATH;
+    }
+    if (crypto_generate_public_key(path, path_len, raw_public_key, NULL) != 0) {
+        return SW_INTERNAL_CRYPTO_ERROR;
+    }
+    public_key[0] = (raw_public_key[64] & 1) ? 0x03 : 0x02;
+    memmove(public_key + 1, raw_public_key + 1, COMPRESSED_PUBLIC_KEY_LEN - 1);
+    return SW_OK;
+}
+
+static uint16_t add_output_tree_change(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                       const uint32_t path[static MAX_BIP32_PATH],
+                                       uint8_t path_len,
+                                       const uint8_t pub_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
     CHECK_TX_CALL_RESULT_OK(
         ctx,
         ergo_tx_serializer_full_add_box_change_tree(&ctx->transaction.tx, pub_key));
@@ -278,6 +420,44 @@ uint16_t stx_operation_p2pk_add_output_tree_change(sign_transaction_operation_p2
     return SW_OK;
 }
 
+uint16_t stx_operation_p2pk_register_change_path(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                 const uint32_t path[static MAX_BIP32_PATH],
+                                                 uint8_t path_len,
+                                                 uint8_t *index) {
+    CHECK_PROPER_STATES(ctx,
+                        SIGN_TRANSACTION_OPERATION_P2PK_STATE_INITIALIZED,
+                        SIGN_TRANSACTION_OPERATION_P2PK_STATE_TX_STARTED);
+    // Registering the same path again returns its index
+    if (stx_change_paths_find(&ctx->change_paths, path, path_len, index)) return SW_OK;
+    if (ctx->change_paths.count >= CHANGE_PATHS_MAX_COUNT) {
+        return handler_err(ctx, SW_TOO_MANY_CHANGE_PATHS);
+    }
+    uint8_t public_key[COMPRESSED_PUBLIC_KEY_LEN];
+    CHECK_CALL_RESULT_SW_OK(ctx, change_key_derive(path, path_len, public_key));
+    if (!stx_change_paths_add(&ctx->change_paths, path, path_len, public_key, index)) {
+        return handler_err(ctx, SW_TOO_MANY_CHANGE_PATHS);
+    }
+    return SW_OK;
+}
+
+uint16_t stx_operation_p2pk_add_output_tree_change(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                   const uint32_t path[static MAX_BIP32_PATH],
+                                                   uint8_t path_len) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_OUTPUTS_STARTED);
+    uint8_t public_key[COMPRESSED_PUBLIC_KEY_LEN];
+    CHECK_CALL_RESULT_SW_OK(ctx, change_key_derive(path, path_len, public_key));
+    return add_output_tree_change(ctx, path, path_len, public_key);
+}
+
+uint16_t stx_operation_p2pk_add_output_tree_change_indexed(
+    sign_transaction_operation_p2pk_ctx_t *ctx,
+    uint8_t index) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_OUTPUTS_STARTED);
+    const sign_transaction_change_path_t *change = stx_change_paths_get(&ctx->change_paths, index);
+    if (change == NULL) return handler_err(ctx, SW_BAD_CHANGE_PATH_INDEX);
+    return add_output_tree_change(ctx, change->path, change->len, change->public_key);
+}
+
 uint16_t stx_operation_p2pk_add_output_tokens(sign_transaction_operation_p2pk_ctx_t *ctx,
                                               buffer_t *data) {
     CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_OUTPUTS_STARTED);
@@ -296,6 +476,60 @@ uint16_t stx_operation_p2pk_add_output_registers(sign_transaction_operation_p2pk
     return SW_OK;
 }
 
+// Index of the signing key for own_key_derive, address window is below it
+#define OWN_KEY_SIGNING_INDEX 0xFF
+
+// Derives compressed public key of the signing key or of the own address with the index
+static NOINLINE bool own_key_derive(const sign_transaction_operation_p2pk_ctx_t *ctx,
+                                    uint8_t index,
+                                    uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
+    uint8_t raw_public_key[PUBLIC_KEY_LEN];
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t path_len = ctx->bip32.len;
+
+    memmove(path, ctx->bip32.path, sizeof(uint32_t) * path_len);
+    if (index != OWN_KEY_SIGNING_INDEX) {
+        // address on the chain of the signing account
+        path_len = 5;
+        path[4] = index;
+    }
+    if (crypto_generate_public_key(path, path_len, raw_public_key, NULL) != 0) {
+        return false;
+    }
+    public_key[0] = (raw_public_key[64] & 1) ? 0x03 : 0x02;
+    memmove(public_key + 1, raw_public_key + 1, COMPRESSED_PUBLIC_KEY_LEN - 1);
+    return true;
+}
+
+// Fills own keys set with the address window and the signing key
+static NOINLINE bool own_keys_load(sign_transaction_operation_p2pk_ctx_t *ctx) {
+    uint8_t public_key[COMPRESSED_PUBLIC_KEY_LEN];
+    if (!own_key_derive(ctx, OWN_KEY_SIGNING_INDEX, public_key) ||
+        !stx_own_keys_add(&ctx->own_keys, public_key)) {
+        return false;
+    }
+    for (uint16_t index = 0; index < OWN_ADDRESSES_WINDOW; index++) {
+        // signing key is already in the set
+        if (ctx->bip32.len == 5 && ctx->bip32.path[4] == index) continue;
+        if (!own_key_derive(ctx, (uint8_t) index, public_key) ||
+            !stx_own_keys_add(&ctx->own_keys, public_key)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks if compressed public key belongs to one of own addresses.
+// Keys are derived once, with the first address output.
+static NOINLINE bool is_own_public_key(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                       const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
+    if (stx_own_keys_is_empty(&ctx->own_keys) && !own_keys_load(ctx)) {
+        stx_own_keys_init(&ctx->own_keys);
+        return false;
+    }
+    return stx_own_keys_contains(&ctx->own_keys, public_key);
+}
+
 bool stx_operation_p2pk_should_show_output_confirm_screen(
     sign_transaction_operation_p2pk_ctx_t *ctx) {
     if (ctx->state != SIGN_TRANSACTION_OPERATION_P2PK_STATE_OUTPUTS_STARTED &&
@@ -327,6 +561,11 @@ bool stx_operation_p2pk_should_show_output_confirm_screen(
             ctx->transaction.ui.output.bip32_path.path[4] < ctx->bip32.path[4] + 20)
             return false;
     }
+    // Address of the signing account
+    if (stx_output_info_type(&ctx->transaction.ui.output) ==
+        SIGN_TRANSACTION_OUTPUT_INFO_TYPE_ADDRESS) {
+        return !is_own_public_key(ctx, ctx->transaction.ui.output.public_key);
+    }
     return true;
 }
 
@@ -334,7 +573,7 @@ bool stx_operation_p2pk_should_show_output_confirm_screen(
 // UI
 
 static uint8_t signtx_screen = 0;
-static uint8_t signtx_outputs_screen = 0;
+static uint16_t signtx_outputs_screen = 0;
 
 #ifdef HAVE_BAGL
 static void blind_signing_callback(bool is_settings) {
@@ -434,21 +673,21 @@ uint16_t ui_stx_operation_p2pk_show_output_confirm_screen(
             }
 
             return SW_OK;
-        } else {
-            // blind signing screen
-            ui_add_screen(&ux_stx_blind_signing_step, &signtx_screen);
         }
 #endif
     }
 
-    if (!ui_stx_add_output_screens(&ctx->transaction.ui.ui,
-                                   &signtx_screen,
-                                   &signtx_outputs_screen,
-                                   &ctx->transaction.ui.output,
-                                   &ctx->transaction.last_approved_change,
-                                   ctx->network_id)) {
-        return SW_SCREENS_BUFFER_OVERFLOW;
+    CHECK_CALL_RESULT_SW_OK(ctx, stx_review_add_output(&ctx->review, &ctx->transaction.ui.output));
+
+    explicit_bzero(&ctx->transaction.last_approved_change, sizeof(sign_transaction_bip32_path_t));
+    // store last approved change address
+    if (stx_output_info_type(&ctx->transaction.ui.output) ==
+        SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32) {
+        memmove(&ctx->transaction.last_approved_change,
+                &ctx->transaction.ui.output.bip32_path,
+                sizeof(sign_transaction_bip32_path_t));
     }
+    res_ok();
     return SW_OK;
 }
 
@@ -484,36 +723,76 @@ static NOINLINE void ui_stx_operation_p2pk_send_response(void *cb_context) {
         app_set_current_command(CMD_NONE);
         res_error(SW_SCHNORR_SIGNING_FAILED);
     }
+
+    // Response is sent from the UI callback, so the nonce of the next signature
+    // is computed while the user is looking at the screen
+    app_prepare_schnorr_nonce();
+}
+
+// Number of screens of the reviewed outputs
+static NOINLINE uint16_t review_screens_count(const sign_transaction_operation_p2pk_ctx_t *ctx) {
+    uint16_t count = 0;
+    for (uint8_t i = 0; i < stx_review_outputs_count(&ctx->review); i++) {
+        count += ui_stx_output_screens_count(stx_review_output_type(&ctx->review, i),
+                                             stx_review_output_tokens_count(&ctx->review, i));
+    }
+    return count;
 }
 
-static NOINLINE uint16_t ui_stx_operation_p2pk_show_tx_screen(uint8_t index,
+// Renders screens of the reviewed outputs on demand
+static NOINLINE uint16_t ui_stx_operation_p2pk_show_tx_screen(uint16_t index,
                                                               char *title,
                                                               size_t title_len,
                                                               char *text,
                                                               size_t text_len,
                                                               void *cb_ctx) {
     sign_transaction_operation_p2pk_ctx_t *ctx = (sign_transaction_operation_p2pk_ctx_t *) cb_ctx;
-    if (index != 0) return SW_BAD_STATE;
-    strncpy(title, "P2PK Path", title_len);
-    if (!bip32_path_format(ctx->bip32.path, ctx->bip32.len, text, text_len)) {
-        return SW_BIP32_FORMATTING_FAILED;
+    sign_transaction_operation_p2pk_ui_output_info_ctx_t *ui = &ctx->transaction.ui;
+    if (title_len < sizeof(ui->ui.title) || text_len < sizeof(ui->ui.text)) {
+        return SW_BUFFER_ERROR;
     }
-    return SW_OK;
+    // Find output of the screen
+    uint8_t output = 0;
+    for (; output < stx_review_outputs_count(&ctx->review); output++) {
+        uint16_t count =
+            ui_stx_output_screens_count(stx_review_output_type(&ctx->review, output),
+                                        stx_review_output_tokens_count(&ctx->review, output));
+        if (index < count) break;
+        index -= count;
+    }
+    // Output info isn't used after outputs are finished. Reload it only for the new output.
+    if (output != ui->review_index) {
+        uint16_t res =
+            stx_review_load_output(&ctx->review, output, &ctx->amounts.tokens_table, &ui->output);
+        if (res != SW_OK) return res;
+        ui->review_index = output;
+    }
+    ui->ui.network_id = ctx->network_id;
+    ui->ui.output = &ui->output;
+    return ui_stx_display_output_state(index, title, text, &ui->ui);
 }
 
 uint16_t ui_stx_operation_p2pk_show_confirm_screen(sign_transaction_operation_p2pk_ctx_t *ctx) {
     CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_OPERATION_P2PK_STATE_TX_FINISHED);
     ctx->state = SIGN_TRANSACTION_OPERATION_P2PK_STATE_FINALIZED;
 
+    ctx->transaction.ui.review_index = INDEX_NOT_EXIST;
+#ifdef HAVE_BAGL
+    if (ctx->blind_signing_required) {
+        // blind signing screen
+        ui_add_screen(&ux_stx_blind_signing_step, &signtx_screen);
+    }
+#endif
     if (!ui_stx_add_transaction_screens(&ctx->ui_confirm,
                                         &signtx_screen,
                                         &signtx_outputs_screen,
                                         &ctx->amounts,
                                         ctx->blind_signing_required,
-                                        0,
+                                        review_screens_count(ctx),
                                         ui_stx_operation_p2pk_show_tx_screen,
                                         ui_stx_operation_p2pk_send_response,
-                                        (void *) ctx)) {
+                                        (void *) ctx,
+                                        &ctx->text_pool)) {
         return SW_SCREENS_BUFFER_OVERFLOW;
     }
 #ifdef HAVE_BAGL
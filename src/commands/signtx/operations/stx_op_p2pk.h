@@ -3,9 +3,13 @@
 #include "../stx_types.h"
 #include "../stx_amounts.h"
 #include "../stx_output.h"
+#include "../stx_own_keys.h"
+#include "../stx_change_paths.h"
+#include "../stx_review.h"
 #include "../../../common/bip32_ext.h"
 #include "../../../ui/ui_application_id.h"
 #include "../../../ui/ui_bip32_path.h"
+#include "../../../ui/ui_text_pool.h"
 
 typedef struct {
     sign_transaction_ui_aprove_ctx_t ui_approve;
@@ -15,12 +19,23 @@ typedef struct {
 typedef struct {
     sign_transaction_output_info_ctx_t output;
     sign_transaction_ui_output_confirm_ctx_t ui;
+    uint8_t review_index;  // review log destination loaded into output
 } sign_transaction_operation_p2pk_ui_output_info_ctx_t;
 
+typedef struct {
+    ergo_tx_serializer_box_context_t box;
+    cx_blake2b_t hash;  // box id hash
+    uint8_t tx_id[ERGO_ID_LEN];
+    uint16_t box_index;
+    uint64_t value;
+    uint32_t extension_length;
+} sign_transaction_operation_p2pk_input_box_ctx_t;
+
 typedef enum {
     SIGN_TRANSACTION_OPERATION_P2PK_STATE_INITIALIZED,
     SIGN_TRANSACTION_OPERATION_P2PK_STATE_TX_STARTED,
     SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUTS_STARTED,
+    SIGN_TRANSACTION_OPERATION_P2PK_STATE_INPUT_BOX_STARTED,
     SIGN_TRANSACTION_OPERATION_P2PK_STATE_OUTPUTS_STARTED,
     SIGN_TRANSACTION_OPERATION_P2PK_STATE_TX_FINISHED,
     SIGN_TRANSACTION_OPERATION_P2PK_STATE_FINALIZED,
@@ -29,7 +44,10 @@ typedef enum {
 
 typedef struct {
     ergo_tx_serializer_full_context_t tx;
-    sign_transaction_operation_p2pk_ui_output_info_ctx_t ui;
+    union {
+        sign_transaction_operation_p2pk_ui_output_info_ctx_t ui;  // outputs
+        sign_transaction_operation_p2pk_input_box_ctx_t input;    // inline input box
+    };
     sign_transaction_bip32_path_t last_approved_change;
 } sign_transaction_operation_p2pk_transaction_ctx_t;
 
@@ -41,6 +59,12 @@ typedef struct {
     cx_blake2b_t tx_hash;
     uint8_t network_id;
     sign_transaction_amounts_ctx_t amounts;
+    union {
+        sign_transaction_own_keys_ctx_t own_keys;  // loaded with the first address output
+        ui_text_pool_t text_pool;                  // confirmation screens, outputs are finished
+    };
+    sign_transaction_review_ctx_t review;      // outputs shown on confirmation
+    sign_transaction_change_paths_ctx_t change_paths;
 
     sign_transaction_operation_p2pk_transaction_ctx_t transaction;
     sign_transaction_operation_p2pk_ui_approve_data_ctx_t ui_approve;
@@ -59,7 +83,7 @@ uint16_t stx_operation_p2pk_start_tx(sign_transaction_operation_p2pk_ctx_t *ctx,
                                      uint16_t inputs_count,
                                      uint16_t data_inputs_count,
                                      uint16_t outputs_count,
-                                     uint8_t tokens_count);
+                                     uint16_t tokens_count);
 
 uint16_t stx_operation_p2pk_add_tokens(sign_transaction_operation_p2pk_ctx_t *ctx, buffer_t *cdata);
 
@@ -74,6 +98,25 @@ uint16_t stx_operation_p2pk_add_input_tokens(sign_transaction_operation_p2pk_ctx
                                              uint8_t frame_index,
                                              buffer_t *tokens);
 
+uint16_t stx_operation_p2pk_add_input_box(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                          const uint8_t tx_id[static ERGO_ID_LEN],
+                                          uint16_t box_index,
+                                          uint64_t value,
+                                          uint32_t ergo_tree_size,
+                                          uint32_t creation_height,
+                                          uint8_t tokens_count,
+                                          uint32_t registers_size,
+                                          uint32_t extension_length);
+
+uint16_t stx_operation_p2pk_add_input_box_tree_chunk(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                     buffer_t *data);
+
+uint16_t stx_operation_p2pk_add_input_box_tokens(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                 buffer_t *data);
+
+uint16_t stx_operation_p2pk_add_input_box_registers(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                    buffer_t *data);
+
 uint16_t stx_operation_p2pk_add_input_context_extension(sign_transaction_operation_p2pk_ctx_t *ctx,
                                                         buffer_t *data);
 
@@ -92,10 +135,18 @@ uint16_t stx_operation_p2pk_add_output_tree_chunk(sign_transaction_operation_p2p
 
 uint16_t stx_operation_p2pk_add_output_tree_fee(sign_transaction_operation_p2pk_ctx_t *ctx);
 
+uint16_t stx_operation_p2pk_register_change_path(sign_transaction_operation_p2pk_ctx_t *ctx,
+                                                 const uint32_t path[static MAX_BIP32_PATH],
+                                                 uint8_t path_len,
+                                                 uint8_t *index);
+
 uint16_t stx_operation_p2pk_add_output_tree_change(sign_transaction_operation_p2pk_ctx_t *ctx,
                                                    const uint32_t path[static MAX_BIP32_PATH],
-                                                   uint8_t path_len,
-                                                   const uint8_t pub_key[static PUBLIC_KEY_LEN]);
+                                                   uint8_t path_len);
+
+uint16_t stx_operation_p2pk_add_output_tree_change_indexed(
+    sign_transaction_operation_p2pk_ctx_t *ctx,
+    uint8_t index);
 
 uint16_t stx_operation_p2pk_add_output_tokens(sign_transaction_operation_p2pk_ctx_t *ctx,
                                               buffer_t *data);
@@ -124,7 +175,8 @@ uint16_t ui_stx_operation_p2pk_show_token_and_path(sign_transaction_operation_p2
                                                    void *sign_tx_ctx);
 
 /**
- * Display output confirmation screen
+ * Add output to the transaction review. Output screens are displayed
+ * with the transaction confirmation, so streaming continues without waiting for the user.
  *
  * @return SW_OK if success, error code otherwise.
  *
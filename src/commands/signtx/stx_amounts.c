@@ -8,10 +8,10 @@ ergo_tx_serializer_input_result_e stx_amounts_add_input_token(
     uint64_t value) {
     UNUSED(box_id);
     // searching for token in table
-    uint8_t index = token_table_find_token_index(&ctx->tokens_table, tn_id);
-    if (!IS_ELEMENT_FOUND(index)) {
+    uint16_t index = token_table_find_token_index(&ctx->tokens_table, tn_id);
+    if (!IS_ELEMENT16_FOUND(index)) {
         index = token_table_add_token(&ctx->tokens_table, tn_id);
-        if (!IS_ELEMENT_FOUND(index)) return ERGO_TX_SERIALIZER_INPUT_RES_ERR_TOO_MANY_TOKENS;
+        if (!IS_ELEMENT16_FOUND(index)) return ERGO_TX_SERIALIZER_INPUT_RES_ERR_TOO_MANY_TOKENS;
         ctx->tokens[index] = 0;
     }
     // calculating proper token sum
@@ -51,8 +51,8 @@ ergo_tx_serializer_box_result_e stx_amounts_add_output_token(sign_transaction_am
                                                              const uint8_t id[static ERGO_ID_LEN],
                                                              uint64_t value) {
     UNUSED(type);
-    uint8_t index = token_table_find_token_index(&ctx->tokens_table, id);
-    if (!IS_ELEMENT_FOUND(index)) {
+    uint16_t index = token_table_find_token_index(&ctx->tokens_table, id);
+    if (!IS_ELEMENT16_FOUND(index)) {
         return ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_ID;
     }
     if (!checked_sub_i64(ctx->tokens[index],
@@ -63,19 +63,19 @@ ergo_tx_serializer_box_result_e stx_amounts_add_output_token(sign_transaction_am
     return ERGO_TX_SERIALIZER_BOX_RES_OK;
 }
 
-uint8_t stx_amounts_non_zero_tokens_count(const sign_transaction_amounts_ctx_t *ctx) {
-    uint8_t count = 0;
-    for (uint8_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+uint16_t stx_amounts_non_zero_tokens_count(const sign_transaction_amounts_ctx_t *ctx) {
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
         if (ctx->tokens[i] != 0) count++;
     }
     return count;
 }
 
-uint8_t stx_amounts_non_zero_token_index(const sign_transaction_amounts_ctx_t *ctx,
-                                         uint8_t zero_index) {
-    uint8_t count = 0;
-    for (uint8_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+uint16_t stx_amounts_non_zero_token_index(const sign_transaction_amounts_ctx_t *ctx,
+                                          uint16_t zero_index) {
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
         if (ctx->tokens[i] != 0 && count++ == zero_index) return i;
     }
-    return INDEX_NOT_EXIST;
+    return INDEX16_NOT_EXIST;
 }
\ No newline at end of file
@@ -39,7 +39,7 @@ ergo_tx_serializer_box_result_e stx_amounts_add_output_token(sign_transaction_am
                                                              const uint8_t id[static ERGO_ID_LEN],
                                                              uint64_t value);
 
-uint8_t stx_amounts_non_zero_tokens_count(const sign_transaction_amounts_ctx_t *ctx);
+uint16_t stx_amounts_non_zero_tokens_count(const sign_transaction_amounts_ctx_t *ctx);
 
-uint8_t stx_amounts_non_zero_token_index(const sign_transaction_amounts_ctx_t *ctx,
-                                         uint8_t zero_index);
+uint16_t stx_amounts_non_zero_token_index(const sign_transaction_amounts_ctx_t *ctx,
+                                          uint16_t zero_index);
@@ -0,0 +1,39 @@
+#include <stddef.h>  // NULL
+
+#include "stx_change_paths.h"
+
+bool stx_change_paths_find(const sign_transaction_change_paths_ctx_t* ctx,
+                           const uint32_t* path,
+                           uint8_t path_len,
+                           uint8_t* index) {
+    for (uint8_t i = 0; i < ctx->count; i++) {
+        const sign_transaction_change_path_t* entry = &ctx->paths[i];
+        if (entry->len == path_len &&
+            memcmp(entry->path, path, path_len * sizeof(uint32_t)) == 0) {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool stx_change_paths_add(sign_transaction_change_paths_ctx_t* ctx,
+                          const uint32_t* path,
+                          uint8_t path_len,
+                          const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN],
+                          uint8_t* index) {
+    if (ctx->count >= CHANGE_PATHS_MAX_COUNT || path_len > MAX_BIP32_PATH) return false;
+    sign_transaction_change_path_t* entry = &ctx->paths[ctx->count];
+    entry->len = path_len;
+    memmove(entry->path, path, path_len * sizeof(uint32_t));
+    memmove(entry->public_key, public_key, COMPRESSED_PUBLIC_KEY_LEN);
+    *index = ctx->count++;
+    return true;
+}
+
+const sign_transaction_change_path_t* stx_change_paths_get(
+    const sign_transaction_change_paths_ctx_t* ctx,
+    uint8_t index) {
+    if (index >= ctx->count) return NULL;
+    return &ctx->paths[index];
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <string.h>   // memset
+
+#include "../../common/bip32_ext.h"
+#include "../../constants.h"
+
+#if CHANGE_PATHS_MAX_COUNT == 0 || CHANGE_PATHS_MAX_COUNT > 255
+#error "CHANGE_PATHS_MAX_COUNT should be in 1..255"
+#endif
+
+/**
+ * Change path registered in the session with its derived public key.
+ */
+typedef struct {
+    uint8_t len;
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t public_key[COMPRESSED_PUBLIC_KEY_LEN];
+} sign_transaction_change_path_t;
+
+/**
+ * Change paths of the signing session. Paths are validated and derived once on registration,
+ * change outputs refer to them by index.
+ */
+typedef struct {
+    uint8_t count;
+    sign_transaction_change_path_t paths[CHANGE_PATHS_MAX_COUNT];
+} sign_transaction_change_paths_ctx_t;
+
+static inline void stx_change_paths_init(sign_transaction_change_paths_ctx_t* ctx) {
+    memset(ctx, 0, sizeof(sign_transaction_change_paths_ctx_t));
+}
+
+/**
+ * Find registered path.
+ *
+ * @param[in] ctx
+ *   Paths context.
+ * @param[in] path
+ *   BIP32 path.
+ * @param[in] path_len
+ *   BIP32 path length.
+ * @param[out] index
+ *   Index of the found path.
+ *
+ * @return true if found.
+ *
+ */
+bool stx_change_paths_find(const sign_transaction_change_paths_ctx_t* ctx,
+                           const uint32_t* path,
+                           uint8_t path_len,
+                           uint8_t* index);
+
+/**
+ * Register path with its public key.
+ *
+ * @param[in,out] ctx
+ *   Paths context.
+ * @param[in] path
+ *   BIP32 path.
+ * @param[in] path_len
+ *   BIP32 path length.
+ * @param[in] public_key
+ *   Compressed public key of the path.
+ * @param[out] index
+ *   Index of the added path.
+ *
+ * @return true if added, false if the table is full or the path is too long.
+ *
+ */
+bool stx_change_paths_add(sign_transaction_change_paths_ctx_t* ctx,
+                          const uint32_t* path,
+                          uint8_t path_len,
+                          const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN],
+                          uint8_t* index);
+
+/**
+ * Get registered path by index.
+ *
+ * @param[in] ctx
+ *   Paths context.
+ * @param[in] index
+ *   Path index.
+ *
+ * @return path, NULL if the index isn't registered.
+ *
+ */
+const sign_transaction_change_path_t* stx_change_paths_get(
+    const sign_transaction_change_paths_ctx_t* ctx,
+    uint8_t index);
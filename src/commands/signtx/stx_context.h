@@ -4,11 +4,13 @@
 #include <stdbool.h>
 
 #include "stx_types.h"
+#include "stx_sequence.h"
 #include "./operations/stx_op_p2pk.h"
 
 typedef struct {
     sign_transaction_state_e state;
     uint8_t session;
+    sign_transaction_sequence_t sequence;
     sign_transaction_operation_type_e operation;
     union {
         sign_transaction_operation_p2pk_ctx_t p2pk;
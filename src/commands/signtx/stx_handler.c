@@ -9,6 +9,7 @@
 #include "../../common/macros_ext.h"
 #include "../../helpers/crypto.h"
 #include "../../helpers/input_frame.h"
+#include "../../helpers/stats.h"
 #include "../../ergo/schnorr.h"
 
 #include "./operations/stx_op_p2pk.h"
@@ -16,6 +17,9 @@
 #define COMMAND_ERROR_HANDLER handler_err
 #include "../../helpers/cmd_macros.h"
 
+// inputs (2) + data inputs (2) + distinct tokens (2) + outputs (2)
+#define START_TX_WIDE_DATA_LEN 8
+
 static inline int handler_err(sign_transaction_ctx_t *ctx, uint16_t err) {
     ctx->state = SIGN_TRANSACTION_STATE_ERROR;
     app_set_current_command(CMD_NONE);
@@ -30,22 +34,6 @@ static inline uint16_t read_bip32_path(buffer_t *input,
     return SW_OK;
 }
 
-static inline uint16_t bip32_public_key(uint32_t path[MAX_BIP32_PATH],
-                                        uint8_t path_len,
-                                        uint8_t pub_key[static PUBLIC_KEY_LEN]) {
-    if (!bip32_path_validate(path,
-                             path_len,
-                             BIP32_HARDENED(44),
-                             BIP32_HARDENED(BIP32_ERGO_COIN),
-                             BIP32_PATH_VALIDATE_ADDRESS_GE5)) {
-        return SW_BIP32_BAD_PATH;
-    }
-    if (crypto_generate_public_key(path, path_len, pub_key, NULL) != 0) {
-        return SW_INTERNAL_CRYPTO_ERROR;
-    }
-    return SW_OK;
-}
-
 static inline int show_output_screen_if_needed(sign_transaction_ctx_t *ctx) {
     // Should have switch for more ops
     // Check if we have to show screen
@@ -60,8 +48,7 @@ static inline int show_output_screen_if_needed(sign_transaction_ctx_t *ctx) {
 
 static inline int handle_init_p2pk(sign_transaction_ctx_t *ctx,
                                    buffer_t *cdata,
-                                   bool has_token,
-                                   uint32_t app_session_id) {
+                                   bool has_token) {
     uint32_t app_session_id_in = 0;
     uint8_t network_id = 0;
     CHECK_READ_PARAM(ctx, buffer_read_u8(cdata, &network_id));
@@ -77,13 +64,14 @@ static inline int handle_init_p2pk(sign_transaction_ctx_t *ctx,
     ctx->operation = SIGN_TRANSACTION_OPERATION_P2PK;
     ctx->state = SIGN_TRANSACTION_STATE_INITIALIZED;
     ctx->session = session_id_new_random(ctx->session);
+    stx_sequence_init(&ctx->sequence);
 
     // switch between operations if more will be added
     CHECK_CALL_RESULT_SW_OK(ctx,
                             ui_stx_operation_p2pk_show_token_and_path(
                                 &ctx->p2pk,
                                 app_session_id_in,
-                                is_known_application(app_session_id, app_session_id_in),
+                                app_is_known_application(app_session_id_in),
                                 ctx));
     return 0;
 }
@@ -91,11 +79,18 @@ static inline int handle_init_p2pk(sign_transaction_ctx_t *ctx,
 static inline int handle_tx_start(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
     CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
 
-    uint16_t inputs_count, data_inputs_count, outputs_count;
-    uint8_t tokens_count;
+    uint16_t inputs_count, data_inputs_count, outputs_count, tokens_count;
+    // Legacy format has 1 byte tokens count (7 bytes), new one has 2 bytes (8 bytes)
+    bool is_wide_tokens_count = buffer_data_len(cdata) == START_TX_WIDE_DATA_LEN;
     CHECK_READ_PARAM(ctx, buffer_read_u16(cdata, &inputs_count, BE));
     CHECK_READ_PARAM(ctx, buffer_read_u16(cdata, &data_inputs_count, BE));
-    CHECK_READ_PARAM(ctx, buffer_read_u8(cdata, &tokens_count));
+    if (is_wide_tokens_count) {
+        CHECK_READ_PARAM(ctx, buffer_read_u16(cdata, &tokens_count, BE));
+    } else {
+        uint8_t narrow_tokens_count;
+        CHECK_READ_PARAM(ctx, buffer_read_u8(cdata, &narrow_tokens_count));
+        tokens_count = narrow_tokens_count;
+    }
     CHECK_READ_PARAM(ctx, buffer_read_u16(cdata, &outputs_count, BE));
     CHECK_PARAMS_FINISHED(ctx, cdata);
 
@@ -128,6 +123,7 @@ static inline int handle_input_frame(sign_transaction_ctx_t *ctx,
         return handler_err(ctx, SW_NOT_ENOUGH_DATA);
     }
     // Calculate signature. Will be stored in tx_id field in context (we don't need it now).
+    APP_STATS_INC(hmac_calls);
     cx_hmac_sha256(session_key,
                    SESSION_KEY_LEN,
                    buffer_read_ptr(cdata),
@@ -179,6 +175,59 @@ static inline int handle_input_frame(sign_transaction_ctx_t *ctx,
     return res_ok();
 }
 
+static inline int handle_input_box(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
+    uint8_t tx_id[ERGO_ID_LEN];
+    uint16_t box_index;
+    uint64_t value;
+    uint32_t ergo_tree_size, creation_height, registers_size, extension_len;
+    uint8_t tokens_count;
+
+    CHECK_READ_PARAM(ctx, buffer_read_bytes(cdata, tx_id, ERGO_ID_LEN));
+    CHECK_READ_PARAM(ctx, buffer_read_u16(cdata, &box_index, BE));
+    CHECK_READ_PARAM(ctx, buffer_read_u64(cdata, &value, BE));
+    CHECK_READ_PARAM(ctx, buffer_read_u32(cdata, &ergo_tree_size, BE));
+    CHECK_READ_PARAM(ctx, buffer_read_u32(cdata, &creation_height, BE));
+    CHECK_READ_PARAM(ctx, buffer_read_u8(cdata, &tokens_count));
+    CHECK_READ_PARAM(ctx, buffer_read_u32(cdata, &registers_size, BE));
+    CHECK_READ_PARAM(ctx, buffer_read_u32(cdata, &extension_len, BE));
+    CHECK_PARAMS_FINISHED(ctx, cdata);
+
+    // Add input box. Should be switch if more ops added
+    CHECK_CALL_RESULT_SW_OK(ctx,
+                            stx_operation_p2pk_add_input_box(&ctx->p2pk,
+                                                             tx_id,
+                                                             box_index,
+                                                             value,
+                                                             ergo_tree_size,
+                                                             creation_height,
+                                                             tokens_count,
+                                                             registers_size,
+                                                             extension_len));
+    return res_ok();
+}
+
+static inline int handle_input_box_tree_chunk(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
+    // Should be switch if more ops added
+    CHECK_CALL_RESULT_SW_OK(ctx, stx_operation_p2pk_add_input_box_tree_chunk(&ctx->p2pk, cdata));
+    return res_ok();
+}
+
+static inline int handle_input_box_tokens(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
+    // Should be switch if more ops added
+    CHECK_CALL_RESULT_SW_OK(ctx, stx_operation_p2pk_add_input_box_tokens(&ctx->p2pk, cdata));
+    return res_ok();
+}
+
+static inline int handle_input_box_registers(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
+    // Should be switch if more ops added
+    CHECK_CALL_RESULT_SW_OK(ctx, stx_operation_p2pk_add_input_box_registers(&ctx->p2pk, cdata));
+    return res_ok();
+}
+
 static inline int handle_input_context_extension(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
     CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
     // Should be switch if more ops added
@@ -234,23 +283,36 @@ static inline int handle_output_tree_fee(sign_transaction_ctx_t *ctx, buffer_t *
 
 static inline int handle_output_tree_change(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
     CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
-    uint8_t public_key[PUBLIC_KEY_LEN];
+    // Single byte is an index of the registered change path
+    if (buffer_data_len(cdata) == 1) {
+        uint8_t index = 0;
+        CHECK_READ_PARAM(ctx, buffer_read_u8(cdata, &index));
+        // Should be switch if more ops added
+        CHECK_CALL_RESULT_SW_OK(ctx,
+                                stx_operation_p2pk_add_output_tree_change_indexed(&ctx->p2pk, index));
+        return show_output_screen_if_needed(ctx);
+    }
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t path_len = 0;
+    CHECK_CALL_RESULT_SW_OK(ctx, read_bip32_path(cdata, path, &path_len));
     // Should be switch if more ops added
     CHECK_CALL_RESULT_SW_OK(ctx,
-                            read_bip32_path(cdata,
-                                            ctx->p2pk.transaction.ui.output.bip32_path.path,
-                                            &ctx->p2pk.transaction.ui.output.bip32_path.len));
-    CHECK_CALL_RESULT_SW_OK(ctx,
-                            bip32_public_key(ctx->p2pk.transaction.ui.output.bip32_path.path,
-                                             ctx->p2pk.transaction.ui.output.bip32_path.len,
-                                             public_key));
+                            stx_operation_p2pk_add_output_tree_change(&ctx->p2pk, path, path_len));
+    return show_output_screen_if_needed(ctx);
+}
+
+static inline int handle_register_change_path(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t path_len = 0;
+    uint8_t index = 0;
+    CHECK_CALL_RESULT_SW_OK(ctx, read_bip32_path(cdata, path, &path_len));
+    CHECK_PARAMS_FINISHED(ctx, cdata);
+    // Should be switch if more ops added
     CHECK_CALL_RESULT_SW_OK(
         ctx,
-        stx_operation_p2pk_add_output_tree_change(&ctx->p2pk,
-                                                  ctx->p2pk.transaction.ui.output.bip32_path.path,
-                                                  ctx->p2pk.transaction.ui.output.bip32_path.len,
-                                                  public_key));
-    return show_output_screen_if_needed(ctx);
+        stx_operation_p2pk_register_change_path(&ctx->p2pk, path, path_len, &index));
+    return send_response_sign_transaction_change_path_index(index);
 }
 
 static inline int handle_output_tokens(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
@@ -267,6 +329,24 @@ static inline int handle_output_registers(sign_transaction_ctx_t *ctx, buffer_t
     return show_output_screen_if_needed(ctx);
 }
 
+static inline int handle_resume(sign_transaction_ctx_t *ctx, buffer_t *cdata) {
+    CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
+    CHECK_PARAMS_FINISHED(ctx, cdata);
+    uint16_t sequence = 0;
+    if (!stx_sequence_resume(&ctx->sequence, &sequence)) {
+        return handler_err(ctx, SW_BAD_STATE);
+    }
+    return send_response_sign_transaction_sequence(sequence);
+}
+
+// Counts data APDU as acknowledged if it was processed without session error
+static inline int acknowledged(sign_transaction_ctx_t *ctx, int result) {
+    stx_sequence_acknowledge(&ctx->sequence,
+                             app_current_command() == CMD_SIGN_TRANSACTION &&
+                                 ctx->state == SIGN_TRANSACTION_STATE_APPROVED);
+    return result;
+}
+
 static inline int handle_sign_confirm(sign_transaction_ctx_t *ctx) {
     CHECK_PROPER_STATE(ctx, SIGN_TRANSACTION_STATE_APPROVED);
     // Should be switch if more ops added
@@ -288,51 +368,75 @@ int handler_sign_transaction(buffer_t *cdata,
             }
             app_set_current_command(CMD_SIGN_TRANSACTION);
 
-            return handle_init_p2pk(ctx, cdata, session_or_token == 0x02, app_connected_app_id());
+            return handle_init_p2pk(ctx, cdata, session_or_token == 0x02);
+        case SIGN_TRANSACTION_SUBCOMMAND_RESUME:
+            CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
+            CHECK_SESSION(ctx, session_or_token);
+            return handle_resume(ctx, cdata);
         case SIGN_TRANSACTION_SUBCOMMAND_START_TX:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_tx_start(ctx, cdata);
+            return acknowledged(ctx, handle_tx_start(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_TOKEN_IDS:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_tokens(ctx, cdata);
+            return acknowledged(ctx, handle_tokens(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_INPUT_FRAME:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_input_frame(ctx, app_session_key(), cdata);
+            return acknowledged(ctx, handle_input_frame(ctx, app_session_key(), cdata));
+        case SIGN_TRANSACTION_SUBCOMMAND_INPUT_BOX:
+            CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
+            CHECK_SESSION(ctx, session_or_token);
+            return acknowledged(ctx, handle_input_box(ctx, cdata));
+        case SIGN_TRANSACTION_SUBCOMMAND_INPUT_BOX_TREE_CHUNK:
+            CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
+            CHECK_SESSION(ctx, session_or_token);
+            return acknowledged(ctx, handle_input_box_tree_chunk(ctx, cdata));
+        case SIGN_TRANSACTION_SUBCOMMAND_INPUT_BOX_TOKENS:
+            CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
+            CHECK_SESSION(ctx, session_or_token);
+            return acknowledged(ctx, handle_input_box_tokens(ctx, cdata));
+        case SIGN_TRANSACTION_SUBCOMMAND_INPUT_BOX_REGISTERS:
+            CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
+            CHECK_SESSION(ctx, session_or_token);
+            return acknowledged(ctx, handle_input_box_registers(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_INPUT_CONTEXT_EXTENSION:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_input_context_extension(ctx, cdata);
+            return acknowledged(ctx, handle_input_context_extension(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_DATA_INPUT:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_data_inputs(ctx, cdata);
+            return acknowledged(ctx, handle_data_inputs(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_OUTPUT:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_output_init(ctx, cdata);
+            return acknowledged(ctx, handle_output_init(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_OUTPUT_TREE_CHUNK:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_output_tree_chunk(ctx, cdata);
+            return acknowledged(ctx, handle_output_tree_chunk(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_OUTPUT_MINERS_FEE_TREE:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_output_tree_fee(ctx, cdata);
+            return acknowledged(ctx, handle_output_tree_fee(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_OUTPUT_CHANGE_TREE:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_output_tree_change(ctx, cdata);
+            return acknowledged(ctx, handle_output_tree_change(ctx, cdata));
+        case SIGN_TRANSACTION_SUBCOMMAND_REGISTER_CHANGE_PATH:
+            CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
+            CHECK_SESSION(ctx, session_or_token);
+            return acknowledged(ctx, handle_register_change_path(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_OUTPUT_TOKENS:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_output_tokens(ctx, cdata);
+            return acknowledged(ctx, handle_output_tokens(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_OUTPUT_REGISTERS:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
-            return handle_output_registers(ctx, cdata);
+            return acknowledged(ctx, handle_output_registers(ctx, cdata));
         case SIGN_TRANSACTION_SUBCOMMAND_CONFIRM:
             CHECK_COMMAND(ctx, CMD_SIGN_TRANSACTION);
             CHECK_SESSION(ctx, session_or_token);
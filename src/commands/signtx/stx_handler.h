@@ -10,6 +10,7 @@
 
 typedef enum {
     SIGN_TRANSACTION_SUBCOMMAND_SIGN_PK = 0x01,
+    SIGN_TRANSACTION_SUBCOMMAND_RESUME = 0x0F,
     SIGN_TRANSACTION_SUBCOMMAND_START_TX = 0x10,
     SIGN_TRANSACTION_SUBCOMMAND_TOKEN_IDS = 0x11,
     SIGN_TRANSACTION_SUBCOMMAND_INPUT_FRAME = 0x12,
@@ -21,6 +22,11 @@ typedef enum {
     SIGN_TRANSACTION_SUBCOMMAND_OUTPUT_CHANGE_TREE = 0x18,
     SIGN_TRANSACTION_SUBCOMMAND_OUTPUT_TOKENS = 0x19,
     SIGN_TRANSACTION_SUBCOMMAND_OUTPUT_REGISTERS = 0x1A,
+    SIGN_TRANSACTION_SUBCOMMAND_INPUT_BOX = 0x1B,
+    SIGN_TRANSACTION_SUBCOMMAND_INPUT_BOX_TREE_CHUNK = 0x1C,
+    SIGN_TRANSACTION_SUBCOMMAND_INPUT_BOX_TOKENS = 0x1D,
+    SIGN_TRANSACTION_SUBCOMMAND_INPUT_BOX_REGISTERS = 0x1E,
+    SIGN_TRANSACTION_SUBCOMMAND_REGISTER_CHANGE_PATH = 0x1F,
     SIGN_TRANSACTION_SUBCOMMAND_CONFIRM = 0x20
 } sign_transaction_subcommand_e;
 
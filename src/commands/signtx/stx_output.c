@@ -11,12 +11,12 @@
 #define STX_OUTPUT_SET_TYPE(ctx, type) \
     (ctx->state = (ctx->state & 0xC0) | (((uint8_t) type) & 0x3F))
 
-static inline uint8_t find_token_index(const token_table_t* table,
-                                       const uint8_t id[static ERGO_ID_LEN]) {
-    for (uint8_t i = 0; i < table->count; i++) {
+static inline uint16_t find_token_index(const token_table_t* table,
+                                        const uint8_t id[static ERGO_ID_LEN]) {
+    for (uint16_t i = 0; i < table->count; i++) {
         if (memcmp(table->tokens[i], id, ERGO_ID_LEN) == 0) return i;
     }
-    return INDEX_NOT_EXIST;
+    return INDEX16_NOT_EXIST;
 }
 
 static inline ergo_tx_serializer_box_result_e maybe_finished(
@@ -96,8 +96,8 @@ uint16_t stx_output_info_add_tree_chunk(sign_transaction_output_info_ctx_t* ctx,
 ergo_tx_serializer_box_result_e stx_output_info_add_token(sign_transaction_output_info_ctx_t* ctx,
                                                           const uint8_t tn_id[static ERGO_ID_LEN],
                                                           uint64_t value) {
-    uint8_t token_index = 0;
-    if (!IS_ELEMENT_FOUND(token_index = find_token_index(ctx->tokens_table, tn_id))) {
+    uint16_t token_index = 0;
+    if (!IS_ELEMENT16_FOUND(token_index = find_token_index(ctx->tokens_table, tn_id))) {
         return ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_ID;
     }
     if (ctx->tokens[token_index] != 0) {
@@ -113,19 +113,19 @@ ergo_tx_serializer_box_result_e stx_output_info_set_box_finished(
     return maybe_finished(ctx);
 }
 
-uint8_t stx_output_info_used_tokens_count(const sign_transaction_output_info_ctx_t* ctx) {
-    uint8_t count = 0;
-    for (uint8_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+uint16_t stx_output_info_used_tokens_count(const sign_transaction_output_info_ctx_t* ctx) {
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
         if (ctx->tokens[i] > 0) count++;
     }
     return count;
 }
 
-uint8_t stx_output_info_used_token_index(const sign_transaction_output_info_ctx_t* ctx,
-                                         uint8_t used_index) {
-    uint8_t count = 0;
-    for (uint8_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+uint16_t stx_output_info_used_token_index(const sign_transaction_output_info_ctx_t* ctx,
+                                          uint16_t used_index) {
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
         if (ctx->tokens[i] > 0 && count++ == used_index) return i;
     }
-    return INDEX_NOT_EXIST;
+    return INDEX16_NOT_EXIST;
 }
@@ -70,10 +70,10 @@ ergo_tx_serializer_box_result_e stx_output_info_add_token(sign_transaction_outpu
 ergo_tx_serializer_box_result_e stx_output_info_set_box_finished(
     sign_transaction_output_info_ctx_t* ctx);
 
-uint8_t stx_output_info_used_tokens_count(const sign_transaction_output_info_ctx_t* ctx);
+uint16_t stx_output_info_used_tokens_count(const sign_transaction_output_info_ctx_t* ctx);
 
-uint8_t stx_output_info_used_token_index(const sign_transaction_output_info_ctx_t* ctx,
-                                         uint8_t used_index);
+uint16_t stx_output_info_used_token_index(const sign_transaction_output_info_ctx_t* ctx,
+                                          uint16_t used_index);
 
 static inline sign_transaction_output_info_type_e stx_output_info_type(
     const sign_transaction_output_info_ctx_t* ctx) {
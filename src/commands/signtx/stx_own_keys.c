@@ -0,0 +1,42 @@
+#include "stx_own_keys.h"
+
+// Position of the first key which is not less than the given one
+static uint8_t lower_bound(const sign_transaction_own_keys_ctx_t* ctx,
+                           const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
+    uint8_t low = 0;
+    uint8_t high = ctx->count;
+    while (low < high) {
+        uint8_t mid = low + (high - low) / 2;
+        if (memcmp(ctx->keys[mid], public_key, COMPRESSED_PUBLIC_KEY_LEN) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static inline bool is_key_at(const sign_transaction_own_keys_ctx_t* ctx,
+                             uint8_t position,
+                             const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
+    return position < ctx->count &&
+           memcmp(ctx->keys[position], public_key, COMPRESSED_PUBLIC_KEY_LEN) == 0;
+}
+
+bool stx_own_keys_add(sign_transaction_own_keys_ctx_t* ctx,
+                      const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
+    uint8_t position = lower_bound(ctx, public_key);
+    if (is_key_at(ctx, position, public_key)) return true;
+    if (ctx->count >= STX_OWN_KEYS_MAX_COUNT) return false;
+    memmove(ctx->keys[position + 1],
+            ctx->keys[position],
+            (ctx->count - position) * sizeof(ctx->keys[0]));
+    memmove(ctx->keys[position], public_key, COMPRESSED_PUBLIC_KEY_LEN);
+    ctx->count++;
+    return true;
+}
+
+bool stx_own_keys_contains(const sign_transaction_own_keys_ctx_t* ctx,
+                           const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
+    return is_key_at(ctx, lower_bound(ctx, public_key), public_key);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <string.h>   // memset
+
+#include "../../constants.h"
+
+#if OWN_ADDRESSES_WINDOW > 254
+#error "OWN_ADDRESSES_WINDOW can't exceed 254"
+#endif
+
+/**
+ * Maximum number of keys in the set: address window and signing key.
+ */
+#define STX_OWN_KEYS_MAX_COUNT (OWN_ADDRESSES_WINDOW + 1)
+
+/**
+ * Sorted set of own compressed public keys.
+ * Keys are stored in full, so a lookup doesn't need any key derivation.
+ */
+typedef struct {
+    uint8_t count;
+    uint8_t keys[STX_OWN_KEYS_MAX_COUNT][COMPRESSED_PUBLIC_KEY_LEN];  // sorted
+} sign_transaction_own_keys_ctx_t;
+
+static inline void stx_own_keys_init(sign_transaction_own_keys_ctx_t* ctx) {
+    memset(ctx, 0, sizeof(sign_transaction_own_keys_ctx_t));
+}
+
+static inline bool stx_own_keys_is_empty(const sign_transaction_own_keys_ctx_t* ctx) {
+    return ctx->count == 0;
+}
+
+/**
+ * Add compressed public key to the set.
+ *
+ * @param[in,out] ctx
+ *   Set context.
+ * @param[in] public_key
+ *   Compressed public key.
+ *
+ * @return true if added or already in the set, false if set is full.
+ *
+ */
+bool stx_own_keys_add(sign_transaction_own_keys_ctx_t* ctx,
+                      const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]);
+
+/**
+ * Check that compressed public key is in the set.
+ *
+ * @param[in] ctx
+ *   Set context.
+ * @param[in] public_key
+ *   Compressed public key.
+ *
+ * @return true if found.
+ *
+ */
+bool stx_own_keys_contains(const sign_transaction_own_keys_ctx_t* ctx,
+                           const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]);
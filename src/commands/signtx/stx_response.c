@@ -5,3 +5,16 @@ int send_response_sign_transaction_session_id(uint8_t session_id) {
     RW_BUFFER_FROM_VAR_FULL(buf, session_id);
     return res_ok_data(&buf);
 }
+
+int send_response_sign_transaction_change_path_index(uint8_t index) {
+    RW_BUFFER_FROM_VAR_FULL(buf, index);
+    return res_ok_data(&buf);
+}
+
+int send_response_sign_transaction_sequence(uint16_t sequence) {
+    RW_BUFFER_NEW_LOCAL_EMPTY(buf, sizeof(uint16_t));
+    if (!rw_buffer_write_u16(&buf, sequence, BE)) {
+        return res_error(SW_BUFFER_ERROR);
+    }
+    return res_ok_data(&buf);
+}
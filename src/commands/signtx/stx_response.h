@@ -13,3 +13,23 @@
  *
  */
 int send_response_sign_transaction_session_id(uint8_t session_id);
+
+/**
+ * Send APDU response with the registered change path index
+ *
+ * response = (uint8_t)index
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int send_response_sign_transaction_change_path_index(uint8_t index);
+
+/**
+ * Send APDU response with the session sequence number
+ *
+ * response = (uint16_t BE)sequence
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int send_response_sign_transaction_sequence(uint16_t sequence);
@@ -0,0 +1,112 @@
+#include "stx_review.h"
+#include "../../sw.h"
+#include "../../common/safeint.h"
+#include "../../common/macros_ext.h"
+
+static bool is_same_destination(const sign_transaction_review_output_t* entry,
+                                const sign_transaction_output_info_ctx_t* output) {
+    if (STX_OUTPUT_INFO_TYPE(entry) != stx_output_info_type(output)) return false;
+    switch (stx_output_info_type(output)) {
+        case SIGN_TRANSACTION_OUTPUT_INFO_TYPE_ADDRESS:
+            return memcmp(entry->public_key, output->public_key, COMPRESSED_PUBLIC_KEY_LEN) == 0;
+        case SIGN_TRANSACTION_OUTPUT_INFO_TYPE_SCRIPT:
+        case SIGN_TRANSACTION_OUTPUT_INFO_TYPE_SCRIPT_HASH:
+            return memcmp(entry->tree_hash, output->tree_hash, CX_BLAKE2B_256_SIZE) == 0;
+        case SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32:
+            return stx_bip32_path_is_equal(&entry->bip32_path, &output->bip32_path);
+        case SIGN_TRANSACTION_OUTPUT_INFO_TYPE_MINERS_FEE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static uint16_t find_token(const sign_transaction_review_ctx_t* ctx,
+                           uint8_t output_index,
+                           uint16_t token_index) {
+    for (uint16_t i = 0; i < ctx->tokens_count; i++) {
+        if (ctx->token_outputs[i] == output_index && ctx->token_indexes[i] == token_index) {
+            return i;
+        }
+    }
+    return INDEX16_NOT_EXIST;
+}
+
+uint16_t stx_review_add_output(sign_transaction_review_ctx_t* ctx,
+                               const sign_transaction_output_info_ctx_t* output) {
+    if (!stx_output_info_is_finished(output)) return SW_BAD_STATE;
+
+    uint8_t index = 0;
+    while (index < ctx->outputs_count && !is_same_destination(&ctx->outputs[index], output)) {
+        index++;
+    }
+    bool is_new = index == ctx->outputs_count;
+    if (is_new && index >= REVIEW_MAX_OUTPUTS) return SW_SCREENS_BUFFER_OVERFLOW;
+
+    // Check the whole output before changing the log
+    uint64_t sum = 0;
+    uint16_t new_tokens = 0;
+    if (!is_new && !checked_add_u64(ctx->outputs[index].value, output->value, &sum)) {
+        return SW_U64_OVERFLOW;
+    }
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+        if (output->tokens[i] == 0) continue;
+        uint16_t found = is_new ? INDEX16_NOT_EXIST : find_token(ctx, index, i);
+        if (!IS_ELEMENT16_FOUND(found)) {
+            new_tokens++;
+        } else if (!checked_add_u64(ctx->token_values[found], output->tokens[i], &sum)) {
+            return SW_U64_OVERFLOW;
+        }
+    }
+    if (new_tokens > REVIEW_MAX_TOKENS - ctx->tokens_count) return SW_SCREENS_BUFFER_OVERFLOW;
+
+    sign_transaction_review_output_t* entry = &ctx->outputs[index];
+    if (is_new) {
+        entry->value = output->value;
+        entry->state = output->state;
+        // bip32 path is the largest destination in the union
+        memmove(&entry->bip32_path, &output->bip32_path, sizeof(sign_transaction_bip32_path_t));
+        ctx->outputs_count++;
+    } else {
+        entry->value += output->value;
+    }
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+        if (output->tokens[i] == 0) continue;
+        uint16_t found = is_new ? INDEX16_NOT_EXIST : find_token(ctx, index, i);
+        if (IS_ELEMENT16_FOUND(found)) {
+            ctx->token_values[found] += output->tokens[i];
+        } else {
+            ctx->token_outputs[ctx->tokens_count] = index;
+            ctx->token_indexes[ctx->tokens_count] = i;
+            ctx->token_values[ctx->tokens_count] = output->tokens[i];
+            ctx->tokens_count++;
+        }
+    }
+    return SW_OK;
+}
+
+uint16_t stx_review_output_tokens_count(const sign_transaction_review_ctx_t* ctx, uint8_t index) {
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < ctx->tokens_count; i++) {
+        if (ctx->token_outputs[i] == index) count++;
+    }
+    return count;
+}
+
+uint16_t stx_review_load_output(const sign_transaction_review_ctx_t* ctx,
+                                uint8_t index,
+                                const token_table_t* tokens_table,
+                                sign_transaction_output_info_ctx_t* output) {
+    if (index >= ctx->outputs_count) return SW_BAD_STATE;
+
+    const sign_transaction_review_output_t* entry = &ctx->outputs[index];
+    stx_output_info_init(output, entry->value, tokens_table);
+    output->state = entry->state;
+    memmove(&output->bip32_path, &entry->bip32_path, sizeof(sign_transaction_bip32_path_t));
+    for (uint16_t i = 0; i < ctx->tokens_count; i++) {
+        if (ctx->token_outputs[i] == index) {
+            output->tokens[ctx->token_indexes[i]] = ctx->token_values[i];
+        }
+    }
+    return SW_OK;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <string.h>   // memset
+
+#include "../../constants.h"
+#include "stx_output.h"
+
+#if REVIEW_MAX_OUTPUTS < REVIEW_MIN_OUTPUTS || REVIEW_MAX_OUTPUTS > 255
+#error "REVIEW_MAX_OUTPUTS should be in REVIEW_MIN_OUTPUTS..255"
+#endif
+
+#if REVIEW_MAX_TOKENS < TOKEN_MAX_COUNT || REVIEW_MAX_TOKENS > 0xFFFE
+#error "REVIEW_MAX_TOKENS should be in TOKEN_MAX_COUNT..65534"
+#endif
+
+/**
+ * Destination of the review log. Keeps only data needed for the review screens.
+ * Values are summed for all outputs with the same destination.
+ */
+typedef struct {
+    uint64_t value;
+    union {
+        uint8_t public_key[COMPRESSED_PUBLIC_KEY_LEN];
+        uint8_t tree_hash[CX_BLAKE2B_256_SIZE];
+        sign_transaction_bip32_path_t bip32_path;
+    };
+    uint8_t state;  // output info state: type + is_set + is_finished
+} sign_transaction_review_output_t;
+
+/**
+ * Review log of the outputs which need user confirmation.
+ * Outputs are aggregated by destination while the transaction is streamed
+ * and shown on confirmation.
+ */
+typedef struct {
+    uint8_t outputs_count;
+    uint16_t tokens_count;
+    sign_transaction_review_output_t outputs[REVIEW_MAX_OUTPUTS];
+    uint8_t token_outputs[REVIEW_MAX_TOKENS];   // destination index of the token
+    uint16_t token_indexes[REVIEW_MAX_TOKENS];  // token table indexes
+    uint64_t token_values[REVIEW_MAX_TOKENS];
+} sign_transaction_review_ctx_t;
+
+static inline void stx_review_init(sign_transaction_review_ctx_t* ctx) {
+    memset(ctx, 0, sizeof(sign_transaction_review_ctx_t));
+}
+
+static inline uint8_t stx_review_outputs_count(const sign_transaction_review_ctx_t* ctx) {
+    return ctx->outputs_count;
+}
+
+static inline sign_transaction_output_info_type_e stx_review_output_type(
+    const sign_transaction_review_ctx_t* ctx,
+    uint8_t index) {
+    return STX_OUTPUT_INFO_TYPE((&ctx->outputs[index]));
+}
+
+/**
+ * Number of tokens of the destination in the review log.
+ *
+ * @param[in] ctx
+ *   Review log context.
+ * @param[in] index
+ *   Index of the destination in the log.
+ *
+ * @return number of tokens.
+ *
+ */
+uint16_t stx_review_output_tokens_count(const sign_transaction_review_ctx_t* ctx, uint8_t index);
+
+/**
+ * Add finished output to the review log. Output value and tokens are added
+ * to the destination entry if the log already has the same destination.
+ *
+ * @param[in,out] ctx
+ *   Review log context.
+ * @param[in] output
+ *   Finished output info.
+ *
+ * @return SW_OK if added, SW_SCREENS_BUFFER_OVERFLOW if log is full, error code otherwise.
+ *
+ */
+uint16_t stx_review_add_output(sign_transaction_review_ctx_t* ctx,
+                               const sign_transaction_output_info_ctx_t* output);
+
+/**
+ * Restore output info of the destination from the review log.
+ *
+ * @param[in] ctx
+ *   Review log context.
+ * @param[in] index
+ *   Index of the destination in the log.
+ * @param[in] tokens_table
+ *   Transaction tokens table.
+ * @param[out] output
+ *   Output info to fill.
+ *
+ * @return SW_OK if restored, error code otherwise.
+ *
+ */
+uint16_t stx_review_load_output(const sign_transaction_review_ctx_t* ctx,
+                                uint8_t index,
+                                const token_table_t* tokens_table,
+                                sign_transaction_output_info_ctx_t* output);
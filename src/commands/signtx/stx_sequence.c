@@ -0,0 +1,16 @@
+#include "stx_sequence.h"
+
+void stx_sequence_acknowledge(sign_transaction_sequence_t* ctx, bool is_ok) {
+    if (ctx->is_failed) return;
+    if (!is_ok) {
+        ctx->is_failed = true;
+        return;
+    }
+    ctx->count++;
+}
+
+bool stx_sequence_resume(const sign_transaction_sequence_t* ctx, uint16_t* count) {
+    if (ctx->is_failed) return false;
+    *count = ctx->count;
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <string.h>   // memset
+
+/**
+ * Sequence of the data calls acknowledged in the signing session. It's reported by the
+ * resume subcommand (0x0F), so the client knows where to continue after a transport failure.
+ * Count wraps at 2^16, the client compares it modulo 2^16.
+ */
+typedef struct {
+    uint16_t count;  // number of acknowledged data calls
+    bool is_failed;  // a data call failed, the session can't be resumed
+} sign_transaction_sequence_t;
+
+static inline void stx_sequence_init(sign_transaction_sequence_t* ctx) {
+    memset(ctx, 0, sizeof(sign_transaction_sequence_t));
+}
+
+/**
+ * Record the result of a data call. Calls after a failed one aren't counted.
+ *
+ * @param[in,out] ctx
+ *   Sequence context.
+ * @param[in] is_ok
+ *   Call was processed and the session is still approved.
+ *
+ */
+void stx_sequence_acknowledge(sign_transaction_sequence_t* ctx, bool is_ok);
+
+/**
+ * Get the sequence number to resume the session from.
+ *
+ * @param[in] ctx
+ *   Sequence context.
+ * @param[out] count
+ *   Number of acknowledged data calls.
+ *
+ * @return false if a data call failed.
+ *
+ */
+bool stx_sequence_resume(const sign_transaction_sequence_t* ctx, uint16_t* count);
@@ -45,19 +45,22 @@ typedef struct {
     char text[70];   // dynamic screen text
     uint8_t network_id;
     const sign_transaction_output_info_ctx_t *output;
-    sign_transaction_bip32_path_t *last_approved_change;
 } sign_transaction_ui_output_confirm_ctx_t;
 
 // Show screen callback: (index, title, title_len, text, text_len, cb_context)
-typedef uint16_t (
-    *ui_sign_transaction_operation_show_screen_cb)(uint8_t, char *, size_t, char *, size_t, void *);
+typedef uint16_t (*ui_sign_transaction_operation_show_screen_cb)(uint16_t,
+                                                                 char *,
+                                                                 size_t,
+                                                                 char *,
+                                                                 size_t,
+                                                                 void *);
 // Send response callback (cb_context)
 typedef void (*ui_sign_transaction_operation_send_response_cb)(void *);
 
 typedef struct {
     char title[20];  // dynamic screen title
     char text[70];   // dynamic screen text
-    uint8_t op_screen_count;
+    uint16_t op_screen_count;
     ui_sign_transaction_operation_show_screen_cb op_screen_cb;
     ui_sign_transaction_operation_send_response_cb op_response_cb;
     void *op_cb_context;
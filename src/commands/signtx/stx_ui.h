@@ -4,6 +4,7 @@
 #include <stdbool.h>
 
 #include "../../ui/ui_approve_reject.h"
+#include "../../ui/ui_text_pool.h"
 #include "stx_amounts.h"
 #include "stx_types.h"
 #include "stx_context.h"
@@ -20,34 +21,23 @@ bool ui_stx_add_operation_approve_screens(sign_transaction_ui_aprove_ctx_t* ctx,
                                           bool is_known_application,
                                           sign_transaction_ctx_t* sign_tx);
 
-/**
- * Add output info and accept/reject screens to the UI.
- *
- * @return true if success, false if screens flow is full.
- *
- */
-bool ui_stx_add_output_screens(sign_transaction_ui_output_confirm_ctx_t* ctx,
-                               uint8_t* screen,
-                               uint8_t* output_screen,
-                               const sign_transaction_output_info_ctx_t* output,
-                               sign_transaction_bip32_path_t* last_approved_change,
-                               uint8_t network_id);
-
 /**
  * Add transaction info and accept/reject screens to the UI.
+ * Screens are formatted into text_pool pages when they are displayed.
  *
  * @return true if success, false if screens flow is full.
  *
  */
 bool ui_stx_add_transaction_screens(sign_transaction_ui_sign_confirm_ctx_t* ctx,
                                     uint8_t* screen,
-                                    uint8_t* output_screen,
+                                    uint16_t* output_screen,
                                     const sign_transaction_amounts_ctx_t* amounts,
                                     uint8_t blind_signing_required,
-                                    uint8_t op_screen_count,
+                                    uint16_t op_screen_count,
                                     ui_sign_transaction_operation_show_screen_cb screen_cb,
                                     ui_sign_transaction_operation_send_response_cb response_cb,
-                                    void* cb_context);
+                                    void* cb_context,
+                                    ui_text_pool_t* text_pool);
 
 #ifdef HAVE_BAGL
 /**
@@ -69,86 +69,12 @@ bool ui_stx_add_operation_approve_screens(sign_transaction_ui_aprove_ctx_t* ctx,
 
 // --- OUTPUT APPROVE / REJECT FLOW
 
-static NOINLINE bool ui_stx_operation_output_confirm_action(bool approved, void* context) {
-    sign_transaction_ui_output_confirm_ctx_t* ctx =
-        (sign_transaction_ui_output_confirm_ctx_t*) context;
-    app_set_ui_busy(false);
-
-    explicit_bzero(ctx->last_approved_change, sizeof(sign_transaction_bip32_path_t));
-
-    if (approved) {
-        // store last approved change address
-        if (stx_output_info_type(ctx->output) == SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32) {
-            memmove(ctx->last_approved_change,
-                    &ctx->output->bip32_path,
-                    sizeof(sign_transaction_bip32_path_t));
-        }
-        return true;
-    } else {
-        app_set_current_command(CMD_NONE);
-    }
-
-    ui_menu_main();
-    return false;
-}
-
-uint16_t ui_stx_dynamic_display(uint8_t screen, char* title, char* text) {
-    strncpy(title, pair_mem_title[screen], 20);
-    strncpy(text, pair_mem_text[screen], 70);
-    return SW_OK;
-}
-
-bool ui_stx_add_output_screens(sign_transaction_ui_output_confirm_ctx_t* ctx,
-                               uint8_t* screen,
-                               uint8_t* output_screen,
-                               const sign_transaction_output_info_ctx_t* output,
-                               sign_transaction_bip32_path_t* last_approved_change,
-                               uint8_t network_id) {
-    if (MAX_NUMBER_OF_SCREENS - *screen < 6) return false;
-
-    memset(ctx, 0, sizeof(sign_transaction_ui_output_confirm_ctx_t));
-    memset(last_approved_change, 0, sizeof(sign_transaction_bip32_path_t));
-
-    uint8_t info_screen_count = 1;  // Address screen
-    if (stx_output_info_type(output) != SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32) {
-        uint8_t tokens_count = stx_output_info_used_tokens_count(output);
-        info_screen_count += 1 + (2 * tokens_count);  // value screen + tokens (2 for each)
-    }
+static sign_transaction_ui_sign_confirm_ctx_t* G_ui_stx_dynamic_context;
 
-    ctx->network_id = network_id;
-    ctx->output = output;
-    ctx->last_approved_change = last_approved_change;
-
-    if (!ui_stx_operation_output_confirm_action(true, ctx)) {
-        res_deny();
-        return false;
-    }
-
-    int pair_index = *output_screen;
-
-    for (int i = 0; i < info_screen_count; i++) {
-        ui_stx_display_output_state(i,
-                                    pair_mem_title[pair_index],
-                                    pair_mem_text[pair_index],
-                                    (void*) ctx);
-        pair_index++;
-    }
-
-    *output_screen = pair_index;
-
-    if (MAX_NUMBER_OF_SCREENS - *screen < 2) return false;
-
-    explicit_bzero(ctx->last_approved_change, sizeof(sign_transaction_bip32_path_t));
-
-    // store last approved change address
-    if (stx_output_info_type(ctx->output) == SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32) {
-        memmove(ctx->last_approved_change,
-                &ctx->output->bip32_path,
-                sizeof(sign_transaction_bip32_path_t));
-    }
-    res_ok();
-
-    return true;
+// Formats transaction screen when it's displayed. Dynamic flow keeps formatted screens
+// in the text pool.
+uint16_t ui_stx_dynamic_display(uint16_t screen, char* title, char* text) {
+    return ui_stx_display_tx_state(screen, title, text, (void*) G_ui_stx_dynamic_context);
 }
 
 // --- TX ACCEPT / REJECT FLOW
@@ -159,29 +85,32 @@ static NOINLINE void ui_stx_operation_execute_action(bool approved, void* contex
 
     sign_transaction_ui_sign_confirm_ctx_t* ctx = (sign_transaction_ui_sign_confirm_ctx_t*) context;
     if (approved) {
+        app_trust_connected_app();
         ctx->op_response_cb(ctx->op_cb_context);
     } else {
         res_deny();
     }
 
+    ui_text_pool_detach();
     app_set_current_command(CMD_NONE);
     ui_menu_main();
 }
 
 bool ui_stx_add_transaction_screens(sign_transaction_ui_sign_confirm_ctx_t* ctx,
                                     uint8_t* screen,
-                                    uint8_t* output_screen,
+                                    uint16_t* output_screen,
                                     const sign_transaction_amounts_ctx_t* amounts,
                                     __attribute__((unused)) uint8_t blind_signing_required,
-                                    uint8_t op_screen_count,
+                                    uint16_t op_screen_count,
                                     ui_sign_transaction_operation_show_screen_cb screen_cb,
                                     ui_sign_transaction_operation_send_response_cb response_cb,
-                                    void* cb_context) {
+                                    void* cb_context,
+                                    ui_text_pool_t* text_pool) {
     if (MAX_NUMBER_OF_SCREENS - *screen < 6) return false;
 
     memset(ctx, 0, sizeof(sign_transaction_ui_sign_confirm_ctx_t));
 
-    uint8_t tokens_count = stx_amounts_non_zero_tokens_count(amounts);
+    uint16_t tokens_count = stx_amounts_non_zero_tokens_count(amounts);
 
     ctx->op_screen_count = op_screen_count;
     ctx->op_screen_cb = screen_cb;
@@ -189,20 +118,16 @@ bool ui_stx_add_transaction_screens(sign_transaction_ui_sign_confirm_ctx_t* ctx,
     ctx->op_cb_context = cb_context;
     ctx->amounts = amounts;
 
-    int pairs_count = op_screen_count + 1 + (2 * tokens_count);
-    int pair_index = *output_screen;
+    // Dynamic flow has only transaction screens. They are formatted on display.
+    uint32_t pairs_count = op_screen_count + 1 + (2 * (uint32_t) tokens_count);
+    if (pairs_count >= INDEX16_NOT_EXIST) return false;
 
-    for (int i = 0; i < pairs_count; i++) {
-        ui_stx_display_tx_state(i,
-                                pair_mem_title[pair_index],
-                                pair_mem_text[pair_index],
-                                (void*) ctx);
-
-        pair_index++;
-    }
+    G_ui_stx_dynamic_context = ctx;
+    *output_screen = (uint16_t) pairs_count;
+    ui_text_pool_attach(text_pool);
 
     if (!ui_add_dynamic_flow_screens(screen,
-                                     pair_index,
+                                     (uint16_t) pairs_count,
                                      ctx->title,
                                      ctx->text,
                                      &ui_stx_dynamic_display))
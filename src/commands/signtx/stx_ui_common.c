@@ -7,7 +7,7 @@
 
 #include "../../ergo/address.h"
 
-uint16_t ui_stx_display_output_state(uint8_t screen, char* title, char* text, void* context) {
+uint16_t ui_stx_display_output_state(uint16_t screen, char* title, char* text, void* context) {
     sign_transaction_ui_output_confirm_ctx_t* ctx =
         (sign_transaction_ui_output_confirm_ctx_t*) context;
     uint8_t title_len = MEMBER_SIZE(sign_transaction_ui_output_confirm_ctx_t, title);
@@ -32,8 +32,8 @@ uint16_t ui_stx_display_output_state(uint8_t screen, char* title, char* text, vo
         }
         default: {        // Tokens
             screen -= 2;  // Decrease index for info screens
-            uint8_t token_idx = stx_output_info_used_token_index(ctx->output, screen / 2);
-            if (!IS_ELEMENT_FOUND(token_idx)) {  // error. bad index state
+            uint16_t token_idx = stx_output_info_used_token_index(ctx->output, screen / 2);
+            if (!IS_ELEMENT16_FOUND(token_idx)) {  // error. bad index state
                 return SW_BAD_TOKEN_INDEX;
             }
             if (screen % 2 == 0) {  // Token ID
@@ -54,8 +54,12 @@ uint16_t ui_stx_display_output_state(uint8_t screen, char* title, char* text, vo
     return SW_OK;
 }
 
+_Static_assert(MEMBER_SIZE(sign_transaction_ui_sign_confirm_ctx_t, title) <= UI_TEXT_POOL_TITLE_LEN &&
+                   MEMBER_SIZE(sign_transaction_ui_sign_confirm_ctx_t, text) <= UI_TEXT_POOL_TEXT_LEN,
+               "Transaction screen doesn't fit into the text pool page");
+
 // Callback for TX UI rendering
-uint16_t ui_stx_display_tx_state(uint8_t screen, char* title, char* text, void* context) {
+uint16_t ui_stx_display_tx_state(uint16_t screen, char* title, char* text, void* context) {
     sign_transaction_ui_sign_confirm_ctx_t* ctx = (sign_transaction_ui_sign_confirm_ctx_t*) context;
     uint8_t title_len = MEMBER_SIZE(sign_transaction_ui_sign_confirm_ctx_t, title);
     uint8_t text_len = MEMBER_SIZE(sign_transaction_ui_sign_confirm_ctx_t, text);
@@ -74,8 +78,8 @@ uint16_t ui_stx_display_tx_state(uint8_t screen, char* title, char* text, void*
     } else {
         // Tokens
         screen -= 1;  // Decrease index for info screens
-        uint8_t token_idx = stx_amounts_non_zero_token_index(ctx->amounts, screen / 2);
-        if (!IS_ELEMENT_FOUND(token_idx)) {  // error. bad index state
+        uint16_t token_idx = stx_amounts_non_zero_token_index(ctx->amounts, screen / 2);
+        if (!IS_ELEMENT16_FOUND(token_idx)) {  // error. bad index state
             return SW_BAD_TOKEN_INDEX;
         }
         if (screen % 2 == 0) {  // Token ID
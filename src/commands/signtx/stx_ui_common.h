@@ -3,9 +3,9 @@
 #include <os.h>
 #include <string.h>
 #include <format.h>
-#include <base58.h>
 
 #include "../../ergo/address.h"
+#include "../../common/base58_fast.h"
 
 #include "stx_context.h"
 
@@ -33,7 +33,7 @@ static inline bool format_hex_id(const uint8_t* id, size_t id_len, char* out, si
 }
 
 static inline bool format_b58_id(const uint8_t* id, size_t id_len, char* out, size_t out_len) {
-    int len = base58_encode(id, id_len, out, out_len);
+    int len = base58_fast_encode(id, id_len, out, out_len);
     if (len <= 0) return false;
     return true;
 }
@@ -102,7 +102,14 @@ static inline uint16_t output_info_print_address(const sign_transaction_output_i
     return SW_OK;
 }
 
-uint16_t ui_stx_display_output_state(uint8_t screen, char* title, char* text, void* context);
+// Number of output screens: address, value and tokens (2 for each). Change has address only.
+static inline uint16_t ui_stx_output_screens_count(sign_transaction_output_info_type_e type,
+                                                   uint16_t tokens_count) {
+    if (type == SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32) return 1;
+    return 2 + (2 * tokens_count);
+}
+
+uint16_t ui_stx_display_output_state(uint16_t screen, char* title, char* text, void* context);
 
 // Callback for TX UI rendering
-uint16_t ui_stx_display_tx_state(uint8_t screen, char* title, char* text, void* context);
\ No newline at end of file
+uint16_t ui_stx_display_tx_state(uint16_t screen, char* title, char* text, void* context);
\ No newline at end of file
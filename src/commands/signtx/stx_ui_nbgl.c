@@ -24,6 +24,55 @@
 #include "../../ui/ui_main.h"
 #include "../../ui/display.h"
 
+// NBGL pair list index is 8-bit, longer reviews are streamed in batches of pairs
+#define REVIEW_BATCH_PAIRS UINT8_MAX
+
+// Most pairs on one review page and the pair measured after it to find the end of the page.
+// NBGL keeps pointers to the texts of the displayed page, so their pool pages must not be reused
+// while the page is built: the least recently used page is always one of the previous pages.
+#ifdef NB_MAX_DISPLAYED_PAIRS_IN_REVIEW
+#define REVIEW_PAGE_PAIRS_MAX (NB_MAX_DISPLAYED_PAIRS_IN_REVIEW + 1)
+#else
+#define REVIEW_PAGE_PAIRS_MAX 7
+#endif
+
+_Static_assert(UI_TEXT_POOL_PAGES >= REVIEW_PAGE_PAIRS_MAX,
+               "Text pool can't hold the pairs of one review page, raise UI_TEXT_POOL_PAGES");
+
+typedef struct {
+    sign_transaction_ui_sign_confirm_ctx_t* ctx;
+    uint8_t static_pairs_count;  // pairs in pairs_global before the transaction pairs
+    uint16_t batch_offset;       // review pair index of the first pair of the displayed batch
+    uint16_t error;              // first rendering error
+    nbgl_layoutTagValue_t pairs[UI_TEXT_POOL_PAGES];  // pairs of the text pool pages
+} review_pairs_ctx_t;
+
+static review_pairs_ctx_t G_review_pairs;
+
+// NBGL callback: formats review pair only when its page is displayed
+static nbgl_layoutTagValue_t* review_pair_callback(uint8_t batch_index) {
+    uint16_t index = G_review_pairs.batch_offset + batch_index;
+    if (index < G_review_pairs.static_pairs_count) {
+        return &pairs_global[index];
+    }
+    bool is_cached = false;
+    ui_text_page_t* page = ui_text_pool_page(index, &is_cached);
+    nbgl_layoutTagValue_t* pair = &G_review_pairs.pairs[ui_text_pool_page_position(page)];
+    if (!is_cached) {
+        pair->item = page->title;
+        pair->value = page->text;
+        uint16_t res = ui_stx_display_tx_state(index - G_review_pairs.static_pairs_count,
+                                               page->title,
+                                               page->text,
+                                               (void*) G_review_pairs.ctx);
+        if (res != SW_OK) {
+            ui_text_pool_release(page);
+            if (G_review_pairs.error == SW_OK) G_review_pairs.error = res;
+        }
+    }
+    return pair;
+}
+
 static NOINLINE void ui_stx_operation_approve_action(bool approved) {
     set_flow_response(approved);
 }
@@ -32,6 +81,34 @@ static NOINLINE void quit_callback(void) {
     set_flow_response(true);
 }
 
+// Streamed review of more than REVIEW_BATCH_PAIRS pairs. Returns true if approved.
+static bool review_streamed(uint16_t pairs_count, bool blind_signing, const char* sub_title) {
+    if (blind_signing) {
+        nbgl_useCaseReviewStreamingBlindSigningStart(TYPE_TRANSACTION,
+                                                     &C_app_logo_64px,
+                                                     "Review transaction",
+                                                     sub_title,
+                                                     ui_stx_operation_approve_action);
+    } else {
+        nbgl_useCaseReviewStreamingStart(TYPE_TRANSACTION,
+                                         &C_app_logo_64px,
+                                         "Review transaction",
+                                         sub_title,
+                                         ui_stx_operation_approve_action);
+    }
+    if (!io_ui_process()) return false;
+
+    for (uint16_t offset = 0; offset < pairs_count; offset += REVIEW_BATCH_PAIRS) {
+        G_review_pairs.batch_offset = offset;
+        pair_list.nbPairs = (uint8_t) MIN(pairs_count - offset, REVIEW_BATCH_PAIRS);
+        nbgl_useCaseReviewStreamingContinue(&pair_list, ui_stx_operation_approve_action);
+        if (!io_ui_process()) return false;
+    }
+
+    nbgl_useCaseReviewStreamingFinish("Sign transaction", ui_stx_operation_approve_action);
+    return io_ui_process();
+}
+
 bool ui_stx_add_operation_approve_screens(sign_transaction_ui_aprove_ctx_t* ctx,
                                           uint8_t* screen,
                                           uint32_t app_access_token,
@@ -56,71 +133,19 @@ bool ui_stx_add_operation_approve_screens(sign_transaction_ui_aprove_ctx_t* ctx,
     return true;
 }
 
-bool ui_stx_add_output_screens(sign_transaction_ui_output_confirm_ctx_t* ctx,
-                               uint8_t* screen,
-                               uint8_t* output_screen,
-                               const sign_transaction_output_info_ctx_t* output,
-                               sign_transaction_bip32_path_t* last_approved_change,
-                               uint8_t network_id) {
-    if (MAX_NUMBER_OF_SCREENS - *screen < 6) return false;
-
-    memset(ctx, 0, sizeof(sign_transaction_ui_output_confirm_ctx_t));
-    memset(last_approved_change, 0, sizeof(sign_transaction_bip32_path_t));
-
-    uint8_t info_screen_count = 1;  // Address screen
-    if (stx_output_info_type(output) != SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32) {
-        uint8_t tokens_count = stx_output_info_used_tokens_count(output);
-        info_screen_count += 1 + (2 * tokens_count);  // value screen + tokens (2 for each)
-    }
-
-    if (MAX_NUMBER_OF_SCREENS - *screen < 2) return false;
-
-    ctx->network_id = network_id;
-    ctx->output = output;
-    ctx->last_approved_change = last_approved_change;
-
-    int pair_index = pair_list.nbPairs;
-
-    for (int i = 0; i < info_screen_count; i++) {
-        pairs_global[pair_index].item = pair_mem_title[pair_index];
-        pairs_global[pair_index].value = pair_mem_text[pair_index];
-
-        ui_stx_display_output_state(i,
-                                    pair_mem_title[pair_index],
-                                    pair_mem_text[pair_index],
-                                    (void*) ctx);
-        pair_index++;
-    }
-
-    *output_screen = pair_index;
-
-    pair_list.nbPairs += info_screen_count;
-
-    explicit_bzero(ctx->last_approved_change, sizeof(sign_transaction_bip32_path_t));
-
-    // store last approved change address
-    if (stx_output_info_type(ctx->output) == SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32) {
-        memmove(ctx->last_approved_change,
-                &ctx->output->bip32_path,
-                sizeof(sign_transaction_bip32_path_t));
-    }
-    res_ok();
-
-    return true;
-}
-
 /**
  * Adds transaction confirmation screens to the UI.
  */
 bool ui_stx_add_transaction_screens(sign_transaction_ui_sign_confirm_ctx_t* ctx,
                                     uint8_t* screen,
-                                    uint8_t* output_screen,
+                                    uint16_t* output_screen,
                                     const sign_transaction_amounts_ctx_t* amounts,
                                     uint8_t blind_signing_required,
-                                    uint8_t op_screen_count,
+                                    uint16_t op_screen_count,
                                     ui_sign_transaction_operation_show_screen_cb screen_cb,
                                     ui_sign_transaction_operation_send_response_cb response_cb,
-                                    void* cb_context) {
+                                    void* cb_context,
+                                    ui_text_pool_t* text_pool) {
     // check if there is enough space for the screens
     if (MAX_NUMBER_OF_SCREENS - *screen < 6) return false;
 
@@ -159,7 +184,7 @@ bool ui_stx_add_transaction_screens(sign_transaction_ui_sign_confirm_ctx_t* ctx,
         }
     }
 
-    uint8_t tokens_count = stx_amounts_non_zero_tokens_count(amounts);
+    uint16_t tokens_count = stx_amounts_non_zero_tokens_count(amounts);
 
     // setup the context
     ctx->op_screen_count = op_screen_count;
@@ -168,28 +193,29 @@ bool ui_stx_add_transaction_screens(sign_transaction_ui_sign_confirm_ctx_t* ctx,
     ctx->op_cb_context = cb_context;
     ctx->amounts = amounts;
 
-    int pairs_count = op_screen_count + 1 + (2 * tokens_count);
-    int pair_index = pair_list.nbPairs;
-
-    for (int i = 0; i < pairs_count; i++) {
-        pairs_global[pair_index].item = pair_mem_title[pair_index];
-        pairs_global[pair_index].value = pair_mem_text[pair_index];
+    // Pairs are formatted by the callback when their page is displayed
+    uint32_t pairs_count = pair_list.nbPairs + op_screen_count + 1 + (2 * (uint32_t) tokens_count);
+    if (pairs_count >= INDEX16_NOT_EXIST) return false;
 
-        ui_stx_display_tx_state(i,
-                                pair_mem_title[pair_index],
-                                pair_mem_text[pair_index],
-                                (void*) ctx);
-
-        pair_index++;
-    }
+    memset(&G_review_pairs, 0, sizeof(G_review_pairs));
+    ui_text_pool_attach(text_pool);
+    G_review_pairs.ctx = ctx;
+    G_review_pairs.static_pairs_count = pair_list.nbPairs;
+    G_review_pairs.error = SW_OK;
 
-    *output_screen = pair_index;
+    *output_screen = (uint16_t) pairs_count;
 
     pair_list.nbMaxLinesForValue = 0;
-    pair_list.pairs = pairs_global;
-    pair_list.nbPairs = pair_index;
+    pair_list.pairs = NULL;
+    pair_list.callback = review_pair_callback;
     pair_list.startIndex = 0;
-    if (blind_signing_required) {
+    bool approved = false;
+    if (pairs_count > REVIEW_BATCH_PAIRS) {
+        approved = review_streamed((uint16_t) pairs_count,
+                                   blind_signing_required,
+                                   base_ctx->ui_approve.bip32_path);
+    } else if (blind_signing_required) {
+        pair_list.nbPairs = (uint8_t) pairs_count;
         nbgl_useCaseReviewBlindSigning(TYPE_TRANSACTION,
                                        &pair_list,
                                        &C_app_logo_64px,
@@ -198,7 +224,9 @@ bool ui_stx_add_transaction_screens(sign_transaction_ui_sign_confirm_ctx_t* ctx,
                                        "Sign transaction",
                                        NULL,
                                        ui_stx_operation_approve_action);
+        approved = io_ui_process();
     } else {
+        pair_list.nbPairs = (uint8_t) pairs_count;
         nbgl_useCaseReview(TYPE_TRANSACTION,
                            &pair_list,
                            &C_app_logo_64px,
@@ -206,10 +234,17 @@ bool ui_stx_add_transaction_screens(sign_transaction_ui_sign_confirm_ctx_t* ctx,
                            base_ctx->ui_approve.bip32_path,
                            "Sign transaction",
                            ui_stx_operation_approve_action);
+        approved = io_ui_process();
     }
-    bool approved = io_ui_process();
+    ui_text_pool_detach();
 
-    if (approved) {
+    if (approved && G_review_pairs.error != SW_OK) {
+        // Transaction can't be signed if some of the reviewed data wasn't displayed
+        res_error(G_review_pairs.error);
+        app_set_current_command(CMD_NONE);
+        nbgl_useCaseReviewStatus(STATUS_TYPE_TRANSACTION_REJECTED, quit_callback);
+    } else if (approved) {
+        app_trust_connected_app();
         ctx->op_response_cb(ctx->op_cb_context);
         app_set_current_command(CMD_NONE);
         nbgl_useCaseReviewStatus(STATUS_TYPE_TRANSACTION_SIGNED, quit_callback);
@@ -0,0 +1,156 @@
+#include <string.h>  // memset
+
+#include "base58_fast.h"
+
+// Digits processed in one pass, 58^5 is the largest power of 58 fitting 32 bits
+#define BASE58_LIMB_DIGITS 5
+// Number of 32-bit limbs for the maximum encoder and decoder inputs
+#define BASE58_ENC_LIMBS_COUNT ((BASE58_FAST_MAX_ENC_INPUT_SIZE + 3) / 4)
+#define BASE58_DEC_LIMBS_COUNT ((BASE58_FAST_MAX_DEC_INPUT_SIZE * 733 / 1000) / 4 + 1)
+
+static const uint32_t BASE58_POWERS[BASE58_LIMB_DIGITS + 1] =
+    {1, 58, 3364, 195112, 11316496, 656356768};
+
+static const char BASE58_DIGITS[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+static inline uint8_t base58_digit_value(char c) {
+    if (c >= '1' && c <= '9') return c - '1';
+    if (c >= 'A' && c <= 'H') return c - 'A' + 9;
+    if (c >= 'J' && c <= 'N') return c - 'J' + 17;
+    if (c >= 'P' && c <= 'Z') return c - 'P' + 22;
+    if (c >= 'a' && c <= 'k') return c - 'a' + 33;
+    if (c >= 'm' && c <= 'z') return c - 'm' + 44;
+    return 0xFF;
+}
+
+int base58_fast_encode(const uint8_t *in, size_t in_len, char *out, size_t out_len) {
+    uint32_t limbs[BASE58_ENC_LIMBS_COUNT];
+    uint8_t digits[BASE58_FAST_MAX_ENC_INPUT_SIZE * 138 / 100 + BASE58_LIMB_DIGITS];
+
+    if (in_len > BASE58_FAST_MAX_ENC_INPUT_SIZE) {
+        return -1;
+    }
+
+    size_t zero_count = 0;
+    while (zero_count < in_len && in[zero_count] == 0) {
+        ++zero_count;
+    }
+
+    // Big-endian limbs, the most significant one can be partial
+    size_t bytes_count = in_len - zero_count;
+    size_t limbs_count = (bytes_count + 3) / 4;
+    size_t limb_bytes = bytes_count % 4 == 0 ? 4 : bytes_count % 4;
+    const uint8_t *ptr = in + zero_count;
+    for (size_t i = 0; i < limbs_count; i++) {
+        uint32_t limb = 0;
+        for (size_t j = 0; j < limb_bytes; j++) {
+            limb = (limb << 8) | *ptr++;
+        }
+        limbs[i] = limb;
+        limb_bytes = 4;
+    }
+
+    // Every pass divides the number by 58^5, digits are collected from the least significant
+    size_t digits_count = 0;
+    size_t start_at = 0;
+    while (start_at < limbs_count) {
+        uint32_t remainder = 0;
+        for (size_t i = start_at; i < limbs_count; i++) {
+            uint64_t acc = ((uint64_t) remainder << 32) | limbs[i];
+            limbs[i] = (uint32_t) (acc / BASE58_POWERS[BASE58_LIMB_DIGITS]);
+            remainder = (uint32_t) (acc % BASE58_POWERS[BASE58_LIMB_DIGITS]);
+        }
+        while (start_at < limbs_count && limbs[start_at] == 0) {
+            ++start_at;
+        }
+        for (size_t j = 0; j < BASE58_LIMB_DIGITS; j++) {
+            digits[digits_count++] = remainder % 58;
+            remainder /= 58;
+        }
+    }
+
+    // The last pass can produce leading zero digits
+    while (digits_count > 0 && digits[digits_count - 1] == 0) {
+        --digits_count;
+    }
+
+    if (out_len < zero_count + digits_count) {
+        return -1;
+    }
+
+    memset(out, BASE58_DIGITS[0], zero_count);
+    for (size_t i = 0; i < digits_count; i++) {
+        out[zero_count + i] = BASE58_DIGITS[digits[digits_count - 1 - i]];
+    }
+
+    return (int) (zero_count + digits_count);
+}
+
+int base58_fast_decode(const char *in, size_t in_len, uint8_t *out, size_t out_len) {
+    // Little-endian limbs
+    uint32_t limbs[BASE58_DEC_LIMBS_COUNT];
+    size_t limbs_count = 0;
+
+    if (in_len > BASE58_FAST_MAX_DEC_INPUT_SIZE) {
+        return -1;
+    }
+
+    size_t zero_count = 0;
+    while (zero_count < in_len && in[zero_count] == BASE58_DIGITS[0]) {
+        ++zero_count;
+    }
+
+    // Groups of five digits, the most significant one can be partial
+    size_t digits_left = in_len - zero_count;
+    size_t group_len = digits_left % BASE58_LIMB_DIGITS == 0 ? BASE58_LIMB_DIGITS
+                                                             : digits_left % BASE58_LIMB_DIGITS;
+    const char *ptr = in + zero_count;
+    while (digits_left > 0) {
+        uint32_t group = 0;
+        for (size_t j = 0; j < group_len; j++) {
+            uint8_t digit = base58_digit_value(*ptr++);
+            if (digit == 0xFF) {
+                return -1;
+            }
+            group = group * 58 + digit;
+        }
+
+        uint64_t carry = group;
+        for (size_t i = 0; i < limbs_count; i++) {
+            uint64_t acc = (uint64_t) limbs[i] * BASE58_POWERS[group_len] + carry;
+            limbs[i] = (uint32_t) acc;
+            carry = acc >> 32;
+        }
+        if (carry != 0) {
+            if (limbs_count == BASE58_DEC_LIMBS_COUNT) {
+                return -1;
+            }
+            limbs[limbs_count++] = (uint32_t) carry;
+        }
+
+        digits_left -= group_len;
+        group_len = BASE58_LIMB_DIGITS;
+    }
+
+    // Skip leading zero bytes of the most significant limb
+    size_t bytes_count = limbs_count * 4;
+    if (limbs_count > 0) {
+        uint32_t top = limbs[limbs_count - 1];
+        while ((top & 0xFF000000) == 0) {
+            top <<= 8;
+            --bytes_count;
+        }
+    }
+
+    if (out_len < zero_count + bytes_count) {
+        return -1;
+    }
+
+    memset(out, 0, zero_count);
+    uint8_t *dst = out + zero_count + bytes_count;
+    for (size_t i = 0; i < bytes_count; i++) {
+        *--dst = (uint8_t) (limbs[i / 4] >> (8 * (i % 4)));
+    }
+
+    return (int) (zero_count + bytes_count);
+}
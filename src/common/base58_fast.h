@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint*_t
+
+/**
+ * Maximum length of input when encoding in base 58.
+ */
+#define BASE58_FAST_MAX_ENC_INPUT_SIZE 120
+/**
+ * Maximum length of input when decoding in base 58.
+ */
+#define BASE58_FAST_MAX_DEC_INPUT_SIZE 164
+
+/**
+ * Encode input bytes in base 58.
+ * Works on 32-bit limbs: every pass divides the number by 58^5 and emits five digits,
+ * instead of one digit per pass over single bytes.
+ * Output isn't null-terminated.
+ *
+ * @param[in]  in
+ *   Pointer to input byte buffer.
+ * @param[in]  in_len
+ *   Length of the input byte buffer.
+ * @param[out] out
+ *   Pointer to output string buffer.
+ * @param[in]  out_len
+ *   Maximum length to write in output string buffer.
+ *
+ * @return number of characters encoded, -1 otherwise.
+ *
+ */
+int base58_fast_encode(const uint8_t *in, size_t in_len, char *out, size_t out_len);
+
+/**
+ * Decode input string in base 58.
+ * Consumes five digits per pass, multiplying 32-bit limbs by precomputed 58^k.
+ *
+ * @param[in]  in
+ *   Pointer to input string buffer.
+ * @param[in]  in_len
+ *   Length of the input string buffer.
+ * @param[out] out
+ *   Pointer to output byte buffer.
+ * @param[in]  out_len
+ *   Maximum length to write in output byte buffer.
+ *
+ * @return number of bytes decoded, -1 otherwise.
+ *
+ */
+int base58_fast_decode(const char *in, size_t in_len, uint8_t *out, size_t out_len);
@@ -11,4 +11,10 @@
  * Macros for checking indexes
  */
 #define INDEX_NOT_EXIST         ((uint8_t) 0xFF)
-#define IS_ELEMENT_FOUND(index) ((uint8_t) (index) != INDEX_NOT_EXIST)
\ No newline at end of file
+#define IS_ELEMENT_FOUND(index) ((uint8_t) (index) != INDEX_NOT_EXIST)
+
+/**
+ * Macros for checking 16-bit indexes (token table)
+ */
+#define INDEX16_NOT_EXIST         ((uint16_t) 0xFFFF)
+#define IS_ELEMENT16_FOUND(index) ((uint16_t) (index) != INDEX16_NOT_EXIST)
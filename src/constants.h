@@ -36,9 +36,18 @@
 #define ERGO_ID_LEN 32
 
 /**
- * Maximum number of tokens in TX.
+ * Maximum number of distinct tokens in TX.
+ * Token indexes are 16-bit wide, so this can't exceed 0xFFFE.
+ * Can be overridden in the Makefile.
  */
-#define TOKEN_MAX_COUNT 100
+#ifndef TOKEN_MAX_COUNT
+#define TOKEN_MAX_COUNT 255
+#endif
+
+/**
+ * Maximum number of tokens in a single box (Ergo protocol limit).
+ */
+#define BOX_TOKEN_MAX_COUNT 122
 
 /**
  * Length of Session Key.
@@ -82,13 +91,19 @@
 
 /**
  * Max number of screens
+ * Can be overridden in the Makefile. Should be in 8..254.
  */
+#ifndef MAX_NUMBER_OF_SCREENS
 #define MAX_NUMBER_OF_SCREENS 16
+#endif
 
 /**
  * Max length of TX data part
+ * Can be overridden in the Makefile.
  */
+#ifndef MAX_TX_DATA_PART_LEN
 #define MAX_TX_DATA_PART_LEN 32768
+#endif
 
 /**
  * Max length of TX data chunk
@@ -98,4 +113,85 @@
 /**
  * Max length of BIP32 path string
  */
-#define MAX_BIP32_STRING_LEN 60
\ No newline at end of file
+#define MAX_BIP32_STRING_LEN 60
+
+/**
+ * Number of address indexes on the signing account chain which are
+ * recognized as own addresses in transaction outputs.
+ * Can be overridden in the Makefile. Can't exceed 255.
+ */
+#ifndef OWN_ADDRESSES_WINDOW
+#define OWN_ADDRESSES_WINDOW 20
+#endif
+
+/**
+ * Maximum number of change paths registered in the signing session.
+ * Can be overridden in the Makefile. Can't exceed 255.
+ */
+#ifndef CHANGE_PATHS_MAX_COUNT
+#define CHANGE_PATHS_MAX_COUNT 4
+#endif
+
+/**
+ * Minimum number of destinations in the transaction review log.
+ * The review had 2 * 100 + 10 screen pairs before the log, 2 pairs per destination.
+ */
+#define REVIEW_MIN_OUTPUTS 105
+
+/**
+ * Maximum number of destinations in the transaction review log.
+ * Can be overridden in the Makefile. Should be in REVIEW_MIN_OUTPUTS..255.
+ */
+#ifndef REVIEW_MAX_OUTPUTS
+#define REVIEW_MAX_OUTPUTS REVIEW_MIN_OUTPUTS
+#endif
+
+/**
+ * Maximum number of output tokens in the transaction review log.
+ * Every token of the transaction fits, so it can't be less than TOKEN_MAX_COUNT.
+ * Can be overridden in the Makefile.
+ */
+#ifndef REVIEW_MAX_TOKENS
+#define REVIEW_MAX_TOKENS TOKEN_MAX_COUNT
+#endif
+
+/**
+ * Number of approved application tokens remembered in NVM.
+ * Can be overridden in the Makefile. Can't exceed 255.
+ */
+#ifndef TRUSTED_APPS_MAX_COUNT
+#define TRUSTED_APPS_MAX_COUNT 8
+#endif
+
+/**
+ * Maximum number of accounts in the extended public key range export.
+ * Can be overridden in the Makefile. Can't exceed 255.
+ */
+#ifndef EXT_PUB_KEY_RANGE_MAX_COUNT
+#define EXT_PUB_KEY_RANGE_MAX_COUNT 20
+#endif
+
+/**
+ * Number of text pages in the review text pool.
+ * On NBGL it should hold all the pairs of one review page.
+ * Can be overridden in the Makefile. Can't exceed 255.
+ */
+#ifndef UI_TEXT_POOL_PAGES
+#define UI_TEXT_POOL_PAGES 8
+#endif
+
+/**
+ * RAM budget of the review text pool in bytes.
+ * Can be overridden in the Makefile.
+ */
+#ifndef UI_TEXT_POOL_RAM_BUDGET
+#define UI_TEXT_POOL_RAM_BUDGET 768
+#endif
+
+/**
+ * RAM budget of the application context (commands data) in bytes.
+ * Can be overridden in the Makefile, set per device model there.
+ */
+#ifndef APP_CONTEXT_RAM_BUDGET
+#define APP_CONTEXT_RAM_BUDGET 20480
+#endif
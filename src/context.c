@@ -4,6 +4,8 @@
 
 #include "context.h"
 #include "./common/macros_ext.h"
+#include "./helpers/session_id.h"
+#include "./helpers/trusted_apps.h"
 
 // Saved here to store it outside of the stack
 app_ctx_t G_app_context;
@@ -26,4 +28,23 @@ void app_set_current_command(command_e current_command) {
     explicit_bzero(&G_app_context.commands_ctx, MEMBER_SIZE(app_ctx_t, commands_ctx));
     app_set_ui_busy(false);
     G_app_context.current_command = current_command;
-}
\ No newline at end of file
+}
+
+void app_set_connected_app_id(uint32_t id) {
+    G_app_context.connected_app_id = id;
+}
+
+void app_trust_connected_app(void) {
+    trusted_apps_add(G_app_context.connected_app_id);
+}
+
+bool app_is_known_application(uint32_t app_id) {
+    return is_known_application(G_app_context.connected_app_id, app_id) ||
+           trusted_apps_contains(app_id);
+}
+
+void app_prepare_schnorr_nonce(void) {
+    if (!G_app_context.schnorr_nonce.is_ready) {
+        ergo_secp256k1_schnorr_nonce_generate(&G_app_context.schnorr_nonce);
+    }
+}
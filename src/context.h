@@ -1,6 +1,9 @@
 #pragma once
 
+#include "constants.h"
+#include "storage.h"
 #include "apdu_dispatcher.h"
+#include "ergo/schnorr.h"
 #include "commands/extpubkey/epk_context.h"
 #include "commands/deriveaddress/da_context.h"
 #include "commands/attestinput/ainpt_context.h"
@@ -12,6 +15,7 @@
 typedef struct {
     uint32_t connected_app_id;
     uint8_t session_key[SESSION_KEY_LEN];
+    ergo_schnorr_nonce_t schnorr_nonce;  /// precomputed nonce for the next signature
     command_e current_command;  /// current command
     bool is_ui_busy;
     union {
@@ -22,22 +26,14 @@ typedef struct {
     } commands_ctx;
 } app_ctx_t;
 
+_Static_assert(sizeof(app_ctx_t) <= APP_CONTEXT_RAM_BUDGET,
+               "Application context exceeds APP_CONTEXT_RAM_BUDGET, lower the device limits");
+
 /**
  * Global application context
  */
 extern app_ctx_t G_app_context;
 
-/**
- * Global structure for NVM data storage.
- */
-typedef struct internal_storage_t {
-    uint8_t blind_signing_enabled;
-    uint8_t initialized;
-} internal_storage_t;
-
-extern const internal_storage_t N_storage_real;
-#define N_storage (*(volatile internal_storage_t*) PIC(&N_storage_real))
-
 /**
  * Check is ui busy
  */
@@ -62,9 +58,18 @@ static inline uint32_t app_connected_app_id(void) {
 /**
  * Set connected application id.
  */
-static inline void app_set_connected_app_id(uint32_t id) {
-    G_app_context.connected_app_id = id;
-}
+void app_set_connected_app_id(uint32_t id);
+
+/**
+ * Remember connected application in the trusted applications registry if it's enabled.
+ * Should be called only from the explicit user approval of the operation.
+ */
+void app_trust_connected_app(void);
+
+/**
+ * Check that application is approved in this session or trusted in the registry.
+ */
+bool app_is_known_application(uint32_t app_id);
 
 /**
  * Get session key.
@@ -73,6 +78,19 @@ static inline const uint8_t* app_session_key(void) {
     return G_app_context.session_key;
 }
 
+/**
+ * Get precomputed Schnorr nonce for the next signature.
+ */
+static inline ergo_schnorr_nonce_t* app_schnorr_nonce(void) {
+    return &G_app_context.schnorr_nonce;
+}
+
+/**
+ * Precompute Schnorr nonce for the next signature if it's not ready yet.
+ * Should be called when the app is idle, i.e. after an asynchronous response is sent.
+ */
+void app_prepare_schnorr_nonce(void);
+
 /**
  * Get current command key.
  */
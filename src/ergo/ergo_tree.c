@@ -45,6 +45,12 @@ void ergo_tree_generate_p2pk(const uint8_t raw_public_key[static PUBLIC_KEY_LEN]
     rw_buffer_write_bytes(&out, raw_public_key + 1, 32);
 }
 
+void ergo_tree_generate_p2pk_compressed(const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN],
+                                        uint8_t tree[ERGO_TREE_P2PK_LEN]) {
+    memmove(tree, PIC(C_ERGO_TREE_P2PK_PREFIX), ERGO_TREE_P2PK_PREFIX_LEN);
+    memmove(tree + ERGO_TREE_P2PK_PREFIX_LEN, public_key, COMPRESSED_PUBLIC_KEY_LEN);
+}
+
 bool ergo_tree_parse_p2pk(const uint8_t tree[ERGO_TREE_P2PK_LEN],
                           uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
     if (memcmp(tree, PIC(C_ERGO_TREE_P2PK_PREFIX), ERGO_TREE_P2PK_PREFIX_LEN) != 0) {
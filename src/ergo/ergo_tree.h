@@ -16,6 +16,9 @@
 void ergo_tree_generate_p2pk(const uint8_t raw_public_key[static PUBLIC_KEY_LEN],
                              uint8_t tree[ERGO_TREE_P2PK_LEN]);
 
+void ergo_tree_generate_p2pk_compressed(const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN],
+                                        uint8_t tree[ERGO_TREE_P2PK_LEN]);
+
 bool ergo_tree_parse_p2pk(const uint8_t tree[ERGO_TREE_P2PK_LEN],
                           uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]);
 
@@ -25,68 +25,88 @@ static uint8_t const P2PK_PREFIX[] = {0x01, 0x00, 0x27, 0x10, 0x01, 0x08, 0xcd};
 
 static uint8_t const P2PK_SUFFIX[] = {0x73, 0x00, 0x00, 0x21};
 
-bool ergo_secp256k1_schnorr_p2pk_sign_init(cx_blake2b_t* hash,
-                                           uint8_t key[static PRIVATE_KEY_LEN],
-                                           const uint8_t secret[static PRIVATE_KEY_LEN]) {
+// Compressed point G * scalar
+static bool secp256k1_mult_g_compressed(uint8_t out[static COMPRESSED_PUBLIC_KEY_LEN],
+                                        const uint8_t scalar[static PRIVATE_KEY_LEN]) {
     uint8_t buf[PUBLIC_KEY_LEN];
+    buf[0] = 0x04;
+    memcpy(buf + 1, PIC(SECP256K1_G), sizeof(SECP256K1_G));
+    bool result =
+        cx_ecfp_scalar_mult_no_throw(CX_CURVE_SECP256K1, buf, scalar, PRIVATE_KEY_LEN) == 0;
+    if (result) {
+        // compress
+        buf[0] = (buf[PUBLIC_KEY_LEN - 1] & 1) == 1 ? 0x03 : 0x02;
+        memcpy(out, buf, COMPRESSED_PUBLIC_KEY_LEN);
+    }
+    explicit_bzero(buf, sizeof(buf));
+    return result;
+}
+
+bool ergo_secp256k1_schnorr_nonce_generate(ergo_schnorr_nonce_t* nonce) {
     for (uint8_t i = 0; i < MAX_ITERATIONS; i++) {
-        bool result = false;
-        do {
-            if (!blake2b_256_init(hash)) break;
-            // compute commitment prefix P(c) = H(prefix || pk || postfix || w)
-            // adds preifx
-            if (!blake2b_update(hash, PIC(P2PK_PREFIX), sizeof(P2PK_PREFIX))) break;
-
-            int cmp_diff;
-            // check private key has a proper value
-            if (cx_math_is_zero(secret, PRIVATE_KEY_LEN)) break;
-            if (cx_math_cmp_no_throw(secret, PIC(SECP256K1_N), PRIVATE_KEY_LEN, &cmp_diff) != 0 ||
-                cmp_diff >= 0)
-                break;
-
-            // pk = G * secret (pub key)
-            buf[0] = 0x04;
-            memcpy(buf + 1, PIC(SECP256K1_G), sizeof(SECP256K1_G));
-            if (cx_ecfp_scalar_mult_no_throw(CX_CURVE_SECP256K1, buf, secret, PRIVATE_KEY_LEN) != 0)
-                break;
-            // compress pk
-            buf[0] = (buf[PUBLIC_KEY_LEN - 1] & 1) == 1 ? 0x03 : 0x02;
-
-            // compute commitment prefix P(c) = H(prefix || pk || postfix || w)
-            // add pk and postfix
-            if (!blake2b_update(hash, buf, COMPRESSED_PUBLIC_KEY_LEN)) break;
-            if (!blake2b_update(hash, PIC(P2PK_SUFFIX), sizeof(P2PK_SUFFIX))) break;
-
-            // generate ephemeral private key
-            cx_rng_no_throw(key, PRIVATE_KEY_LEN);
-
-            // check it has a proper value
-            if (cx_math_is_zero(key, PRIVATE_KEY_LEN)) break;
-            if (cx_math_cmp_no_throw(key, PIC(SECP256K1_N), PRIVATE_KEY_LEN, &cmp_diff) != 0 ||
-                cmp_diff > 0)
-                break;
-
-            // w = G * y (pub key)
-            buf[0] = 0x04;
-            memcpy(buf + 1, PIC(SECP256K1_G), sizeof(SECP256K1_G));
-            if (cx_ecfp_scalar_mult_no_throw(CX_CURVE_SECP256K1, buf, key, PRIVATE_KEY_LEN) != 0)
-                break;
-            // compress w
-            buf[0] = (buf[PUBLIC_KEY_LEN - 1] & 1) == 1 ? 0x03 : 0x02;
-
-            // compute commitment prefix P(c) = H(prefix || pk || postfix || w)
-            // add w
-            if (!blake2b_update(hash, buf, COMPRESSED_PUBLIC_KEY_LEN)) break;
-            result = true;
-        } while (0);
-
-        explicit_bzero(buf, sizeof(buf));
-
-        if (result) return result;
+        int cmp_diff;
+        // generate ephemeral private key
+        cx_rng_no_throw(nonce->key, PRIVATE_KEY_LEN);
+
+        // check it has a proper value
+        if (cx_math_is_zero(nonce->key, PRIVATE_KEY_LEN)) continue;
+        if (cx_math_cmp_no_throw(nonce->key, PIC(SECP256K1_N), PRIVATE_KEY_LEN, &cmp_diff) != 0 ||
+            cmp_diff > 0)
+            continue;
+
+        // w = G * y (pub key)
+        if (!secp256k1_mult_g_compressed(nonce->commitment, nonce->key)) continue;
+
+        nonce->is_ready = true;
+        return true;
     }
+    explicit_bzero(nonce, sizeof(ergo_schnorr_nonce_t));
     return false;
 }
 
+bool ergo_secp256k1_schnorr_p2pk_sign_init(cx_blake2b_t* hash,
+                                           uint8_t key[static PRIVATE_KEY_LEN],
+                                           const uint8_t secret[static PRIVATE_KEY_LEN],
+                                           ergo_schnorr_nonce_t* nonce) {
+    uint8_t pk[COMPRESSED_PUBLIC_KEY_LEN];
+    bool result = false;
+    do {
+        if (!nonce->is_ready) break;
+
+        if (!blake2b_256_init(hash)) break;
+        // compute commitment prefix P(c) = H(prefix || pk || postfix || w)
+        // adds preifx
+        if (!blake2b_update(hash, PIC(P2PK_PREFIX), sizeof(P2PK_PREFIX))) break;
+
+        int cmp_diff;
+        // check private key has a proper value
+        if (cx_math_is_zero(secret, PRIVATE_KEY_LEN)) break;
+        if (cx_math_cmp_no_throw(secret, PIC(SECP256K1_N), PRIVATE_KEY_LEN, &cmp_diff) != 0 ||
+            cmp_diff >= 0)
+            break;
+
+        // pk = G * secret (pub key)
+        if (!secp256k1_mult_g_compressed(pk, secret)) break;
+
+        // compute commitment prefix P(c) = H(prefix || pk || postfix || w)
+        // add pk and postfix
+        if (!blake2b_update(hash, pk, COMPRESSED_PUBLIC_KEY_LEN)) break;
+        if (!blake2b_update(hash, PIC(P2PK_SUFFIX), sizeof(P2PK_SUFFIX))) break;
+
+        // compute commitment prefix P(c) = H(prefix || pk || postfix || w)
+        // add precomputed w
+        if (!blake2b_update(hash, nonce->commitment, COMPRESSED_PUBLIC_KEY_LEN)) break;
+        memcpy(key, nonce->key, PRIVATE_KEY_LEN);
+        result = true;
+    } while (0);
+
+    // nonce is never used twice
+    explicit_bzero(nonce, sizeof(ergo_schnorr_nonce_t));
+    explicit_bzero(pk, sizeof(pk));
+
+    return result;
+}
+
 bool ergo_secp256k1_schnorr_p2pk_sign_finish(uint8_t signature[static ERGO_SIGNATURE_LEN],
                                              cx_blake2b_t* hash,
                                              const uint8_t secret[static PRIVATE_KEY_LEN],
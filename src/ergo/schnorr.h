@@ -4,9 +4,28 @@
 #include "../constants.h"
 #include "../helpers/blake2b.h"
 
+/**
+ * Ephemeral Schnorr key and its commitment. Kept in RAM only and used for a single signature.
+ */
+typedef struct {
+    uint8_t key[PRIVATE_KEY_LEN];                   // ephemeral private key y
+    uint8_t commitment[COMPRESSED_PUBLIC_KEY_LEN];  // w = G * y, compressed
+    bool is_ready;
+} ergo_schnorr_nonce_t;
+
+/**
+ * Generate ephemeral key and its commitment for the next signature.
+ * Nonce is zeroized on failure.
+ */
+bool ergo_secp256k1_schnorr_nonce_generate(ergo_schnorr_nonce_t* nonce);
+
+/**
+ * Start signing with the ready nonce. Nonce is zeroized in any case.
+ */
 bool ergo_secp256k1_schnorr_p2pk_sign_init(cx_blake2b_t* hash,
                                            uint8_t key[static PRIVATE_KEY_LEN],
-                                           const uint8_t secret[static PRIVATE_KEY_LEN]);
+                                           const uint8_t secret[static PRIVATE_KEY_LEN],
+                                           ergo_schnorr_nonce_t* nonce);
 
 bool ergo_secp256k1_schnorr_p2pk_sign_finish(uint8_t signature[static ERGO_SIGNATURE_LEN],
                                              cx_blake2b_t* hash,
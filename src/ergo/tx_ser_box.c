@@ -93,7 +93,7 @@ ergo_tx_serializer_box_result_e ergo_tx_serializer_box_init(
     cx_blake2b_t* hash) {
     memset(context, 0, sizeof(ergo_tx_serializer_box_context_t));
 
-    if (tokens_count > TOKEN_MAX_COUNT) {
+    if (tokens_count > BOX_TOKEN_MAX_COUNT) {
         return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_TOO_MANY_TOKENS);
     }
 
@@ -166,11 +166,11 @@ ergo_tx_serializer_box_result_e ergo_tx_serializer_box_add_miners_fee_tree(
 
 ergo_tx_serializer_box_result_e ergo_tx_serializer_box_add_change_tree(
     ergo_tx_serializer_box_context_t* context,
-    const uint8_t raw_public_key[static PUBLIC_KEY_LEN]) {
+    const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
     CHECK_PROPER_STATE(context, ERGO_TX_SERIALIZER_BOX_STATE_INITIALIZED);
 
     uint8_t tree[ERGO_TREE_P2PK_LEN];
-    ergo_tree_generate_p2pk(raw_public_key, tree);
+    ergo_tree_generate_p2pk_compressed(public_key, tree);
     if (!blake2b_update(context->hash, tree, ERGO_TREE_P2PK_LEN)) {
         return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_HASHER);
     }
@@ -178,75 +178,129 @@ ergo_tx_serializer_box_result_e ergo_tx_serializer_box_add_change_tree(
     return ergo_tree_added(context);
 }
 
-ergo_tx_serializer_box_result_e ergo_tx_serializer_box_add_tokens(
-    ergo_tx_serializer_box_context_t* context,
-    buffer_t* input,
-    const ergo_tx_serializer_table_context_t* table) {
-    CHECK_PROPER_STATE(context, ERGO_TX_SERIALIZER_BOX_STATE_TREE_ADDED);
-    RW_BUFFER_NEW_LOCAL_EMPTY(buffer, 10);
+// Token pairs are decoded, VLQ-encoded and hashed by batches: one hash update per batch.
+// Batch sizes keep the staging buffers small on the stack.
+#define TOKENS_BATCH_INDEXED  8
+#define TOKENS_BATCH_FULL_IDS 4
+#define VLQ_U32_MAX_LEN       5
+#define VLQ_U64_MAX_LEN       10
 
-    while (buffer_data_len(input) > 0) {
-        union {
-            uint32_t index;
-            uint8_t id[ERGO_ID_LEN];
-        } token_id;
-        uint64_t value;
-
-        if (context->tokens_count == 0) {
-            return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_TOO_MANY_TOKENS);
-        }
+// Sign path: tokens are indexes in the transaction tokens table
+static NOINLINE ergo_tx_serializer_box_result_e
+add_tokens_indexed(ergo_tx_serializer_box_context_t* context,
+                   buffer_t* input,
+                   const ergo_tx_serializer_table_context_t* table) {
+    uint32_t indexes[TOKENS_BATCH_INDEXED];
+    uint64_t values[TOKENS_BATCH_INDEXED];
+    RW_BUFFER_NEW_LOCAL_EMPTY(staging, TOKENS_BATCH_INDEXED * (VLQ_U32_MAX_LEN + VLQ_U64_MAX_LEN));
 
-        if (table == NULL) {  // no token table. working with full ids.
-            if (!buffer_read_bytes(input, token_id.id, ERGO_ID_LEN)) {
-                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_ID);
-            }
-            // hashing input id
-            if (!blake2b_update(context->hash, token_id.id, ERGO_ID_LEN)) {
-                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_HASHER);
+    while (buffer_data_len(input) > 0) {
+        uint8_t count = 0;
+        for (; count < TOKENS_BATCH_INDEXED && buffer_data_len(input) > 0; count++) {
+            if (context->tokens_count == count) {
+                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_TOO_MANY_TOKENS);
             }
-        } else {
-            if (!buffer_read_u32(input, &token_id.index, BE)) {
-                return ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_INDEX;
+            if (!buffer_read_u32(input, &indexes[count], BE)) {
+                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_INDEX);
             }
             // index should be inside table
-            if (token_id.index >= table->distinct_tokens_count) {
+            if (indexes[count] >= table->distinct_tokens_count) {
                 return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_INDEX);
             }
-            // hashing index
-            rw_buffer_empty(&buffer);
-            if (gve_put_u32(&buffer, token_id.index) != GVE_OK) {
+            if (!buffer_read_u64(input, &values[count], BE)) {
+                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_VALUE);
+            }
+        }
+
+        rw_buffer_empty(&staging);
+        for (uint8_t i = 0; i < count; i++) {
+            if (gve_put_u32(&staging, indexes[i]) != GVE_OK ||
+                gve_put_u64(&staging, values[i]) != GVE_OK) {
                 return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BUFFER);
             }
-            if (!blake2b_update(context->hash,
-                                rw_buffer_read_ptr(&buffer),
-                                rw_buffer_data_len(&buffer))) {
-                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_HASHER);
+        }
+        if (!blake2b_update(context->hash,
+                            rw_buffer_read_ptr(&staging),
+                            rw_buffer_data_len(&staging))) {
+            return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_HASHER);
+        }
+
+        if (context->callbacks.on_token != NULL) {
+            for (uint8_t i = 0; i < count; i++) {
+                CHECK_CALL_RESULT_OK(
+                    context,
+                    context->callbacks.on_token(context->type,
+                                                table->tokens_table->tokens[indexes[i]],
+                                                values[i],
+                                                context->callbacks.context));
             }
         }
+        context->tokens_count -= count;
+    }
+    return ERGO_TX_SERIALIZER_BOX_RES_OK;
+}
+
+// Attest path: no token table, tokens are full ids
+static NOINLINE ergo_tx_serializer_box_result_e
+add_tokens_full_ids(ergo_tx_serializer_box_context_t* context, buffer_t* input) {
+    const uint8_t* ids[TOKENS_BATCH_FULL_IDS];  // point into the input
+    uint64_t values[TOKENS_BATCH_FULL_IDS];
+    RW_BUFFER_NEW_LOCAL_EMPTY(staging, TOKENS_BATCH_FULL_IDS * (ERGO_ID_LEN + VLQ_U64_MAX_LEN));
 
-        // reading value
-        if (!buffer_read_u64(input, &value, BE)) {
-            return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_VALUE);
+    while (buffer_data_len(input) > 0) {
+        uint8_t count = 0;
+        for (; count < TOKENS_BATCH_FULL_IDS && buffer_data_len(input) > 0; count++) {
+            if (context->tokens_count == count) {
+                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_TOO_MANY_TOKENS);
+            }
+            ids[count] = buffer_read_ptr(input);
+            if (!buffer_seek_cur(input, ERGO_ID_LEN)) {
+                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_ID);
+            }
+            if (!buffer_read_u64(input, &values[count], BE)) {
+                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_VALUE);
+            }
         }
-        rw_buffer_empty(&buffer);
-        if (gve_put_u64(&buffer, value) != GVE_OK) {
-            return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BUFFER);
+
+        rw_buffer_empty(&staging);
+        for (uint8_t i = 0; i < count; i++) {
+            if (!rw_buffer_write_bytes(&staging, ids[i], ERGO_ID_LEN) ||
+                gve_put_u64(&staging, values[i]) != GVE_OK) {
+                return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_BUFFER);
+            }
         }
         if (!blake2b_update(context->hash,
-                            rw_buffer_read_ptr(&buffer),
-                            rw_buffer_data_len(&buffer))) {
+                            rw_buffer_read_ptr(&staging),
+                            rw_buffer_data_len(&staging))) {
             return res_error(context, ERGO_TX_SERIALIZER_BOX_RES_ERR_HASHER);
         }
 
         if (context->callbacks.on_token != NULL) {
-            const uint8_t* tid =
-                table == NULL ? token_id.id : table->tokens_table->tokens[token_id.index];
-            CHECK_CALL_RESULT_OK(
-                context,
-                context->callbacks.on_token(context->type, tid, value, context->callbacks.context));
+            for (uint8_t i = 0; i < count; i++) {
+                CHECK_CALL_RESULT_OK(context,
+                                     context->callbacks.on_token(context->type,
+                                                                 ids[i],
+                                                                 values[i],
+                                                                 context->callbacks.context));
+            }
         }
-        context->tokens_count--;
+        context->tokens_count -= count;
     }
+    return ERGO_TX_SERIALIZER_BOX_RES_OK;
+}
+
+ergo_tx_serializer_box_result_e ergo_tx_serializer_box_add_tokens(
+    ergo_tx_serializer_box_context_t* context,
+    buffer_t* input,
+    const ergo_tx_serializer_table_context_t* table) {
+    CHECK_PROPER_STATE(context, ERGO_TX_SERIALIZER_BOX_STATE_TREE_ADDED);
+
+    if (table == NULL) {  // no token table. working with full ids.
+        CHECK_CALL_RESULT_OK(context, add_tokens_full_ids(context, input));
+    } else {
+        CHECK_CALL_RESULT_OK(context, add_tokens_indexed(context, input, table));
+    }
+
     if (context->tokens_count == 0) {
         if (context->registers_size == 0) {
             CHECK_CALL_RESULT_OK(context, add_empty_registers_count(context));
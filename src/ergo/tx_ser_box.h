@@ -87,7 +87,7 @@ ergo_tx_serializer_box_result_e ergo_tx_serializer_box_add_miners_fee_tree(
 
 ergo_tx_serializer_box_result_e ergo_tx_serializer_box_add_change_tree(
     ergo_tx_serializer_box_context_t* context,
-    const uint8_t raw_public_key[static PUBLIC_KEY_LEN]);
+    const uint8_t public_key[static COMPRESSED_PUBLIC_KEY_LEN]);
 
 ergo_tx_serializer_box_result_e ergo_tx_serializer_box_add_tokens(
     ergo_tx_serializer_box_context_t* context,
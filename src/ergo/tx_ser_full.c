@@ -165,7 +165,7 @@ ergo_tx_serializer_full_result_e ergo_tx_serializer_full_init(
     uint16_t inputs_count,
     uint16_t data_inputs_count,
     uint16_t outputs_count,
-    uint8_t tokens_count,
+    uint16_t tokens_count,
     cx_blake2b_t* hash,
     token_table_t* tokens_table) {
     memset(context, 0, sizeof(ergo_tx_serializer_full_context_t));
@@ -329,12 +329,12 @@ ergo_tx_serializer_full_result_e ergo_tx_serializer_full_add_box_ergo_tree(
 
 ergo_tx_serializer_full_result_e ergo_tx_serializer_full_add_box_change_tree(
     ergo_tx_serializer_full_context_t* context,
-    const uint8_t raw_pub_key[static PUBLIC_KEY_LEN]) {
+    const uint8_t pub_key[static COMPRESSED_PUBLIC_KEY_LEN]) {
     CHECK_PROPER_STATE(context, ERGO_TX_SERIALIZER_FULL_STATE_OUTPUTS_STARTED);
 
     CHECK_CALL_RESULT_OK(
         context,
-        map_box_result(ergo_tx_serializer_box_add_change_tree(&context->box_ctx, raw_pub_key)));
+        map_box_result(ergo_tx_serializer_box_add_change_tree(&context->box_ctx, pub_key)));
 
     if (ergo_tx_serializer_box_is_finished(&context->box_ctx)) {
         return output_finished(context);
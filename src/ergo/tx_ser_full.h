@@ -63,7 +63,7 @@ ergo_tx_serializer_full_result_e ergo_tx_serializer_full_init(
     uint16_t inputs_count,
     uint16_t data_inputs_count,
     uint16_t outputs_count,
-    uint8_t tokens_count,
+    uint16_t tokens_count,
     cx_blake2b_t* hash,
     token_table_t* tokens_table);
 
@@ -105,7 +105,7 @@ ergo_tx_serializer_full_result_e ergo_tx_serializer_full_add_box_ergo_tree(
 
 ergo_tx_serializer_full_result_e ergo_tx_serializer_full_add_box_change_tree(
     ergo_tx_serializer_full_context_t* context,
-    const uint8_t raw_pub_key[static PUBLIC_KEY_LEN]);
+    const uint8_t pub_key[static COMPRESSED_PUBLIC_KEY_LEN]);
 
 ergo_tx_serializer_full_result_e ergo_tx_serializer_full_add_box_miners_fee_tree(
     ergo_tx_serializer_full_context_t* context,
@@ -3,7 +3,7 @@
 
 static inline ergo_tx_serializer_table_result_e parse_token(buffer_t* tokens,
                                                             token_table_t* table,
-                                                            uint8_t tokens_max) {
+                                                            uint16_t tokens_max) {
     if (table->count >= tokens_max) {
         return ERGO_TX_SERIALIZER_TABLE_RES_ERR_TOO_MANY_TOKENS;
     }
@@ -15,7 +15,7 @@ static inline ergo_tx_serializer_table_result_e parse_token(buffer_t* tokens,
 
 ergo_tx_serializer_table_result_e ergo_tx_serializer_table_init(
     ergo_tx_serializer_table_context_t* context,
-    uint8_t tokens_count,
+    uint16_t tokens_count,
     token_table_t* tokens_table) {
     // tokens table should be empty.
     // we add distinct tokens to the start of the table
@@ -56,7 +56,7 @@ ergo_tx_serializer_table_result_e ergo_tx_serializer_table_hash(
     if (!blake2b_update(hash, rw_buffer_read_ptr(&buffer), rw_buffer_data_len(&buffer))) {
         return ERGO_TX_SERIALIZER_TABLE_RES_ERR_HASHER;
     }
-    for (uint8_t i = 0; i < context->distinct_tokens_count; i++) {
+    for (uint16_t i = 0; i < context->distinct_tokens_count; i++) {
         if (!blake2b_update(hash, context->tokens_table->tokens[i], ERGO_ID_LEN)) {
             return ERGO_TX_SERIALIZER_TABLE_RES_ERR_HASHER;
         }
@@ -10,8 +10,12 @@
 #include "../helpers/blake2b.h"
 #include "../common/macros_ext.h"
 
+#if TOKEN_MAX_COUNT == 0 || TOKEN_MAX_COUNT > 0xFFFE
+#error "TOKEN_MAX_COUNT should be in 1..0xFFFE"
+#endif
+
 typedef struct {
-    uint8_t count;
+    uint16_t count;
     uint8_t tokens[TOKEN_MAX_COUNT][ERGO_ID_LEN];
 } token_table_t;
 
@@ -26,28 +30,28 @@ typedef enum {
 
 typedef struct {
     token_table_t* tokens_table;
-    uint8_t distinct_tokens_count;
+    uint16_t distinct_tokens_count;
 } ergo_tx_serializer_table_context_t;
 
-static inline uint8_t token_table_find_token_index(const token_table_t* table,
-                                                   const uint8_t id[static ERGO_ID_LEN]) {
-    for (uint8_t i = 0; i < table->count; i++) {
+static inline uint16_t token_table_find_token_index(const token_table_t* table,
+                                                    const uint8_t id[static ERGO_ID_LEN]) {
+    for (uint16_t i = 0; i < table->count; i++) {
         if (memcmp(table->tokens[i], id, ERGO_ID_LEN) == 0) return i;
     }
-    return INDEX_NOT_EXIST;
+    return INDEX16_NOT_EXIST;
 }
 
-static inline uint8_t token_table_add_token(token_table_t* table,
-                                            const uint8_t id[static ERGO_ID_LEN]) {
-    if (table->count >= TOKEN_MAX_COUNT) return INDEX_NOT_EXIST;
-    uint8_t index = table->count++;
+static inline uint16_t token_table_add_token(token_table_t* table,
+                                             const uint8_t id[static ERGO_ID_LEN]) {
+    if (table->count >= TOKEN_MAX_COUNT) return INDEX16_NOT_EXIST;
+    uint16_t index = table->count++;
     memmove(table->tokens[index], id, ERGO_ID_LEN);
     return index;
 }
 
 ergo_tx_serializer_table_result_e ergo_tx_serializer_table_init(
     ergo_tx_serializer_table_context_t* context,
-    uint8_t tokens_count,
+    uint16_t tokens_count,
     token_table_t* tokens_table);
 
 ergo_tx_serializer_table_result_e ergo_tx_serializer_table_add(
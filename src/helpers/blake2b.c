@@ -1,10 +1,48 @@
 #include "blake2b.h"
+#include "stats.h"
+
+#ifdef HAVE_APP_BLAKE2B
+
+#include "blake2b_app.h"
+
+// In-app state is stored in the cx_blake2b_t storage, so hash contexts keep their size
+_Static_assert(sizeof(blake2b_app_ctx_t) <= sizeof(cx_blake2b_t),
+               "In-app BLAKE2b state doesn't fit into cx_blake2b_t");
+
+#define APP_CTX(ctx) ((blake2b_app_ctx_t*) (ctx))
+
+bool blake2b_256_init(cx_blake2b_t* ctx) {
+    blake2b_app_256_init(APP_CTX(ctx));
+    return true;
+}
+
+bool blake2b_update(cx_blake2b_t* ctx, const uint8_t* data, size_t len) {
+    APP_STATS_INC(blake2b_updates);
+    blake2b_app_update(APP_CTX(ctx), data, len);
+    return true;
+}
+
+bool blake2b_256_finalize(cx_blake2b_t* ctx, uint8_t out[static CX_BLAKE2B_256_SIZE]) {
+    blake2b_app_256_finalize(APP_CTX(ctx), out);
+    return true;
+}
+
+bool blake2b_256(const uint8_t* data, size_t len, uint8_t out[static CX_BLAKE2B_256_SIZE]) {
+    blake2b_app_ctx_t ctx;
+    blake2b_app_256_init(&ctx);
+    blake2b_app_update(&ctx, data, len);
+    blake2b_app_256_finalize(&ctx, out);
+    return true;
+}
+
+#else
 
 bool blake2b_256_init(cx_blake2b_t* ctx) {
     return cx_blake2b_init_no_throw(ctx, 256) == CX_OK;
 }
 
 bool blake2b_update(cx_blake2b_t* ctx, const uint8_t* data, size_t len) {
+    APP_STATS_INC(blake2b_updates);
     return cx_hash_no_throw((cx_hash_t*) ctx, 0, data, len, NULL, 0) == CX_OK;
 }
 
@@ -19,4 +57,6 @@ bool blake2b_256_finalize(cx_blake2b_t* ctx, uint8_t out[static CX_BLAKE2B_256_S
 
 bool blake2b_256(const uint8_t* data, size_t len, uint8_t out[static CX_BLAKE2B_256_SIZE]) {
     return cx_blake2b_256_hash(data, len, out) == CX_OK;
-}
\ No newline at end of file
+}
+
+#endif
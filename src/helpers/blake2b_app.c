@@ -0,0 +1,120 @@
+#include "blake2b_app.h"
+
+static const uint64_t BLAKE2B_IV[8] = {0x6a09e667f3bcc908,
+                                       0xbb67ae8584caa73b,
+                                       0x3c6ef372fe94f82b,
+                                       0xa54ff53a5f1d36f1,
+                                       0x510e527fade682d1,
+                                       0x9b05688c2b3e6c1f,
+                                       0x1f83d9abfb41bd6b,
+                                       0x5be0cd19137e2179};
+
+static const uint8_t BLAKE2B_SIGMA[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
+
+static inline uint64_t rotr64(uint64_t w, unsigned c) {
+    return (w >> c) | (w << (64 - c));
+}
+
+static inline uint64_t load64(const uint8_t *src) {
+    return (uint64_t) src[0] | ((uint64_t) src[1] << 8) | ((uint64_t) src[2] << 16) |
+           ((uint64_t) src[3] << 24) | ((uint64_t) src[4] << 32) | ((uint64_t) src[5] << 40) |
+           ((uint64_t) src[6] << 48) | ((uint64_t) src[7] << 56);
+}
+
+#define G(r, i, a, b, c, d)                         \
+    do {                                            \
+        a = a + b + m[BLAKE2B_SIGMA[r][2 * i]];     \
+        d = rotr64(d ^ a, 32);                      \
+        c = c + d;                                  \
+        b = rotr64(b ^ c, 24);                      \
+        a = a + b + m[BLAKE2B_SIGMA[r][2 * i + 1]]; \
+        d = rotr64(d ^ a, 16);                      \
+        c = c + d;                                  \
+        b = rotr64(b ^ c, 63);                      \
+    } while (0)
+
+static void blake2b_app_compress(blake2b_app_ctx_t *ctx,
+                                 const uint8_t block[static BLAKE2B_APP_BLOCK_LEN],
+                                 uint64_t final_flag) {
+    uint64_t m[16];
+    uint64_t v[16];
+
+    for (uint8_t i = 0; i < 16; i++) {
+        m[i] = load64(block + i * 8);
+    }
+    for (uint8_t i = 0; i < 8; i++) {
+        v[i] = ctx->h[i];
+        v[i + 8] = BLAKE2B_IV[i];
+    }
+    v[12] ^= ctx->counter;
+    v[14] ^= final_flag;
+
+    for (uint8_t r = 0; r < 12; r++) {
+        G(r, 0, v[0], v[4], v[8], v[12]);
+        G(r, 1, v[1], v[5], v[9], v[13]);
+        G(r, 2, v[2], v[6], v[10], v[14]);
+        G(r, 3, v[3], v[7], v[11], v[15]);
+        G(r, 4, v[0], v[5], v[10], v[15]);
+        G(r, 5, v[1], v[6], v[11], v[12]);
+        G(r, 6, v[2], v[7], v[8], v[13]);
+        G(r, 7, v[3], v[4], v[9], v[14]);
+    }
+
+    for (uint8_t i = 0; i < 8; i++) {
+        ctx->h[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+void blake2b_app_256_init(blake2b_app_ctx_t *ctx) {
+    memset(ctx, 0, sizeof(blake2b_app_ctx_t));
+    for (uint8_t i = 0; i < 8; i++) {
+        ctx->h[i] = BLAKE2B_IV[i];
+    }
+    // Parameter block: digest length, no key, fanout 1, depth 1
+    ctx->h[0] ^= 0x01010000 ^ BLAKE2B_APP_256_LEN;
+}
+
+void blake2b_app_update_blocks(blake2b_app_ctx_t *ctx, const uint8_t *data, size_t len) {
+    if (len == 0) return;
+    // Fill the buffer. It's compressed only when more data follows.
+    size_t fill = BLAKE2B_APP_BLOCK_LEN - ctx->buffer_len;
+    if (len > fill) {
+        memcpy(ctx->buffer + ctx->buffer_len, data, fill);
+        ctx->counter += BLAKE2B_APP_BLOCK_LEN;
+        blake2b_app_compress(ctx, ctx->buffer, 0);
+        ctx->buffer_len = 0;
+        data += fill;
+        len -= fill;
+        // Full blocks are compressed in place, the last one stays in the buffer
+        while (len > BLAKE2B_APP_BLOCK_LEN) {
+            ctx->counter += BLAKE2B_APP_BLOCK_LEN;
+            blake2b_app_compress(ctx, data, 0);
+            data += BLAKE2B_APP_BLOCK_LEN;
+            len -= BLAKE2B_APP_BLOCK_LEN;
+        }
+    }
+    memcpy(ctx->buffer + ctx->buffer_len, data, len);
+    ctx->buffer_len += (uint8_t) len;
+}
+
+void blake2b_app_256_finalize(blake2b_app_ctx_t *ctx, uint8_t out[static BLAKE2B_APP_256_LEN]) {
+    ctx->counter += ctx->buffer_len;
+    memset(ctx->buffer + ctx->buffer_len, 0, BLAKE2B_APP_BLOCK_LEN - ctx->buffer_len);
+    blake2b_app_compress(ctx, ctx->buffer, UINT64_MAX);
+
+    for (uint8_t i = 0; i < BLAKE2B_APP_256_LEN; i++) {
+        out[i] = (uint8_t) (ctx->h[i / 8] >> (8 * (i % 8)));
+    }
+}
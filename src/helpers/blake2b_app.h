@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+#include <string.h>  // memcpy
+
+/**
+ * BLAKE2b block size.
+ */
+#define BLAKE2B_APP_BLOCK_LEN 128
+
+/**
+ * BLAKE2b-256 digest size.
+ */
+#define BLAKE2B_APP_256_LEN 32
+
+/**
+ * In-app BLAKE2b-256 state.
+ * Last block is kept in the buffer until finalization, as it's compressed with the final flag.
+ */
+typedef struct {
+    uint64_t h[8];
+    uint64_t counter;  // number of compressed bytes
+    uint8_t buffer[BLAKE2B_APP_BLOCK_LEN];
+    uint8_t buffer_len;
+} blake2b_app_ctx_t;
+
+/**
+ * Initialize BLAKE2b-256 state without key.
+ *
+ * @param[out] ctx
+ *   Hash state.
+ *
+ */
+void blake2b_app_256_init(blake2b_app_ctx_t *ctx);
+
+/**
+ * Absorb data. Compresses buffered and full blocks.
+ * Use blake2b_app_update, it handles small updates inline.
+ *
+ * @param[in,out] ctx
+ *   Hash state.
+ * @param[in] data
+ *   Data to hash.
+ * @param[in] len
+ *   Data length.
+ *
+ */
+void blake2b_app_update_blocks(blake2b_app_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/**
+ * Absorb data. Data fitting into the block buffer is only copied.
+ *
+ * @param[in,out] ctx
+ *   Hash state.
+ * @param[in] data
+ *   Data to hash.
+ * @param[in] len
+ *   Data length.
+ *
+ */
+static inline void blake2b_app_update(blake2b_app_ctx_t *ctx, const uint8_t *data, size_t len) {
+    if (len <= (size_t) (BLAKE2B_APP_BLOCK_LEN - ctx->buffer_len)) {
+        memcpy(ctx->buffer + ctx->buffer_len, data, len);
+        ctx->buffer_len += (uint8_t) len;
+        return;
+    }
+    blake2b_app_update_blocks(ctx, data, len);
+}
+
+/**
+ * Compress the last block and write the digest. State should be initialized again after it.
+ *
+ * @param[in,out] ctx
+ *   Hash state.
+ * @param[out] out
+ *   Digest.
+ *
+ */
+void blake2b_app_256_finalize(blake2b_app_ctx_t *ctx, uint8_t out[static BLAKE2B_APP_256_LEN]);
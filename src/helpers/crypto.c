@@ -20,6 +20,7 @@
 #include <stdbool.h>  // bool
 
 #include "crypto.h"
+#include "stats.h"
 
 uint16_t crypto_derive_private_key(cx_ecfp_256_private_key_t *private_key,
                                    uint8_t chain_code[static CHAIN_CODE_LEN],
@@ -27,6 +28,7 @@ uint16_t crypto_derive_private_key(cx_ecfp_256_private_key_t *private_key,
                                    uint8_t bip32_path_len) {
     uint8_t raw_private_key[64] = {0};
 
+    APP_STATS_INC(derivations);
     // derive the seed with bip32_path
     cx_err_t result = os_derive_bip32_no_throw(CX_CURVE_256K1,
                                                bip32_path,
@@ -0,0 +1,94 @@
+#ifdef HAVE_STACK_PROFILE
+
+#include <string.h>
+
+#include "stack_profile.h"
+#include "../apdu_dispatcher.h"
+#include "../common/macros_ext.h"
+
+// Bounds of the app stack from the SDK linker script. The stack grows down from _estack.
+extern uint8_t _stack;
+extern uint8_t _estack;
+
+#ifdef HAVE_BOLOS_APP_STACK_CANARY
+// The SDK canary word sits at _stack and is checked on each syscall, it's never painted
+#define STACK_PROFILE_BOTTOM (&_stack + sizeof(uint32_t))
+#else
+#define STACK_PROFILE_BOTTOM (&_stack)
+#endif
+
+// Fill byte of the unused stack
+#define STACK_PROFILE_PAINT 0xA5
+// Bytes under the painter frame left untouched: memset frame and interrupt entry
+#define STACK_PROFILE_MARGIN 64
+
+stack_profile_t G_stack_profile;
+
+// Paints the stack from the address up to the caller frame
+static NOINLINE void stack_paint(uint8_t *from) {
+    uint8_t marker = 0;
+    uint8_t *to = &marker - STACK_PROFILE_MARGIN;
+    if (from < to) {
+        memset(from, STACK_PROFILE_PAINT, to - from);
+    }
+}
+
+// Lowest address written since the last paint. A written byte equal to the
+// paint value is missed, so the result may be a few bytes shallower.
+static uint8_t *stack_low_water(void) {
+    uint8_t *addr = STACK_PROFILE_BOTTOM;
+    while (addr < &_estack && *addr == STACK_PROFILE_PAINT) {
+        addr++;
+    }
+    return addr;
+}
+
+static inline uint16_t stack_depth(const uint8_t *low_water) {
+    return (uint16_t) (&_estack - low_water);
+}
+
+void stack_profile_init(void) {
+    stack_paint(STACK_PROFILE_BOTTOM);
+}
+
+void stack_profile_begin(uint8_t ins, uint8_t p1) {
+    uint8_t *low_water = stack_low_water();
+    G_stack_profile.idle_max_depth = MAX(G_stack_profile.idle_max_depth, stack_depth(low_water));
+    stack_paint(low_water);
+
+    G_stack_profile.current = NULL;
+    // don't profile the profile reading itself
+    if (ins == CMD_GET_APP_STACK_PROFILE) return;
+
+    for (uint8_t i = 0; i < G_stack_profile.count; i++) {
+        if (G_stack_profile.entries[i].ins == ins && G_stack_profile.entries[i].p1 == p1) {
+            G_stack_profile.current = &G_stack_profile.entries[i];
+            return;
+        }
+    }
+    if (G_stack_profile.count >= STACK_PROFILE_MAX_ENTRIES) return;
+    G_stack_profile.current = &G_stack_profile.entries[G_stack_profile.count++];
+    G_stack_profile.current->ins = ins;
+    G_stack_profile.current->p1 = p1;
+}
+
+void stack_profile_end(void) {
+    uint8_t *low_water = stack_low_water();
+    if (G_stack_profile.current != NULL) {
+        G_stack_profile.current->max_depth =
+            MAX(G_stack_profile.current->max_depth, stack_depth(low_water));
+        G_stack_profile.current = NULL;
+    }
+    // repaint even for untracked APDUs, so their usage isn't counted as idle one
+    stack_paint(low_water);
+}
+
+void stack_profile_reset(void) {
+    explicit_bzero(&G_stack_profile, sizeof(stack_profile_t));
+}
+
+uint16_t stack_profile_size(void) {
+    return stack_depth(STACK_PROFILE_BOTTOM);
+}
+
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef HAVE_STACK_PROFILE
+
+/**
+ * Max number of distinct (INS, P1) pairs tracked.
+ */
+#define STACK_PROFILE_MAX_ENTRIES 24
+
+/**
+ * Deepest stack usage of the single (INS, P1) pair.
+ */
+typedef struct {
+    uint8_t ins;
+    uint8_t p1;
+    uint16_t max_depth;  // bytes from the stack top
+} stack_profile_entry_t;
+
+typedef struct {
+    uint8_t count;
+    stack_profile_entry_t entries[STACK_PROFILE_MAX_ENTRIES];
+    stack_profile_entry_t *current;  // entry of APDU in progress (NULL if not tracked)
+    uint16_t idle_max_depth;         // deepest usage between APDUs: IO, UI events, idle tasks
+} stack_profile_t;
+
+extern stack_profile_t G_stack_profile;
+
+/**
+ * Paints the unused stack. Called once at the app start.
+ */
+void stack_profile_init(void);
+
+/**
+ * Records the usage since the previous APDU as idle one, repaints the stack and
+ * finds or allocates entry for (INS, P1).
+ */
+void stack_profile_begin(uint8_t ins, uint8_t p1);
+
+/**
+ * Records the usage of the current APDU and repaints the stack.
+ */
+void stack_profile_end(void);
+
+/**
+ * Clears all the entries.
+ */
+void stack_profile_reset(void);
+
+/**
+ * Size of the app stack in bytes.
+ */
+uint16_t stack_profile_size(void);
+
+#define STACK_PROFILE_INIT()           stack_profile_init()
+#define STACK_PROFILE_BEGIN(_ins, _p1) stack_profile_begin(_ins, _p1)
+#define STACK_PROFILE_END()            stack_profile_end()
+
+#else
+
+#define STACK_PROFILE_INIT() \
+    do {                     \
+    } while (0)
+#define STACK_PROFILE_BEGIN(_ins, _p1) \
+    do {                               \
+    } while (0)
+#define STACK_PROFILE_END() \
+    do {                    \
+    } while (0)
+
+#endif
@@ -0,0 +1,39 @@
+#ifdef HAVE_APP_STATS
+
+#include <string.h>
+
+#include "stats.h"
+#include "../apdu_dispatcher.h"
+
+app_stats_t G_app_stats;
+
+void app_stats_begin(uint8_t ins, uint8_t p1, uint8_t lc) {
+    G_app_stats.current = NULL;
+    // don't count the stats reading itself
+    if (ins == CMD_GET_APP_STATS) return;
+
+    for (uint8_t i = 0; i < G_app_stats.count; i++) {
+        if (G_app_stats.entries[i].ins == ins && G_app_stats.entries[i].p1 == p1) {
+            G_app_stats.current = &G_app_stats.entries[i];
+            break;
+        }
+    }
+    if (G_app_stats.current == NULL) {
+        if (G_app_stats.count >= APP_STATS_MAX_ENTRIES) return;
+        G_app_stats.current = &G_app_stats.entries[G_app_stats.count++];
+        G_app_stats.current->ins = ins;
+        G_app_stats.current->p1 = p1;
+    }
+    G_app_stats.current->calls++;
+    G_app_stats.current->bytes_in += lc;
+}
+
+void app_stats_end(void) {
+    G_app_stats.current = NULL;
+}
+
+void app_stats_reset(void) {
+    explicit_bzero(&G_app_stats, sizeof(app_stats_t));
+}
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef HAVE_APP_STATS
+
+/**
+ * Max number of distinct (INS, P1) pairs tracked.
+ */
+#define APP_STATS_MAX_ENTRIES 24
+
+/**
+ * Counters of the single (INS, P1) pair.
+ */
+typedef struct {
+    uint8_t ins;
+    uint8_t p1;
+    uint32_t calls;            // number of APDUs
+    uint32_t bytes_in;         // sum of Lc
+    uint32_t blake2b_updates;  // blake2b_update calls
+    uint32_t hmac_calls;       // HMAC-SHA256 calls
+    uint32_t derivations;      // BIP32 derivations
+} app_stats_entry_t;
+
+typedef struct {
+    uint8_t count;
+    app_stats_entry_t entries[APP_STATS_MAX_ENTRIES];
+    app_stats_entry_t *current;  // entry of APDU in progress (NULL if not tracked)
+} app_stats_t;
+
+extern app_stats_t G_app_stats;
+
+/**
+ * Starts tracking of the APDU. Finds or allocates entry for (INS, P1).
+ */
+void app_stats_begin(uint8_t ins, uint8_t p1, uint8_t lc);
+
+/**
+ * Finishes tracking of the current APDU.
+ */
+void app_stats_end(void);
+
+/**
+ * Clears all the counters.
+ */
+void app_stats_reset(void);
+
+#define APP_STATS_BEGIN(_ins, _p1, _lc) app_stats_begin(_ins, _p1, _lc)
+#define APP_STATS_END()                 app_stats_end()
+#define APP_STATS_INC(_field)                                              \
+    do {                                                                   \
+        if (G_app_stats.current != NULL) G_app_stats.current->_field++;    \
+    } while (0)
+
+#else
+
+#define APP_STATS_BEGIN(_ins, _p1, _lc) \
+    do {                                \
+    } while (0)
+#define APP_STATS_END() \
+    do {                \
+    } while (0)
+#define APP_STATS_INC(_field) \
+    do {                      \
+    } while (0)
+
+#endif
@@ -0,0 +1,48 @@
+#include <string.h>
+#include <os.h>
+
+#include "trusted_apps.h"
+#include "../storage.h"
+
+bool trusted_apps_is_enabled(void) {
+    return N_storage.trusted_apps_enabled == 0x01;
+}
+
+void trusted_apps_set_enabled(bool enabled) {
+    uint8_t value = enabled ? 0x01 : 0x00;
+    if (!enabled) trusted_apps_clear();
+    nvm_write((void *) &N_storage.trusted_apps_enabled, &value, 1);
+}
+
+uint8_t trusted_apps_count(void) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < TRUSTED_APPS_MAX_COUNT; i++) {
+        if (N_storage.trusted_apps[i] != 0) count++;
+    }
+    return count;
+}
+
+bool trusted_apps_contains(uint32_t app_id) {
+    if (app_id == 0 || !trusted_apps_is_enabled()) return false;
+    for (uint8_t i = 0; i < TRUSTED_APPS_MAX_COUNT; i++) {
+        if (N_storage.trusted_apps[i] == app_id) return true;
+    }
+    return false;
+}
+
+void trusted_apps_add(uint32_t app_id) {
+    if (app_id == 0 || !trusted_apps_is_enabled() || trusted_apps_contains(app_id)) return;
+    // Slots are filled in a ring, so the oldest token is replaced
+    uint8_t slot = N_storage.trusted_apps_next % TRUSTED_APPS_MAX_COUNT;
+    uint8_t next = (slot + 1) % TRUSTED_APPS_MAX_COUNT;
+    nvm_write((void *) &N_storage.trusted_apps[slot], &app_id, sizeof(app_id));
+    nvm_write((void *) &N_storage.trusted_apps_next, &next, 1);
+}
+
+void trusted_apps_clear(void) {
+    uint32_t empty[TRUSTED_APPS_MAX_COUNT];
+    uint8_t next = 0;
+    memset(empty, 0, sizeof(empty));
+    nvm_write((void *) N_storage.trusted_apps, empty, sizeof(empty));
+    nvm_write((void *) &N_storage.trusted_apps_next, &next, 1);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../constants.h"
+
+#if TRUSTED_APPS_MAX_COUNT > 255
+#error "TRUSTED_APPS_MAX_COUNT can't exceed 255"
+#endif
+
+/**
+ * Registry of approved application tokens in NVM.
+ * When enabled, tokens approved by the user are remembered across app restarts
+ * and the application id screens are skipped for them.
+ * The oldest token is replaced when the registry is full.
+ */
+
+/**
+ * Is remembering of approved applications enabled in settings.
+ */
+bool trusted_apps_is_enabled(void);
+
+/**
+ * Enable or disable the registry. Disabling forgets all the remembered tokens.
+ */
+void trusted_apps_set_enabled(bool enabled);
+
+/**
+ * Number of remembered application tokens.
+ */
+uint8_t trusted_apps_count(void);
+
+/**
+ * Check that the application token is remembered. Always false if disabled.
+ */
+bool trusted_apps_contains(uint32_t app_id);
+
+/**
+ * Remember approved application token. Does nothing if disabled or token is 0.
+ */
+void trusted_apps_add(uint32_t app_id);
+
+/**
+ * Forget all the remembered application tokens.
+ */
+void trusted_apps_clear(void);
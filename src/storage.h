@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "constants.h"
+
+/**
+ * Global structure for NVM data storage.
+ */
+typedef struct internal_storage_t {
+    uint8_t blind_signing_enabled;
+    uint8_t initialized;
+    uint8_t trusted_apps_enabled;
+    uint8_t trusted_apps_next;                     // slot for the next remembered app token
+    uint32_t trusted_apps[TRUSTED_APPS_MAX_COUNT];  // approved app tokens, 0 is an empty slot
+} internal_storage_t;
+
+extern const internal_storage_t N_storage_real;
+#define N_storage (*(volatile internal_storage_t*) PIC(&N_storage_real))
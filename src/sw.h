@@ -67,6 +67,8 @@
 #define SW_BAD_FRAME_SIGNATURE        0xE018
 #define SW_BAD_NET_TYPE_VALUE         0xE019
 #define SW_SMALL_CHUNK                0xE01A
+#define SW_TOO_MANY_CHANGE_PATHS      0xE01B
+#define SW_BAD_CHANGE_PATH_INDEX      0xE01C
 
 #define SW_BIP32_FORMATTING_FAILED   0xE101
 #define SW_ADDRESS_FORMATTING_FAILED 0xE102
@@ -11,9 +11,9 @@ void set_flow_response(bool response);
 void io_common_process();
 bool io_ui_process();
 
-#define N_UX_PAIRS TOKEN_MAX_COUNT * 2 + 10
-static char pair_mem_title[N_UX_PAIRS][20];
-static char pair_mem_text[N_UX_PAIRS][70];
+// Static review pairs capacity: derivation path and application id.
+// Transaction pairs are formatted on demand into the text pool pages.
+#define N_UX_PAIRS 2
 
 #ifdef HAVE_NBGL
 static nbgl_layoutTagValueList_t pair_list;
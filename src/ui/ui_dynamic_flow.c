@@ -10,16 +10,37 @@
 #include "ui_main.h"
 
 #include <ux.h>
+#include <string.h>
 
 struct ui_dynamic_flow_ctx_t {
-    uint8_t screen_count;
-    uint8_t current_screen;
+    uint16_t screen_count;
+    uint16_t current_screen;
     ui_dynamic_flow_show_screen_cb show_cb;
 };
 
 static ux_layout_bnnn_paging_params_t G_ui_dynamic_step_params[1];
 static struct ui_dynamic_flow_ctx_t G_dynamic_flow_context;
 
+// Fills step params with the formatted screen, calls show_cb only if screen isn't in the pool
+static uint16_t ui_dynamic_show_screen(uint16_t screen) {
+    char *title = (char *) G_ui_dynamic_step_params[0].title;
+    char *text = (char *) G_ui_dynamic_step_params[0].text;
+    bool is_cached = false;
+    ui_text_page_t *page = ui_text_pool_page(screen, &is_cached);
+    if (page == NULL) return SW_BAD_STATE;
+
+    if (!is_cached) {
+        uint16_t res = G_dynamic_flow_context.show_cb(screen, page->title, page->text);
+        if (res != SW_OK) {
+            ui_text_pool_release(page);
+            return res;
+        }
+    }
+    memmove(title, page->title, UI_DYNAMIC_FLOW_TITLE_LEN);
+    memmove(text, page->text, UI_DYNAMIC_FLOW_TEXT_LEN);
+    return SW_OK;
+}
+
 // This is a special function we must call for bnnn_paging to work properly in an edgecase.
 // It does some weird stuff with the `G_ux` global which is defined by the SDK.
 // No need to dig deeper into the code, a simple copy paste will do.
@@ -32,12 +53,11 @@ void bnnn_paging_edgecase() {
 
 #define DISPLAY_DYNAMIC_STATE(switch_method)                                                      \
     do {                                                                                          \
-        uint16_t res = G_dynamic_flow_context.show_cb(G_dynamic_flow_context.current_screen,      \
-                                                      (char *) G_ui_dynamic_step_params[0].title, \
-                                                      (char *) G_ui_dynamic_step_params[0].text); \
+        uint16_t res = ui_dynamic_show_screen(G_dynamic_flow_context.current_screen);             \
         if (res == SW_OK) {                                                                       \
             switch_method();                                                                      \
         } else {                                                                                  \
+            ui_text_pool_detach();                                                                \
             app_set_current_command(CMD_NONE);                                                    \
             res_error(res);                                                                       \
             ui_menu_main();                                                                       \
@@ -45,7 +65,7 @@ void bnnn_paging_edgecase() {
     } while (0)
 
 static inline void ui_dynamic_step_right() {
-    if (G_dynamic_flow_context.current_screen == INDEX_NOT_EXIST) {
+    if (G_dynamic_flow_context.current_screen == INDEX16_NOT_EXIST) {
         G_dynamic_flow_context.current_screen = G_dynamic_flow_context.screen_count - 1;
         DISPLAY_DYNAMIC_STATE(bnnn_paging_edgecase);
     } else {
@@ -53,7 +73,7 @@ static inline void ui_dynamic_step_right() {
             G_dynamic_flow_context.current_screen++;
             DISPLAY_DYNAMIC_STATE(bnnn_paging_edgecase);
         } else {
-            G_dynamic_flow_context.current_screen = INDEX_NOT_EXIST;
+            G_dynamic_flow_context.current_screen = INDEX16_NOT_EXIST;
             // go to the next static screen
             ux_flow_next();
         }
@@ -61,12 +81,12 @@ static inline void ui_dynamic_step_right() {
 }
 
 static inline void ui_dynamic_step_left() {
-    if (G_dynamic_flow_context.current_screen == INDEX_NOT_EXIST) {
+    if (G_dynamic_flow_context.current_screen == INDEX16_NOT_EXIST) {
         G_dynamic_flow_context.current_screen = 0;
         DISPLAY_DYNAMIC_STATE(ux_flow_next);
     } else {
         if (G_dynamic_flow_context.current_screen == 0) {
-            G_dynamic_flow_context.current_screen = INDEX_NOT_EXIST;
+            G_dynamic_flow_context.current_screen = INDEX16_NOT_EXIST;
             // Similar to `ux_flow_prev()` but updates layout to account for `bnnn_paging`'s
             // weird behaviour.
             bnnn_paging_edgecase();
@@ -86,17 +106,18 @@ UX_STEP_INIT(ux_dynamic_upper_delimiter_step, NULL, NULL, { ui_dynamic_step_left
 UX_STEP_INIT(ux_dynamic_lower_delimiter_step, NULL, NULL, { ui_dynamic_step_right(); });
 
 bool ui_add_dynamic_flow_screens(uint8_t *screen,
-                                 uint8_t dynamic_screen_count,
+                                 uint16_t dynamic_screen_count,
                                  char *title_storage,
                                  char *text_storage,
                                  ui_dynamic_flow_show_screen_cb show_cb) {
     if (MAX_NUMBER_OF_SCREENS - *screen < 3) return false;
-    if (dynamic_screen_count == 0 || dynamic_screen_count == INDEX_NOT_EXIST) return false;
+    if (dynamic_screen_count == 0 || dynamic_screen_count == INDEX16_NOT_EXIST) return false;
+    if (!ui_text_pool_is_attached()) return false;
 
     G_ui_dynamic_step_params[0].title = title_storage;
     G_ui_dynamic_step_params[0].text = text_storage;
     G_dynamic_flow_context.screen_count = dynamic_screen_count;
-    G_dynamic_flow_context.current_screen = INDEX_NOT_EXIST;
+    G_dynamic_flow_context.current_screen = INDEX16_NOT_EXIST;
     G_dynamic_flow_context.show_cb = show_cb;
 
     ui_add_screen(&ux_dynamic_upper_delimiter_step, screen);
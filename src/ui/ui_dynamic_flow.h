@@ -4,11 +4,26 @@
 #include <stddef.h>
 #include <stdbool.h>
 
-typedef uint16_t (*ui_dynamic_flow_show_screen_cb)(uint8_t, char *, char *);
+#include "ui_text_pool.h"
+
+/**
+ * Size of the dynamic screen title storage.
+ */
+#define UI_DYNAMIC_FLOW_TITLE_LEN UI_TEXT_POOL_TITLE_LEN
+
+/**
+ * Size of the dynamic screen text storage.
+ */
+#define UI_DYNAMIC_FLOW_TEXT_LEN UI_TEXT_POOL_TEXT_LEN
+
+typedef uint16_t (*ui_dynamic_flow_show_screen_cb)(uint16_t, char *, char *);
 
 // Global context pointer will be set to the dynamic flow context. Don't change it.
+// Storage should have UI_DYNAMIC_FLOW_TITLE_LEN and UI_DYNAMIC_FLOW_TEXT_LEN bytes.
+// Formatted screens are kept in the attached text pool, so show_cb is called once
+// for the screen while its page stays in the pool. Fails if no pool is attached.
 bool ui_add_dynamic_flow_screens(uint8_t *screen,
-                                 uint8_t dynamic_screen_count,
+                                 uint16_t dynamic_screen_count,
                                  char *title_storage,
                                  char *text_storage,
                                  ui_dynamic_flow_show_screen_cb show_cb);
@@ -4,6 +4,10 @@
 #include "../constants.h"
 #include "../context.h"
 
+#if MAX_NUMBER_OF_SCREENS < 8 || MAX_NUMBER_OF_SCREENS > 254
+#error "MAX_NUMBER_OF_SCREENS should be in 8..254"
+#endif
+
 #ifdef HAVE_BAGL
 /**
  * Global array for UI screen flow
@@ -7,7 +7,7 @@ void ui_menu_main(void);
 
 #ifdef HAVE_BAGL
 /**
- * Show settings submenu (blind signing toggle).
+ * Show settings submenu (blind signing and trusted apps toggles).
  */
 void ui_menu_settings(void);
 #endif
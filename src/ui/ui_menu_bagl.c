@@ -20,9 +20,11 @@
 #include <os.h>
 #include <ux.h>
 #include <glyphs.h>
+#include <stdio.h>
 
 #include "ui_menu.h"
 #include "ui_main.h"
+#include "../helpers/trusted_apps.h"
 
 UX_STEP_NOCB(ux_menu_ready_step, pnn, {&C_app_logo_16px, APPNAME, "is ready"});
 UX_STEP_CB(ux_menu_settings_step, pb, ui_menu_settings(), {&C_icon_coggle, "Settings"});
@@ -73,6 +75,31 @@ UX_STEP_CB(ux_menu_bs_disabled_step,
            toggle_blind_signing(),
            {"Blind signing", "Enable transaction", "blind signing.", "Disabled"});
 
+static void toggle_trusted_apps() {
+    trusted_apps_set_enabled(!trusted_apps_is_enabled());
+    ui_menu_settings();
+}
+
+static void forget_trusted_apps() {
+    trusted_apps_clear();
+    ui_menu_settings();
+}
+
+static char G_trusted_apps_count[20];
+
+UX_STEP_CB(ux_menu_ta_enabled_step,
+           bnnn,
+           toggle_trusted_apps(),
+           {"Trusted apps", "Remember approved", "applications.", "Enabled"});
+UX_STEP_CB(ux_menu_ta_disabled_step,
+           bnnn,
+           toggle_trusted_apps(),
+           {"Trusted apps", "Remember approved", "applications.", "Disabled"});
+UX_STEP_CB(ux_menu_ta_forget_step,
+           bn,
+           forget_trusted_apps(),
+           {"Forget apps", G_trusted_apps_count});
+
 void ui_menu_settings() {
     uint8_t screen = 0;
     if (N_storage.blind_signing_enabled) {
@@ -80,6 +107,16 @@ void ui_menu_settings() {
     } else {
         ui_add_screen(&ux_menu_bs_disabled_step, &screen);
     }
+    if (trusted_apps_is_enabled()) {
+        snprintf(G_trusted_apps_count,
+                 sizeof(G_trusted_apps_count),
+                 "%d remembered",
+                 (int) trusted_apps_count());
+        ui_add_screen(&ux_menu_ta_enabled_step, &screen);
+        ui_add_screen(&ux_menu_ta_forget_step, &screen);
+    } else {
+        ui_add_screen(&ux_menu_ta_disabled_step, &screen);
+    }
     ui_add_screen(&ux_menu_back_step, &screen);
     ui_display_screens(&screen);
 
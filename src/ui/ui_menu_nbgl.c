@@ -6,6 +6,8 @@
 #include <os.h>
 #include <context.h>
 
+#include "../helpers/trusted_apps.h"
+
 #define APPTAGLINE   "This app enables signing\ntransactions on the Ergo\nnetwork."
 #define APPCOPYRIGHT "Ergo App (c) 2024"
 
@@ -20,31 +22,58 @@ static const nbgl_contentInfoList_t infoList = {
 };
 
 // settings switches definitions
-enum { BLIND_SIGNING_SWITCH_TOKEN = FIRST_USER_TOKEN };
-enum { BLIND_SIGNING_SWITCH_ID = 0, SETTINGS_SWITCHES_NB };
+enum {
+    BLIND_SIGNING_SWITCH_TOKEN = FIRST_USER_TOKEN,
+    TRUSTED_APPS_SWITCH_TOKEN,
+    TRUSTED_APPS_FORGET_TOKEN
+};
+enum { BLIND_SIGNING_SWITCH_ID = 0, TRUSTED_APPS_SWITCH_ID, SETTINGS_SWITCHES_NB };
 
 static nbgl_contentSwitch_t switches[SETTINGS_SWITCHES_NB] = {0};
 
+// trusted apps management
+static const char* const TRUSTED_APPS_BARS[] = {"Forget trusted apps"};
+static const uint8_t TRUSTED_APPS_BARS_TOKENS[] = {TRUSTED_APPS_FORGET_TOKEN};
+
 static void controls_callback(int token, uint8_t index, int page);
 
-// settings definition
-#define SETTING_CONTENTS_NB 1
+// settings definition, "Forget trusted apps" bar is the last one
+#define SETTING_CONTENTS_NB 2
 static const nbgl_content_t contents[SETTING_CONTENTS_NB] = {
     {.type = SWITCHES_LIST,
      .content.switchesList.nbSwitches = SETTINGS_SWITCHES_NB,
      .content.switchesList.switches = switches,
+     .contentActionCallback = controls_callback},
+    {.type = BARS_LIST,
+     .content.barsList.barTexts = TRUSTED_APPS_BARS,
+     .content.barsList.tokens = TRUSTED_APPS_BARS_TOKENS,
+     .content.barsList.nbBars = 1,
      .contentActionCallback = controls_callback}};
 
-static const nbgl_genericContents_t settingContents = {.callbackCallNeeded = false,
-                                                       .contentsList = contents,
-                                                       .nbContents = SETTING_CONTENTS_NB};
+static nbgl_genericContents_t settingContents = {.callbackCallNeeded = false,
+                                                 .contentsList = contents,
+                                                 .nbContents = SETTING_CONTENTS_NB};
 
 void app_quit(void) {
     // exit app here
     os_sched_exit(-1);
 }
 
-static void controls_callback(int token, uint8_t index, __attribute__((unused)) int page) {
+static void ui_menu_home_and_settings(uint8_t init_page) {
+    // trusted apps can be forgotten only when they are remembered
+    settingContents.nbContents =
+        trusted_apps_is_enabled() ? SETTING_CONTENTS_NB : SETTING_CONTENTS_NB - 1;
+    nbgl_useCaseHomeAndSettings(APPNAME,
+                                &C_app_logo_64px,
+                                APPTAGLINE,
+                                init_page,
+                                &settingContents,
+                                &infoList,
+                                NULL,
+                                app_quit);
+}
+
+static void controls_callback(int token, uint8_t index, int page) {
     UNUSED(index);
 
     uint8_t switch_value;
@@ -54,6 +83,16 @@ static void controls_callback(int token, uint8_t index, __attribute__((unused))
         switches[BLIND_SIGNING_SWITCH_ID].initState = (nbgl_state_t) switch_value;
         // store the new setting value in NVM
         nvm_write((void*) &N_storage.blind_signing_enabled, &switch_value, 1);
+    } else if (token == TRUSTED_APPS_SWITCH_TOKEN) {
+        switch_value = !trusted_apps_is_enabled();
+        switches[TRUSTED_APPS_SWITCH_ID].initState = (nbgl_state_t) switch_value;
+        // disabling also forgets remembered apps
+        trusted_apps_set_enabled(switch_value);
+        // redraw to show or hide the "Forget trusted apps" bar
+        ui_menu_home_and_settings((uint8_t) page);
+    } else if (token == TRUSTED_APPS_FORGET_TOKEN) {
+        trusted_apps_clear();
+        nbgl_useCaseStatus("Trusted apps\nforgotten", true, ui_menu_main);
     }
 }
 
@@ -65,26 +104,19 @@ void ui_menu_main() {
 #ifdef HAVE_PIEZO_SOUND
     switches[BLIND_SIGNING_SWITCH_ID].tuneId = TUNE_TAP_CASUAL;
 #endif
+    switches[TRUSTED_APPS_SWITCH_ID].initState = (nbgl_state_t) trusted_apps_is_enabled();
+    switches[TRUSTED_APPS_SWITCH_ID].text = "Trusted apps";
+    switches[TRUSTED_APPS_SWITCH_ID].subText = "Remember approved\napplications.";
+    switches[TRUSTED_APPS_SWITCH_ID].token = TRUSTED_APPS_SWITCH_TOKEN;
+#ifdef HAVE_PIEZO_SOUND
+    switches[TRUSTED_APPS_SWITCH_ID].tuneId = TUNE_TAP_CASUAL;
+#endif
 
-    nbgl_useCaseHomeAndSettings(APPNAME,
-                                &C_app_logo_64px,
-                                APPTAGLINE,
-                                INIT_HOME_PAGE,
-                                &settingContents,
-                                &infoList,
-                                NULL,
-                                app_quit);
+    ui_menu_home_and_settings(INIT_HOME_PAGE);
 }
 
 void ui_menu_about() {
-    nbgl_useCaseHomeAndSettings(APPNAME,
-                                &C_app_logo_64px,
-                                APPTAGLINE,
-                                0,
-                                &settingContents,
-                                &infoList,
-                                NULL,
-                                app_quit);
+    ui_menu_home_and_settings(0);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <stddef.h>  // NULL
+#include <string.h>  // memset
+
+#include "ui_text_pool.h"
+
+static ui_text_pool_t *G_ui_text_pool = NULL;
+
+// Restarts use ticks keeping the order of the pages
+static void ui_text_pool_age(ui_text_pool_t *pool) {
+    for (uint8_t i = 0; i < UI_TEXT_POOL_PAGES; i++) {
+        pool->pages[i].used >>= 1;
+    }
+    pool->tick = UINT8_MAX >> 1;
+}
+
+void ui_text_pool_attach(ui_text_pool_t *pool) {
+    memset(pool, 0, sizeof(ui_text_pool_t));
+    G_ui_text_pool = pool;
+}
+
+void ui_text_pool_detach(void) {
+    G_ui_text_pool = NULL;
+}
+
+bool ui_text_pool_is_attached(void) {
+    return G_ui_text_pool != NULL;
+}
+
+ui_text_page_t *ui_text_pool_page(uint16_t key, bool *is_cached) {
+    ui_text_pool_t *pool = G_ui_text_pool;
+    *is_cached = false;
+    if (pool == NULL) return NULL;
+
+    ui_text_page_t *page = &pool->pages[0];
+    for (uint8_t i = 0; i < UI_TEXT_POOL_PAGES; i++) {
+        ui_text_page_t *current = &pool->pages[i];
+        if (current->used != 0 && current->key == key) {
+            page = current;
+            *is_cached = true;
+            break;
+        }
+        if (current->used < page->used) page = current;
+    }
+
+    if (pool->tick == UINT8_MAX) ui_text_pool_age(pool);
+    page->used = ++pool->tick;
+    page->key = key;
+    return page;
+}
+
+void ui_text_pool_release(ui_text_page_t *page) {
+    page->used = 0;
+}
+
+uint8_t ui_text_pool_page_position(const ui_text_page_t *page) {
+    return (uint8_t) (page - G_ui_text_pool->pages);
+}
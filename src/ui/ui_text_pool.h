@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "../constants.h"
+
+#if UI_TEXT_POOL_PAGES == 0 || UI_TEXT_POOL_PAGES > 255
+#error "UI_TEXT_POOL_PAGES should be in 1..255"
+#endif
+
+/**
+ * Size of the page title storage.
+ */
+#define UI_TEXT_POOL_TITLE_LEN 20
+
+/**
+ * Size of the page text storage.
+ */
+#define UI_TEXT_POOL_TEXT_LEN 70
+
+/**
+ * Formatted title and text of one review screen.
+ */
+typedef struct {
+    uint16_t key;  // screen index of the page
+    uint8_t used;  // last use tick, 0 if the page is free
+    char title[UI_TEXT_POOL_TITLE_LEN];
+    char text[UI_TEXT_POOL_TEXT_LEN];
+} ui_text_page_t;
+
+/**
+ * Text storage of the review screens.
+ * Owned by the command context and attached to the UI while the review is displayed,
+ * so it can share memory with the command data which isn't used during the review.
+ * Pages are allocated on demand, the least recently used page is reused.
+ */
+typedef struct {
+    uint8_t tick;
+    ui_text_page_t pages[UI_TEXT_POOL_PAGES];
+} ui_text_pool_t;
+
+_Static_assert(sizeof(ui_text_pool_t) <= UI_TEXT_POOL_RAM_BUDGET,
+               "UI text pool exceeds UI_TEXT_POOL_RAM_BUDGET");
+
+/**
+ * Attach the pool to the UI. All pages are freed.
+ *
+ * @param[in] pool
+ *   Pool storage owned by the command context.
+ *
+ */
+void ui_text_pool_attach(ui_text_pool_t *pool);
+
+/**
+ * Detach the pool from the UI.
+ */
+void ui_text_pool_detach(void);
+
+/**
+ * Check if a pool is attached to the UI.
+ *
+ * @return true if the pool is attached.
+ *
+ */
+bool ui_text_pool_is_attached(void);
+
+/**
+ * Get the page of the screen. Allocates the least recently used page
+ * if the screen isn't in the pool.
+ *
+ * @param[in] key
+ *   Screen index.
+ * @param[out] is_cached
+ *   Set to true if the page already has the screen text.
+ *
+ * @return page, NULL if no pool is attached.
+ *
+ */
+ui_text_page_t *ui_text_pool_page(uint16_t key, bool *is_cached);
+
+/**
+ * Free the page, e.g. when the screen formatting failed.
+ *
+ * @param[in,out] page
+ *   Page of the attached pool.
+ *
+ */
+void ui_text_pool_release(ui_text_page_t *page);
+
+/**
+ * Position of the page in the attached pool.
+ *
+ * @param[in] page
+ *   Page of the attached pool.
+ *
+ * @return page position in 0..UI_TEXT_POOL_PAGES-1.
+ *
+ */
+uint8_t ui_text_pool_page_position(const ui_text_page_t *page);
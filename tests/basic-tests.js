@@ -2,6 +2,7 @@ const chai = require('chai');
 const { expect } = chai.use(require('chai-bytes'));
 const makefile = require('./helpers/makefile');
 const screen = require('./helpers/screen');
+const { readCapabilities, parseCapabilities, supports, Feature, BuildFlag } = require('./helpers/capabilities');
 
 describe("Basic Tests", function () {
     context("Basic Commands", function () {
@@ -19,6 +20,67 @@ describe("Basic Tests", function () {
             const name = (await this.device.getAppName()).name;
             expect(name).to.be.equal(makefile.appName);
         });
+
+        it("can fetch limits of the app", async function () {
+            const response = await this.transport.send(0xe0, 0x03, 0x00, 0x00);
+            expect(response.length).to.be.equal(14 + 2);
+            expect(response.readUInt16BE(0)).to.be.at.least(1);
+            expect(response.readUInt8(2)).to.be.within(1, 4);
+            expect(response.readUInt8(7)).to.be.equal(255);
+            // review holds at least the 100 tokens and 105 destinations of the previous releases
+            expect(response.readUInt8(8)).to.be.at.least(105);
+            expect(response.readUInt16BE(9)).to.be.at.least(Math.max(100, response.readUInt16BE(0)));
+            expect(response.readUInt16BE(response.length - 2)).to.be.equal(0x9000);
+        });
+
+        it("can fetch capabilities of the app", async function () {
+            const capabilities = await readCapabilities(this.transport);
+            expect(capabilities.version).to.be.equal(1);
+            expect(supports(capabilities, Feature.SessionResume)).to.be.true;
+            expect(supports(capabilities, Feature.ChangePaths)).to.be.true;
+            expect(capabilities.buildFlags & BuildFlag.Debug).to.be.equal(0);
+            expect(capabilities.limits.dataChunkLength).to.be.equal(255);
+            const limits = await this.transport.send(0xe0, 0x03, 0x00, 0x00);
+            expect(capabilities.limits.tokens).to.be.equal(limits.readUInt16BE(0));
+            // negotiated once after connecting
+            expect(this.capabilities).to.be.deep.equal(capabilities);
+        });
+
+        it("falls back to the basic protocol without capabilities", async function () {
+            const transport = {
+                send: async (cla, ins, p1, p2, data, statusList) => {
+                    expect(ins).to.be.equal(0x04);
+                    expect(statusList).to.include(0x6d00);
+                    return Buffer.from([0x6d, 0x00]);
+                }
+            };
+            const capabilities = await readCapabilities(transport);
+            expect(capabilities).to.be.null;
+            expect(supports(capabilities, Feature.ChangePaths)).to.be.false;
+        });
+
+        it("skips unknown fields of newer capabilities records", function () {
+            const record = Buffer.alloc(2 + 20 + 3);
+            record.writeUInt8(2, 0);
+            record.writeUInt8(20 + 3, 1);
+            record.writeUInt32BE(Feature.SessionResume | Feature.InlineInputBoxes, 2);
+            record.writeUInt8(BuildFlag.Stats, 6);
+            record.writeUInt8(20, 7);
+            record.writeUInt16BE(255, 8);
+            record.writeUInt8(255, 15);
+            record.writeUInt8(4, 19);
+            const capabilities = parseCapabilities(record);
+            expect(capabilities.version).to.be.equal(2);
+            expect(supports(capabilities, Feature.InlineInputBoxes)).to.be.true;
+            expect(supports(capabilities, Feature.ChangePaths)).to.be.false;
+            expect(capabilities.buildFlags).to.be.equal(BuildFlag.Stats);
+            expect(capabilities.ownAddressesWindow).to.be.equal(20);
+            expect(capabilities.limits.tokens).to.be.equal(255);
+            expect(capabilities.limits.dataChunkLength).to.be.equal(255);
+            expect(capabilities.limits.changePaths).to.be.equal(4);
+            // truncated record
+            expect(() => parseCapabilities(record.subarray(0, 10))).to.throw();
+        });
     });
 
     context("Basic Flows", function () {
@@ -44,7 +106,7 @@ describe("Basic Tests", function () {
                     await this.screens.click(0);
                     settingsMenu = await this.screens.readFlow();
                 }
-                await this.screens.click(1);
+                await this.screens.click(settingsMenu.length - 1);
                 expect(settingsMenu).to.be.deep.equal(screen.SETTINGS_FLOW);
             } else {
                 console.log("Check screens on the device, please!");
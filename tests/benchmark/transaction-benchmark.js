@@ -0,0 +1,123 @@
+const fs = require('fs');
+const path = require('path');
+const { toNetwork } = require('../helpers/common');
+const { TEST_DATA } = require('../helpers/data');
+const { TxBuilder } = require('../helpers/transaction');
+const { ApduMeter } = require('../helpers/meter');
+const { approveFlows } = require('../helpers/flow');
+
+const txId = "0000000000000000000000000000000000000000000000000000000000000000";
+const ERG = 1000000000;
+const FEE = 1100000;
+
+// Transaction shapes to sweep. Each shape is signed once, with UI auto-approval.
+const SHAPES = [
+    { name: 'simple', inputs: 1, outputs: 1, tokens: 0, registersSize: 0 },
+    { name: 'inputs-10', inputs: 10, outputs: 1, tokens: 0, registersSize: 0 },
+    { name: 'inputs-50', inputs: 50, outputs: 1, tokens: 0, registersSize: 0 },
+    { name: 'outputs-5', inputs: 1, outputs: 5, tokens: 0, registersSize: 0 },
+    { name: 'outputs-20', inputs: 1, outputs: 20, tokens: 0, registersSize: 0 },
+    { name: 'tokens-10', inputs: 1, outputs: 1, tokens: 10, registersSize: 0 },
+    { name: 'tokens-100', inputs: 1, outputs: 1, tokens: 100, registersSize: 0 },
+    { name: 'tokens-100-outputs-10', inputs: 5, outputs: 10, tokens: 100, registersSize: 0 },
+    { name: 'registers-2k', inputs: 1, outputs: 1, tokens: 0, registersSize: 2048 },
+];
+
+function tokenId(index) {
+    return (index + 1).toString(16).padStart(64, 'a');
+}
+
+function buildShape(shape) {
+    const from = TEST_DATA.address0;
+    const to = TEST_DATA.address1;
+    const builder = new TxBuilder();
+
+    // All tokens are in the first input and are distributed between outputs
+    const tokens = [...Array(shape.tokens).keys()].map(i => ({ id: tokenId(i), amount: '1000' }));
+    for (let i = 0; i < shape.inputs; i++) {
+        builder.input(from, txId, i, ERG.toString(), i === 0 ? tokens : undefined);
+    }
+    // Spend almost everything to make sure all inputs are selected
+    const outputValue = Math.floor((shape.inputs * ERG - FEE - ERG / 100) / shape.outputs);
+    const registers = shape.registersSize > 0 ? [new Uint8Array(shape.registersSize)] : undefined;
+    for (let i = 0; i < shape.outputs; i++) {
+        const outputTokens = tokens.filter((_, idx) => idx % shape.outputs === i);
+        builder.output(to.address, outputValue.toString(), outputTokens, undefined, registers);
+    }
+    return builder.fee(FEE.toString()).change(TEST_DATA.changeAddress).build();
+}
+
+function outputPath() {
+    return process.env.npm_config_output ?? path.join(__dirname, 'results.json');
+}
+
+function compare(results, baselinePath) {
+    const baseline = JSON.parse(fs.readFileSync(baselinePath));
+    const rows = results.shapes.map(shape => {
+        const base = baseline.shapes.find(s => s.name === shape.name);
+        if (!base || !base.total || !shape.total) {
+            return { name: shape.name, apdus: '-', bytes: '-', time: '-' };
+        }
+        const delta = (cur, old) => old === 0 ? '-' : `${(((cur - old) / old) * 100).toFixed(1)}%`;
+        return {
+            name: shape.name,
+            apdus: delta(shape.total.apdus, base.total.apdus),
+            bytes: delta(shape.total.bytesOut + shape.total.bytesIn,
+                         base.total.bytesOut + base.total.bytesIn),
+            time: delta(shape.total.wallTimeMs, base.total.wallTimeMs),
+        };
+    });
+    console.table(rows);
+}
+
+describe("Transaction Benchmark", function () {
+    const results = { model: null, date: new Date().toISOString(), shapes: [] };
+
+    before(function () {
+        if (!this.screens) {
+            this.skip(); // needs Speculos automation for auto-approval
+        }
+        results.model = this.model;
+    });
+
+    after(function () {
+        if (results.shapes.length === 0) {
+            return;
+        }
+        fs.writeFileSync(outputPath(), JSON.stringify(results, null, 2));
+        console.log(`Benchmark results written to ${outputPath()}`);
+        if (process.env.npm_config_baseline) {
+            compare(results, process.env.npm_config_baseline);
+        }
+    });
+
+    SHAPES.forEach(shape => {
+        it(`sign tx: ${shape.name}`, async function () {
+            this.timeout(0);
+            this.device.useAuthToken(false);
+            const { appTx } = buildShape(shape);
+            const meter = new ApduMeter(this.transport);
+            // one attestation flow per input + transaction flow
+            const flowsCount = appTx.inputs.length + 1;
+
+            this.screens.removeCurrentScreen();
+            meter.start();
+            const signing = this.device.signTx(appTx, toNetwork(TEST_DATA.network));
+            let error = null;
+            try {
+                await Promise.all([signing, approveFlows(this.screens, flowsCount)]);
+            } catch (e) {
+                error = e.message ?? String(e);
+            } finally {
+                meter.stop();
+            }
+            results.shapes.push({
+                ...shape,
+                selectedInputs: appTx.inputs.length,
+                distinctTokens: appTx.distinctTokenIds.length,
+                error,
+                ...meter.summary(),
+            });
+        });
+    });
+});
@@ -0,0 +1,82 @@
+// Capabilities record of the app (INS 0x04), see doc/INS-04-APP-CAPABILITIES.md
+
+const CLA = 0xe0;
+const INS_GET_APP_CAPABILITIES = 0x04;
+const SW_OK = 0x9000;
+const SW_INS_NOT_SUPPORTED = 0x6d00;
+
+const Feature = {
+    SessionResume: 0x0001,
+    WideTokensCount: 0x0002,
+    InlineInputBoxes: 0x0004,
+    ChangePaths: 0x0008,
+    ExtPubKeysRange: 0x0010,
+    OwnAddresses: 0x0020,
+    TrustedApps: 0x0040
+};
+
+const BuildFlag = {
+    Debug: 0x01,
+    Stats: 0x02,
+    Blake2b: 0x04,
+    StackProfile: 0x08
+};
+
+function parseLimits(data, offset) {
+    return {
+        tokens: data.readUInt16BE(offset),
+        frameTokens: data.readUInt8(offset + 2),
+        dataPartLength: data.readUInt32BE(offset + 3),
+        dataChunkLength: data.readUInt8(offset + 7),
+        reviewOutputs: data.readUInt8(offset + 8),
+        reviewTokens: data.readUInt16BE(offset + 9),
+        changePaths: data.readUInt8(offset + 11),
+        extPubKeysRange: data.readUInt8(offset + 12),
+        screens: data.readUInt8(offset + 13)
+    };
+}
+
+function parseCapabilities(data) {
+    const version = data.readUInt8(0);
+    const length = data.readUInt8(1);
+    if (version < 1 || data.length < 2 + length) {
+        throw new Error("Bad capabilities record, version " + version);
+    }
+    // Newer versions only append fields, unknown tail is ignored
+    return {
+        version: version,
+        features: data.readUInt32BE(2),
+        buildFlags: data.readUInt8(6),
+        ownAddressesWindow: data.readUInt8(7),
+        limits: parseLimits(data, 8)
+    };
+}
+
+// Returns null if the app doesn't support the instruction, so the client keeps the basic protocol
+async function readCapabilities(transport) {
+    const response = await transport.send(CLA, INS_GET_APP_CAPABILITIES, 0x00, 0x00, undefined,
+        [SW_OK, SW_INS_NOT_SUPPORTED]);
+    if (response.readUInt16BE(response.length - 2) !== SW_OK) {
+        return null;
+    }
+    return parseCapabilities(response.subarray(0, response.length - 2));
+}
+
+function supports(capabilities, feature) {
+    return capabilities != null && (capabilities.features & feature) === feature;
+}
+
+// Skips the mocha test if the app doesn't support the protocol variant it uses,
+// capabilities are read once after connecting (see hooks.js)
+function requireFeature(test, feature) {
+    if (!supports(test.capabilities, feature)) {
+        test.skip();
+    }
+}
+
+exports.Feature = Feature;
+exports.BuildFlag = BuildFlag;
+exports.parseCapabilities = parseCapabilities;
+exports.readCapabilities = readCapabilities;
+exports.requireFeature = requireFeature;
+exports.supports = supports;
@@ -0,0 +1,81 @@
+// Registered change paths of the signing session (INS 0x21, P1 0x1F), see doc/INS-21-SIGN-TRANSACTION.md
+
+const CLA = 0xe0;
+const INS_SIGN_TX = 0x21;
+const P1_START_TX = 0x10;
+const P1_OUTPUT_CHANGE_TREE = 0x18;
+const P1_REGISTER_CHANGE_PATH = 0x1f;
+const SW_OK = Buffer.from([0x90, 0x00]);
+const HARDENED = 0x80000000;
+
+// BIP44 path of the change address: m/44'/429'/account'/0/address
+function changePath(account, address) {
+    const path = [44 + HARDENED, 429 + HARDENED, account + HARDENED, 0, address];
+    const data = Buffer.alloc(1 + path.length * 4);
+    data.writeUInt8(path.length, 0);
+    path.forEach((index, i) => data.writeUInt32BE(index >>> 0, 1 + i * 4));
+    return data;
+}
+
+/**
+ * Registers the given change paths right after "Start Transaction data" (P1 0x10)
+ * and sends the change trees of the client (P1 0x18) with these paths as 1-byte indexes.
+ * Paths are [account, address] pairs. Wraps `exchange` of the transport until `stop` is called.
+ */
+class ChangePaths {
+    constructor(transport, paths) {
+        this._transport = transport;
+        this._exchange = null;
+        this._paths = paths.map(([account, address]) => changePath(account, address));
+        this.indexes = [];  // indexes returned by the app in the order of the paths
+        this.indexed = 0;   // change trees sent as an index
+        this.status = null; // status word of the failed registration
+    }
+
+    start() {
+        if (this._exchange) {
+            throw new Error("ChangePaths is already started");
+        }
+        this._exchange = this._transport.exchange;
+        const exchange = this._exchange.bind(this._transport);
+        this._transport.exchange = async (apdu) => {
+            if (apdu[1] !== INS_SIGN_TX) {
+                return exchange(apdu);
+            }
+            const session = apdu[3];
+            if (apdu[2] === P1_OUTPUT_CHANGE_TREE) {
+                const i = this._paths.findIndex(path => path.equals(apdu.subarray(5)));
+                if (i >= 0) {
+                    this.indexed += 1;
+                    const header = Buffer.from([CLA, INS_SIGN_TX, P1_OUTPUT_CHANGE_TREE, session, 1]);
+                    return exchange(Buffer.concat([header, Buffer.from([this.indexes[i]])]));
+                }
+            }
+            const response = await exchange(apdu);
+            if (apdu[2] !== P1_START_TX || !response.subarray(response.length - 2).equals(SW_OK)) {
+                return response;
+            }
+            for (const path of this._paths) {
+                const header = Buffer.from([CLA, INS_SIGN_TX, P1_REGISTER_CHANGE_PATH, session, path.length]);
+                const registered = await exchange(Buffer.concat([header, path]));
+                if (!registered.subarray(registered.length - 2).equals(SW_OK)) {
+                    this.status = registered.readUInt16BE(registered.length - 2);
+                    return registered;
+                }
+                this.indexes.push(registered[0]);
+            }
+            return response;
+        };
+    }
+
+    stop() {
+        if (!this._exchange) {
+            return;
+        }
+        this._transport.exchange = this._exchange;
+        this._exchange = null;
+    }
+}
+
+exports.ChangePaths = ChangePaths;
+exports.changePath = changePath;
@@ -13,10 +13,26 @@ function restorePromiseError(promise) {
     });
 }
 
+async function approveFlows(screens, flowsCount) {
+    const flows = [];
+    for (let i = 0; i < flowsCount; i++) {
+        let flow = await screens.readFlow();
+        flows.push(mergePagedScreens(flow));
+        // try to click on "Sign transaction" button first
+        await screens.clickOn('Sign transaction');
+        await screens.clickOn('Approve');
+        if (i != flowsCount - 1 && await screens.isReadyMainScreen()) { // we have more flows
+            screens.removeCurrentScreen(); // Wait for new screen in the readFlow
+        }
+    }
+    return flows;
+}
+
 class AuthTokenFlows {
     constructor(name) {
         this._name = name;
         this._before = null;
+        this._timeout = 30_000;
         this.shouldSucceed(null);
         this.shouldFail(null);
     }
@@ -26,6 +42,11 @@ class AuthTokenFlows {
         return this;
     }
 
+    timeout(ms) {
+        this._timeout = ms;
+        return this;
+    }
+
     shouldSucceed(success) {
         this._success = success ?? (function (_, result) {
             throw new Error(`Success called: ${JSON.stringify(result)}`);
@@ -49,9 +70,10 @@ class AuthTokenFlows {
         const before = this._before;
         const success = this._success;
         const failure = this._failure;
+        const timeout = this._timeout;
 
         it(`${this._name}${auth ? ' (with auth token)' : ''}`, async function() {
-            this.timeout(30_000);
+            this.timeout(timeout);
             this.device.useAuthToken(auth);
             const params = { test: this, auth };
             if (before) {
@@ -65,18 +87,7 @@ class AuthTokenFlows {
             // Call action
             const promise = suppressPomiseError(action(params));
             // Read flows
-            const flows = [];
-            for (let i = 0; i < flowsCount; i++) {
-                let flow = await this.screens.readFlow();
-                flows.push(mergePagedScreens(flow));
-                // try to click on "Sign transaction" button first
-                await this.screens.clickOn('Sign transaction');
-                await this.screens.clickOn('Approve');
-                if (i != flowsCount - 1 && await this.screens.isReadyMainScreen()) { // we have more flows
-                    this.screens.removeCurrentScreen(); // Wait for new screen in the readFlow
-                }
-            }
-            params.flows = flows;
+            params.flows = await approveFlows(this.screens, flowsCount);
             // Call success or error
             let result;
             try {
@@ -96,3 +107,4 @@ exports.authTokenFlows = function(name) {
 };
 
 exports.AuthTokenFlows = AuthTokenFlows;
+exports.approveFlows = approveFlows;
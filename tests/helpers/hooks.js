@@ -3,6 +3,10 @@ const HidTransport = require('@ledgerhq/hw-transport-node-hid').default;
 const { ErgoLedgerApp } = require('ledger-ergo-js');
 const SpeculosAutomation = require('./automation').SpeculosAutomation;
 const ScreenReader = require('./screen').ScreenReader;
+const { ApduTraceRecorder, traceFileName } = require('./trace');
+const { readCapabilities } = require('./capabilities');
+const fs = require('fs');
+const path = require('path');
 
 // Use IPV4 by default (for speculos)
 const dns = require('node:dns');
@@ -30,10 +34,33 @@ exports.mochaHooks = {
             this.screens = new ScreenReader(this.automation, this.model);
             this.device = new ErgoLedgerApp(this.transport);
         }
+        // null on apps without INS 0x04, tests of newer protocol variants are skipped then
+        this.capabilities = await readCapabilities(this.transport);
+        const traceDir = process.env.npm_config_trace;
+        if (traceDir) {
+            fs.mkdirSync(traceDir, { recursive: true });
+            this.recorder = new ApduTraceRecorder(this.transport);
+        }
+    },
+    beforeEach: function () {
+        if (this.recorder) {
+            this.recorder.start();
+        }
+    },
+    afterEach: function () {
+        if (this.recorder) {
+            this.recorder.stop();
+            if (this.recorder.records.length > 0) {
+                const file = path.join(process.env.npm_config_trace, traceFileName(this.currentTest));
+                this.recorder.save(file);
+            }
+        }
     },
     afterAll: async function () {
         this.device = undefined;
         this.screens = undefined;
+        this.capabilities = undefined;
+        this.recorder = undefined;
         this.transport.close();
         if (this.automation) {
             this.automation.close();
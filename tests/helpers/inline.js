@@ -0,0 +1,101 @@
+// Inline input boxes of the signing session (INS 0x21, P1 0x1B-0x1E), see doc/INS-21-SIGN-TRANSACTION.md
+
+const CLA = 0xe0;
+const INS_SIGN_TX = 0x21;
+const P1_INPUT_FRAME = 0x12;
+const P1_INLINE_START = 0x1b;
+const P1_INLINE_TREE_CHUNK = 0x1c;
+const P1_INLINE_TOKENS = 0x1d;
+const P1_INLINE_REGISTERS_CHUNK = 0x1e;
+const CHUNK_LEN = 255;
+const TOKENS_PER_CALL = 6;
+const SW_OK = Buffer.from([0x90, 0x00]);
+
+function chunks(data, p1) {
+    const calls = [];
+    for (let offset = 0; offset < data.length; offset += CHUNK_LEN) {
+        calls.push({ p1, data: data.subarray(offset, offset + CHUNK_LEN) });
+    }
+    return calls;
+}
+
+// Calls of the unsigned box, `treeSizeDelta` is added to the Ergo Tree size of the header
+function inlineCalls(box, extensionLength, treeSizeDelta = 0) {
+    const header = Buffer.alloc(59);
+    Buffer.from(box.txId, 'hex').copy(header, 0);
+    header.writeUInt16BE(box.index, 32);
+    header.writeBigUInt64BE(BigInt(box.value), 34);
+    header.writeUInt32BE(box.ergoTree.length + treeSizeDelta, 42);
+    header.writeUInt32BE(box.creationHeight, 46);
+    header.writeUInt8(box.tokens.length, 50);
+    header.writeUInt32BE(box.additionalRegisters.length, 51);
+    header.writeUInt32BE(extensionLength, 55);
+
+    const calls = [{ p1: P1_INLINE_START, data: header }, ...chunks(box.ergoTree, P1_INLINE_TREE_CHUNK)];
+    for (let i = 0; i < box.tokens.length; i += TOKENS_PER_CALL) {
+        const tokens = box.tokens.slice(i, i + TOKENS_PER_CALL).map(token => {
+            const value = Buffer.alloc(8);
+            value.writeBigUInt64BE(BigInt(token.amount));
+            return Buffer.concat([Buffer.from(token.id, 'hex'), value]);
+        });
+        calls.push({ p1: P1_INLINE_TOKENS, data: Buffer.concat(tokens) });
+    }
+    return calls.concat(chunks(box.additionalRegisters, P1_INLINE_REGISTERS_CHUNK));
+}
+
+/**
+ * Sends the given boxes inline in place of their attested frames (P1 0x12) which the client sends,
+ * the context extension chunks of the client follow as usual. Boxes are keyed by the box id hex.
+ * Wraps `exchange` of the transport until `stop` is called.
+ */
+class InlineInputs {
+    constructor(transport, boxes, treeSizeDelta = 0) {
+        this._transport = transport;
+        this._exchange = null;
+        this._boxes = boxes;
+        this.treeSizeDelta = treeSizeDelta;
+        this.calls = 0;
+        this.status = null;  // status word of the failed inline call
+    }
+
+    start() {
+        if (this._exchange) {
+            throw new Error("InlineInputs is already started");
+        }
+        this._exchange = this._transport.exchange;
+        const exchange = this._exchange.bind(this._transport);
+        this._transport.exchange = async (apdu) => {
+            const data = apdu.subarray(5);
+            const box = apdu[1] === INS_SIGN_TX && apdu[2] === P1_INPUT_FRAME
+                ? this._boxes[data.subarray(0, 32).toString('hex')] : undefined;
+            if (!box) {
+                return exchange(apdu);
+            }
+            if (data[33] !== 0) {
+                return SW_OK; // next frames of the inline box aren't needed
+            }
+            const extensionLength = data.readUInt32BE(data.length - 4);
+            for (const call of inlineCalls(box, extensionLength, this.treeSizeDelta)) {
+                const header = Buffer.from([CLA, INS_SIGN_TX, call.p1, apdu[3], call.data.length]);
+                const response = await exchange(Buffer.concat([header, call.data]));
+                this.calls += 1;
+                if (!response.subarray(response.length - 2).equals(SW_OK)) {
+                    this.status = response.readUInt16BE(response.length - 2);
+                    return response;
+                }
+            }
+            return SW_OK;
+        };
+    }
+
+    stop() {
+        if (!this._exchange) {
+            return;
+        }
+        this._transport.exchange = this._exchange;
+        this._exchange = null;
+    }
+}
+
+exports.InlineInputs = InlineInputs;
+exports.inlineCalls = inlineCalls;
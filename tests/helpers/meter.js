@@ -0,0 +1,109 @@
+const INS_ATTEST_INPUT = 0x20;
+const INS_SIGN_TX = 0x21;
+
+// Sign transaction subcommands (P1) grouped into protocol phases
+const SIGN_TX_PHASES = {
+    0x01: 'start',
+    0x0f: 'start',
+    0x10: 'start',
+    0x11: 'tokens',
+    0x12: 'inputs',
+    0x13: 'inputs',
+    0x14: 'dataInputs',
+    0x15: 'outputs',
+    0x16: 'outputs',
+    0x17: 'outputs',
+    0x18: 'outputs',
+    0x19: 'outputs',
+    0x1a: 'outputs',
+    0x1b: 'inputs',
+    0x1c: 'inputs',
+    0x1d: 'inputs',
+    0x1e: 'inputs',
+    0x1f: 'outputs',
+    0x20: 'confirm',
+};
+
+function phaseOf(ins, p1) {
+    switch (ins) {
+        case INS_ATTEST_INPUT:
+            return 'attest';
+        case INS_SIGN_TX:
+            return SIGN_TX_PHASES[p1] ?? 'other';
+        default:
+            return 'other';
+    }
+}
+
+function nowMs() {
+    return Number(process.hrtime.bigint()) / 1e6;
+}
+
+/**
+ * Counts APDUs, bytes and time spent in transport exchanges, grouped by phase.
+ * Wraps `exchange` of the transport instance until `stop` is called.
+ */
+class ApduMeter {
+    constructor(transport) {
+        this._transport = transport;
+        this._exchange = null;
+        this.reset();
+    }
+
+    reset() {
+        this.phases = {};
+        this.startedAt = null;
+        this.finishedAt = null;
+    }
+
+    start() {
+        if (this._exchange) {
+            throw new Error("ApduMeter is already started");
+        }
+        this.reset();
+        this._exchange = this._transport.exchange;
+        const exchange = this._exchange.bind(this._transport);
+        this._transport.exchange = async (apdu) => {
+            const begin = nowMs();
+            const response = await exchange(apdu);
+            this._record(apdu, response, nowMs() - begin);
+            return response;
+        };
+        this.startedAt = nowMs();
+    }
+
+    stop() {
+        if (!this._exchange) {
+            return;
+        }
+        this.finishedAt = nowMs();
+        this._transport.exchange = this._exchange;
+        this._exchange = null;
+    }
+
+    _record(apdu, response, elapsed) {
+        const name = phaseOf(apdu[1], apdu[2]);
+        const phase = this.phases[name] ?? (this.phases[name] = {
+            apdus: 0, bytesOut: 0, bytesIn: 0, timeMs: 0
+        });
+        phase.apdus += 1;
+        phase.bytesOut += apdu.length;
+        phase.bytesIn += response.length;
+        phase.timeMs += elapsed;
+    }
+
+    summary() {
+        const total = { apdus: 0, bytesOut: 0, bytesIn: 0, timeMs: 0 };
+        Object.values(this.phases).forEach(phase => {
+            total.apdus += phase.apdus;
+            total.bytesOut += phase.bytesOut;
+            total.bytesIn += phase.bytesIn;
+            total.timeMs += phase.timeMs;
+        });
+        total.wallTimeMs = (this.finishedAt ?? nowMs()) - this.startedAt;
+        return { phases: this.phases, total };
+    }
+}
+
+exports.ApduMeter = ApduMeter;
+exports.phaseOf = phaseOf;
@@ -0,0 +1,61 @@
+// Client side of the signing session resume (INS 0x21, P1 0x0F), see doc/INS-21-SIGN-TRANSACTION.md
+
+const CLA = 0xe0;
+const INS_SIGN_TX = 0x21;
+const P1_RESUME = 0x0f;
+const SW_OK = Buffer.from([0x90, 0x00]);
+
+function isDataCall(apdu) {
+    return apdu[1] === INS_SIGN_TX && apdu[2] >= 0x10 && apdu[2] <= 0x1f;
+}
+
+/**
+ * Breaks the transport on one data call of the signing session and recovers like a client
+ * after a reconnect: asks the app for the sequence number and skips the acknowledged calls.
+ * With `loseResponse` the call reaches the app and only its response is lost,
+ * otherwise the call itself is lost. Wraps `exchange` of the transport until `stop` is called.
+ */
+class SessionInterrupter {
+    constructor(transport, failAt, loseResponse) {
+        this._transport = transport;
+        this._exchange = null;
+        this.failAt = failAt;
+        this.loseResponse = loseResponse;
+        this.sent = 0;
+        this.sequence = null;
+    }
+
+    start() {
+        if (this._exchange) {
+            throw new Error("SessionInterrupter is already started");
+        }
+        this._exchange = this._transport.exchange;
+        const exchange = this._exchange.bind(this._transport);
+        this._transport.exchange = async (apdu) => {
+            if (!isDataCall(apdu) || this.sent++ !== this.failAt) {
+                return exchange(apdu);
+            }
+            if (this.loseResponse) {
+                await exchange(apdu);
+            }
+            const session = apdu[3];
+            const response = await exchange(Buffer.from([CLA, INS_SIGN_TX, P1_RESUME, session, 0x00]));
+            if (!response.subarray(response.length - 2).equals(SW_OK)) {
+                return response; // session is lost, the error goes to the caller
+            }
+            this.sequence = response.readUInt16BE(0);
+            // acknowledged call isn't repeated, it would terminate the session
+            return this.sequence === this.sent ? SW_OK : exchange(apdu);
+        };
+    }
+
+    stop() {
+        if (!this._exchange) {
+            return;
+        }
+        this._transport.exchange = this._exchange;
+        this._exchange = null;
+    }
+}
+
+exports.SessionInterrupter = SessionInterrupter;
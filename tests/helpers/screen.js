@@ -9,6 +9,7 @@ const MAIN_FLOW = [
 
 const SETTINGS_FLOW = [
     { header: "Blind signing", body: "Enable transactionblind signing.Enabled" },
+    { header: "Trusted apps", body: "Remember approvedapplications.Disabled" },
     { header: null, body: "Back" }
 ];
 
@@ -151,6 +152,21 @@ class ScreenReader {
         return true;
     }
 
+    // Switches "Trusted apps" in the settings and goes back to the main menu.
+    // Disabling forgets all the remembered applications.
+    async setTrustedApps(enabled) {
+        if (!await this.ensureMainMenu()) {
+            throw new Error("Main menu isn't displayed");
+        }
+        await this.click(1);
+        const settings = await this.readFlow();
+        if (settings[1].body.endsWith(enabled ? "Disabled" : "Enabled")) {
+            await this.click(1);
+            await this.readFlow();
+        }
+        await this.clickOn("Back");
+    }
+
     currentScreen() {
         return this._currentScreen.promise;
     }
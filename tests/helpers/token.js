@@ -0,0 +1,47 @@
+// Input attestation without the auth token (INS 0x20, P1 0x01), see doc/INS-20-ATTEST-BOX.md
+
+const INS_ATTEST_INPUT = 0x20;
+const P1_BOX_START = 0x01;
+const P2_WITHOUT_TOKEN = 0x01;
+const P2_WITH_TOKEN = 0x02;
+const TOKEN_LEN = 4;
+
+/**
+ * Drops the auth token of the client from the "Box start" calls, so only the signing session
+ * carries the token and approved attestations don't make it known to the app.
+ * Wraps `exchange` of the transport until `stop` is called.
+ */
+class TokenlessAttestation {
+    constructor(transport) {
+        this._transport = transport;
+        this._exchange = null;
+        this.stripped = 0; // "Box start" calls sent without the token
+    }
+
+    start() {
+        if (this._exchange) {
+            throw new Error("TokenlessAttestation is already started");
+        }
+        this._exchange = this._transport.exchange;
+        const exchange = this._exchange.bind(this._transport);
+        this._transport.exchange = async (apdu) => {
+            if (apdu[1] !== INS_ATTEST_INPUT || apdu[2] !== P1_BOX_START || apdu[3] !== P2_WITH_TOKEN) {
+                return exchange(apdu);
+            }
+            this.stripped += 1;
+            const header = Buffer.from([apdu[0], INS_ATTEST_INPUT, P1_BOX_START, P2_WITHOUT_TOKEN,
+                                        apdu[4] - TOKEN_LEN]);
+            return exchange(Buffer.concat([header, apdu.subarray(5, apdu.length - TOKEN_LEN)]));
+        };
+    }
+
+    stop() {
+        if (!this._exchange) {
+            return;
+        }
+        this._transport.exchange = this._exchange;
+        this._exchange = null;
+    }
+}
+
+exports.TokenlessAttestation = TokenlessAttestation;
@@ -0,0 +1,70 @@
+const fs = require('fs');
+
+// Trace format (all integers are big-endian):
+//   magic "EAPT" | version (1 byte) | records...
+//   record: command length (2 bytes) | command | response length (2 bytes) | response data || SW
+// Replayed by fuzzing/src/apdu_replay.c
+const TRACE_MAGIC = Buffer.from('EAPT', 'ascii');
+const TRACE_VERSION = 1;
+
+function lengthPrefixed(data) {
+    const len = Buffer.alloc(2);
+    len.writeUInt16BE(data.length);
+    return [len, Buffer.from(data)];
+}
+
+/**
+ * Records every APDU exchanged through the transport with its response and status word.
+ * Wraps `exchange` of the transport instance until `stop` is called.
+ */
+class ApduTraceRecorder {
+    constructor(transport) {
+        this._transport = transport;
+        this._exchange = null;
+        this.records = [];
+    }
+
+    start() {
+        if (this._exchange) {
+            throw new Error("ApduTraceRecorder is already started");
+        }
+        this.records = [];
+        this._exchange = this._transport.exchange;
+        const exchange = this._exchange.bind(this._transport);
+        this._transport.exchange = async (apdu) => {
+            const response = await exchange(apdu);
+            this.records.push({ command: Buffer.from(apdu), response: Buffer.from(response) });
+            return response;
+        };
+    }
+
+    stop() {
+        if (!this._exchange) {
+            return;
+        }
+        this._transport.exchange = this._exchange;
+        this._exchange = null;
+    }
+
+    toBuffer() {
+        const chunks = [TRACE_MAGIC, Buffer.from([TRACE_VERSION])];
+        this.records.forEach(record => {
+            chunks.push(...lengthPrefixed(record.command), ...lengthPrefixed(record.response));
+        });
+        return Buffer.concat(chunks);
+    }
+
+    save(path) {
+        fs.writeFileSync(path, this.toBuffer());
+    }
+}
+
+/**
+ * File name for a test trace.
+ */
+function traceFileName(test) {
+    return test.fullTitle().replace(/[^a-zA-Z0-9_-]+/g, '_').slice(0, 200) + '.trace';
+}
+
+exports.ApduTraceRecorder = ApduTraceRecorder;
+exports.traceFileName = traceFileName;
@@ -100,12 +100,21 @@ class ErgoTxBuilder {
         return this;
     }
 
-    output(address, value, send_tokens, mint_token_amount) {
+    output(address, value, send_tokens, mint_token_amount, registers) {
         const builder = new ergo.ErgoBoxCandidateBuilder(
             ergo.BoxValue.from_i64(ergo.I64.from_str(value)),
             ergo.Contract.pay_to_address(address),
             0
         );
+        if (registers) {
+            // Coll[Byte] values starting from R4
+            registers.forEach((bytes, idx) => {
+                builder.set_register_value(
+                    ergo.NonMandatoryRegisterId.R4 + idx,
+                    ergo.Constant.from_byte_array(bytes)
+                );
+            });
+        }
         if (send_tokens) {
             send_tokens.forEach(t => {
                 builder.add_token(
@@ -25,5 +25,50 @@ describe("Public Key Tests", function () {
                 });
             })
             .run(({test, account}) => test.device.getExtendedPublicKey(account.path.toString()));
+
+        authTokenFlows("can get extended public keys of account range")
+            .init(async ({test, auth}) => {
+                const account = TEST_DATA.account;
+                const count = 4;
+                const flow = [{ header: null, body: 'Ext PubKeys Export' },
+                              { header: 'Path', body: `44'/429'/0'-${count - 1}'` }];
+                if (auth) {
+                    flow.push({ header: 'Application', body: getApplication(test.device) });
+                }
+                flow.push({ header: null, body: 'Approve' }, { header: null, body: 'Reject' });
+                return { account, count, flow, flowsCount: 1 };
+            })
+            .shouldSucceed(({flow, flows, account, count}, keys) => {
+                expect(flows[0]).to.be.deep.equal(flow);
+                expect(keys).to.have.lengthOf(count);
+                expect(keys[0]).to.be.deep.equal({
+                    publicKey: toHex(account.publicKey.pub_key_bytes()),
+                    chainCode: toHex(account.publicKey.chain_code()),
+                });
+                expect(new Set(keys.map((key) => key.publicKey)).size).to.be.equal(count);
+            })
+            .run(async ({test, auth, count}) => {
+                // 44'/429'/0'
+                const data = [Buffer.from('038000002c800001ad80000000', 'hex'), Buffer.from([count])];
+                if (auth) {
+                    const token = Buffer.alloc(4);
+                    token.writeUInt32BE(test.device.authToken);
+                    data.push(token);
+                }
+                const chunks = [await test.transport.send(0xe0, 0x10, auth ? 0x02 : 0x01, 0x01,
+                                                          Buffer.concat(data))];
+                while (chunks.reduce((len, chunk) => len + chunk.length - 2, 0) < count * 65) {
+                    chunks.push(await test.transport.send(0xe0, 0x10, 0x01, 0x02));
+                }
+                const response = Buffer.concat(chunks.map((chunk) => chunk.subarray(0, -2)));
+                const keys = [];
+                for (let i = 0; i < response.length; i += 65) {
+                    keys.push({
+                        publicKey: toHex(response.subarray(i, i + 33)),
+                        chainCode: toHex(response.subarray(i + 33, i + 65)),
+                    });
+                }
+                return keys;
+            });
     });
 });
@@ -2,11 +2,51 @@ const { expect } = require('chai').use(require('chai-bytes'));
 const { Transaction, ErgoBox } = require('ergo-lib-wasm-nodejs');
 const { toNetwork, getApplication, removeMasterNode, ellipsize } = require('./helpers/common');
 const { TEST_DATA } = require('./helpers/data');
-const { authTokenFlows } = require('./helpers/flow');
+const { authTokenFlows, approveFlows } = require('./helpers/flow');
 const { TxBuilder } = require('./helpers/transaction');
+const { SessionInterrupter } = require('./helpers/resume');
+const { InlineInputs } = require('./helpers/inline');
+const { ChangePaths } = require('./helpers/change');
+const { TokenlessAttestation } = require('./helpers/token');
+const { mergePagedScreens } = require('./helpers/screen');
+const { Feature, requireFeature } = require('./helpers/capabilities');
 
 const txId = "0000000000000000000000000000000000000000000000000000000000000000";
 
+// Distinct token ids, split between boxes as a box can't have more than 122 tokens
+function manyTokens(count, boxSize) {
+    const tokens = [...Array(count).keys()].map(i => ({
+        id: (i + 1).toString(16).padStart(64, 'b'),
+        amount: (i + 1).toString()
+    }));
+    const boxes = [];
+    for (let i = 0; i < count; i += boxSize) {
+        boxes.push(tokens.slice(i, i + boxSize));
+    }
+    return { tokens, boxes };
+}
+
+function tokenScreens(model, tokens) {
+    return tokens.flatMap((token, i) => [
+        { header: `Token [${i + 1}]`, body: ellipsize(model, token.id.toUpperCase()) },
+        { header: `Token [${i + 1}] Raw Value`, body: token.amount }
+    ]);
+}
+
+function boxesById(uInputs, appTx, indexes) {
+    return Object.fromEntries(indexes.map(i => [uInputs[i].box_id().to_str(), appTx.inputs[i]]));
+}
+
+// Signs with the transport exchange wrapped by `wrapper` (InlineInputs, ChangePaths)
+async function signWrapped(test, appTx, wrapper) {
+    wrapper.start();
+    try {
+        return await test.device.signTx(appTx, toNetwork(TEST_DATA.network));
+    } finally {
+        wrapper.stop();
+    }
+}
+
 function signTxFlows({ device }, auth, from, to, change, is_blind, tokens_to = undefined, tokens_tx = undefined, script_hash = undefined) {
     let i = 0;
     const flows = [];
@@ -110,6 +150,42 @@ describe("Transaction Tests", function () {
             })
             .run(({test, appTx, network}) => test.device.signTx(appTx, toNetwork(network)));
 
+        [false, true].forEach(loseResponse => {
+            authTokenFlows(`can resume tx signing after a lost ${loseResponse ? 'response' : 'call'}`)
+                .init(async ({test, auth}) => {
+                    requireFeature(test, Feature.SessionResume);
+                    const from = TEST_DATA.address0;
+                    const to = TEST_DATA.address1;
+                    const change = TEST_DATA.changeAddress;
+                    const {appTx, ergoTx, uInputs} = new TxBuilder()
+                        .input(from, txId, 0, '1000000000')
+                        .dataInput(from.address, txId, 0)
+                        .output(to.address, '100000000')
+                        .fee('1000000')
+                        .change(change)
+                        .build();
+                    const expectedFlows = signTxFlows(test, auth, from, to, change, false);
+                    // data call before the outputs, its response is sent right away
+                    const interrupter = new SessionInterrupter(test.transport, 2, loseResponse);
+                    return { appTx, ergoTx, input: uInputs[0], interrupter,
+                             expectedFlows, flowsCount: expectedFlows.length };
+                })
+                .shouldSucceed(({ergoTx, input, expectedFlows, flows, interrupter}, signatures) => {
+                    expect(flows).to.be.deep.equal(expectedFlows);
+                    expect(interrupter.sequence).to.be.equal(loseResponse ? 3 : 2);
+                    expect(signatures).to.have.length(1);
+                    verifySignatures(ergoTx, signatures, input);
+                })
+                .run(async ({test, appTx, interrupter}) => {
+                    interrupter.start();
+                    try {
+                        return await test.device.signTx(appTx, toNetwork(TEST_DATA.network));
+                    } finally {
+                        interrupter.stop();
+                    }
+                });
+        });
+
         authTokenFlows("can blind sign tx")
             .init(async ({test, auth}) => {
                 const from = TEST_DATA.address0;
@@ -377,5 +453,277 @@ describe("Transaction Tests", function () {
                 verifySignatures(ergoTx, signatures, input);
             })
             .run(({test, appTx}) => test.device.signTx(appTx, toNetwork(TEST_DATA.network)));
+
+        authTokenFlows("can sign tx with 255 tokens")
+            .timeout(600_000)
+            .init(async ({test, auth}) => {
+                if (!test.capabilities || test.capabilities.limits.tokens < 255) {
+                    test.skip(); // model is built with fewer tokens
+                }
+                const from = TEST_DATA.address0;
+                const to = TEST_DATA.address1;
+                const change = TEST_DATA.changeAddress;
+                const { tokens, boxes } = manyTokens(255, 85);
+                const values = ['33333334', '33333333', '33333333'];
+                const builder = new TxBuilder();
+                boxes.forEach((box, i) => builder.input(from, txId, i, '1000000000', box));
+                builder.dataInput(from.address, txId, 0);
+                // outputs to the same address are reviewed as one destination with 510 token screens
+                boxes.forEach((box, i) => builder.output(to.address, values[i], box));
+                const {appTx, ergoTx, uInputs} = builder.fee('1000000').change(change).build();
+                const [attestFlow, reviewFlow] = signTxFlows(test, auth, from, to, change, false,
+                                                             tokenScreens(test.model, tokens));
+                const expectedFlows = [...boxes.map(() => attestFlow), reviewFlow];
+                return { appTx, ergoTx, inputs: uInputs,
+                         expectedFlows, flowsCount: expectedFlows.length };
+            })
+            .shouldSucceed(({flows, expectedFlows, ergoTx, inputs}, signatures) => {
+                expect(flows).to.be.deep.equal(expectedFlows);
+                expect(signatures).to.have.length(inputs.length);
+                inputs.forEach(input => verifySignatures(ergoTx, signatures, input));
+            })
+            .run(({test, appTx}) => test.device.signTx(appTx, toNetwork(TEST_DATA.network)));
+    });
+
+    context("Inline Input Boxes", function () {
+        authTokenFlows("can sign tx with inline input box")
+            .init(async ({test, auth}) => {
+                requireFeature(test, Feature.InlineInputBoxes);
+                const from = TEST_DATA.address0;
+                const to = TEST_DATA.address1;
+                const change = TEST_DATA.changeAddress;
+                const {appTx, ergoTx, uInputs} = new TxBuilder()
+                    .input(from, txId, 0, '1000000000')
+                    .dataInput(from.address, txId, 0)
+                    .output(to.address, '100000000')
+                    .fee('1000000')
+                    .change(change)
+                    .build();
+                const inline = new InlineInputs(test.transport, boxesById(uInputs, appTx, [0]));
+                const expectedFlows = signTxFlows(test, auth, from, to, change, false);
+                return { appTx, ergoTx, input: uInputs[0], inline,
+                         expectedFlows, flowsCount: expectedFlows.length };
+            })
+            .shouldSucceed(({ergoTx, input, inline, flows, expectedFlows}, signatures) => {
+                expect(flows).to.be.deep.equal(expectedFlows);
+                // start and tree chunk
+                expect(inline.calls).to.be.equal(2);
+                expect(signatures).to.have.length(1);
+                verifySignatures(ergoTx, signatures, input);
+            })
+            .run(({test, appTx, inline}) => signWrapped(test, appTx, inline));
+
+        authTokenFlows("can sign tx with inline input box split in chunks")
+            .init(async ({test, auth}) => {
+                requireFeature(test, Feature.InlineInputBoxes);
+                const from = TEST_DATA.addressScript;
+                const to = TEST_DATA.address1;
+                const change = TEST_DATA.changeAddress;
+                const { tokens } = manyTokens(8, 8);
+                const {appTx, ergoTx, uInputs} = new TxBuilder()
+                    .input(from, txId, 0, '1000000000', tokens)
+                    .dataInput(from.address, txId, 0)
+                    .output(to.address, '100000000', tokens)
+                    .fee('1000000')
+                    .change(change)
+                    .build();
+                const box = appTx.inputs[0];
+                const inline = new InlineInputs(test.transport, boxesById(uInputs, appTx, [0]));
+                const expectedFlows = signTxFlows(test, auth, from, to, change, false,
+                                                  tokenScreens(test.model, tokens));
+                return { appTx, ergoTx, box, inline,
+                         expectedFlows, flowsCount: expectedFlows.length };
+            })
+            .shouldSucceed(({box, inline, flows, expectedFlows}, signatures) => {
+                expect(flows).to.be.deep.equal(expectedFlows);
+                // Ergo Tree in 255 bytes chunks, 6 tokens per call
+                const treeChunks = Math.ceil(box.ergoTree.length / 255);
+                expect(treeChunks).to.be.above(1);
+                expect(inline.calls).to.be.equal(1 + treeChunks + 2);
+                expect(signatures).to.have.length(1);
+            })
+            .run(({test, appTx, inline}) => signWrapped(test, appTx, inline));
+
+        authTokenFlows("can not sign tx with inline input box of wrong tree size")
+            .init(async ({test, auth}) => {
+                requireFeature(test, Feature.InlineInputBoxes);
+                const from = TEST_DATA.address0;
+                const {appTx, uInputs} = new TxBuilder()
+                    .input(from, txId, 0, '1000000000')
+                    .dataInput(from.address, txId, 0)
+                    .output(TEST_DATA.address1.address, '100000000')
+                    .fee('1000000')
+                    .change(TEST_DATA.changeAddress)
+                    .build();
+                // tree chunk is one byte longer than the header says
+                const inline = new InlineInputs(test.transport, boxesById(uInputs, appTx, [0]), -1);
+                const expectedFlows = signTxFlows(test, auth, from, null, null, false);
+                return { appTx, inline, expectedFlows, flowsCount: expectedFlows.length };
+            })
+            .shouldFail(({inline, flows, expectedFlows}, error) => {
+                expect(flows).to.be.deep.equal(expectedFlows);
+                expect(error).to.be.an('error');
+                expect(error.name).to.be.equal('DeviceError');
+                expect(inline.status).to.be.equal(0xe015);
+            })
+            .run(({test, appTx, inline}) => signWrapped(test, appTx, inline));
+
+        authTokenFlows("can sign tx with inline and attested input boxes")
+            .init(async ({test, auth}) => {
+                requireFeature(test, Feature.InlineInputBoxes);
+                const from = TEST_DATA.address0;
+                const to = TEST_DATA.address1;
+                const change = TEST_DATA.changeAddress;
+                const { tokens } = manyTokens(2, 2);
+                // both boxes are needed for the amount
+                const {appTx, ergoTx, uInputs} = new TxBuilder()
+                    .input(from, txId, 0, '60000000')
+                    .input(from, txId, 1, '60000000', tokens)
+                    .dataInput(from.address, txId, 0)
+                    .output(to.address, '100000000', tokens)
+                    .fee('1000000')
+                    .change(change)
+                    .build();
+                const inlineIndex = uInputs.findIndex(box => box.tokens().len() > 0);
+                const inline = new InlineInputs(test.transport, boxesById(uInputs, appTx, [inlineIndex]));
+                const [attestFlow, reviewFlow] = signTxFlows(test, auth, from, to, change, false,
+                                                             tokenScreens(test.model, tokens));
+                const expectedFlows = [attestFlow, attestFlow, reviewFlow];
+                return { appTx, ergoTx, inputs: uInputs, inline,
+                         expectedFlows, flowsCount: expectedFlows.length };
+            })
+            .shouldSucceed(({ergoTx, inputs, inline, flows, expectedFlows}, signatures) => {
+                expect(flows).to.be.deep.equal(expectedFlows);
+                // start, tree chunk and tokens of the inline box
+                expect(inline.calls).to.be.equal(3);
+                expect(signatures).to.have.length(2);
+                inputs.forEach(input => verifySignatures(ergoTx, signatures, input));
+            })
+            .run(({test, appTx, inline}) => signWrapped(test, appTx, inline));
+    });
+
+    context("Registered Change Paths", function () {
+        authTokenFlows("can sign tx with registered change path")
+            .init(async ({test, auth}) => {
+                requireFeature(test, Feature.ChangePaths);
+                const from = TEST_DATA.address0;
+                const to = TEST_DATA.address1;
+                const change = TEST_DATA.changeAddress;
+                const {appTx, ergoTx, uInputs} = new TxBuilder()
+                    .input(from, txId, 0, '1000000000')
+                    .dataInput(from.address, txId, 0)
+                    .output(to.address, '100000000')
+                    .fee('1000000')
+                    .change(change)
+                    .build();
+                // registering the same path again returns its index
+                const paths = [[change.acc_index, change.addr_index], [0, 22],
+                               [change.acc_index, change.addr_index]];
+                const changePaths = new ChangePaths(test.transport, paths);
+                const expectedFlows = signTxFlows(test, auth, from, to, change, false);
+                return { appTx, ergoTx, input: uInputs[0], changePaths,
+                         expectedFlows, flowsCount: expectedFlows.length };
+            })
+            .shouldSucceed(({ergoTx, input, changePaths, flows, expectedFlows}, signatures) => {
+                expect(flows).to.be.deep.equal(expectedFlows);
+                expect(changePaths.indexes).to.be.deep.equal([0, 1, 0]);
+                // change tree is sent as a 1-byte index
+                expect(changePaths.indexed).to.be.equal(1);
+                expect(signatures).to.have.length(1);
+                verifySignatures(ergoTx, signatures, input);
+            })
+            .run(({test, appTx, changePaths}) => signWrapped(test, appTx, changePaths));
+
+        authTokenFlows("can not register too many change paths")
+            .init(async ({test, auth}) => {
+                requireFeature(test, Feature.ChangePaths);
+                const from = TEST_DATA.address0;
+                const {appTx} = new TxBuilder()
+                    .input(from, txId, 0, '1000000000')
+                    .dataInput(from.address, txId, 0)
+                    .output(TEST_DATA.address1.address, '100000000')
+                    .fee('1000000')
+                    .change(TEST_DATA.changeAddress)
+                    .build();
+                // one more than the registry of the app holds
+                const count = test.capabilities.limits.changePaths;
+                const paths = [...Array(count + 1).keys()].map(i => [0, i + 1]);
+                const changePaths = new ChangePaths(test.transport, paths);
+                const expectedFlows = signTxFlows(test, auth, from, null, null, false);
+                return { appTx, changePaths, count, expectedFlows, flowsCount: expectedFlows.length };
+            })
+            .shouldFail(({changePaths, count, flows, expectedFlows}, error) => {
+                expect(flows).to.be.deep.equal(expectedFlows);
+                expect(error).to.be.an('error');
+                expect(error.name).to.be.equal('DeviceError');
+                expect(changePaths.indexes).to.be.deep.equal([...Array(count).keys()]);
+                expect(changePaths.status).to.be.equal(0xe01b);
+            })
+            .run(({test, appTx, changePaths}) => signWrapped(test, appTx, changePaths));
+    });
+
+    context("Trusted Applications", function () {
+        // 44'/429'/0'
+        const accountPath = Buffer.from('038000002c800001ad80000000', 'hex');
+
+        it("does not trust the app token of a rejected transaction", async function () {
+            requireFeature(this, Feature.TrustedApps);
+            if (!this.screens) {
+                this.skip();
+            }
+            this.timeout(60_000);
+            this.device.useAuthToken(true);
+            const application = { header: 'Application', body: getApplication(this.device) };
+            const token = Buffer.alloc(4);
+            token.writeUInt32BE(this.device.authToken);
+            await this.screens.setTrustedApps(true);
+            try {
+                const {appTx} = new TxBuilder()
+                    .input(TEST_DATA.address0, txId, 0, '1000000000')
+                    .dataInput(TEST_DATA.address0.address, txId, 0)
+                    .output(TEST_DATA.address1.address, '100000000')
+                    .fee('1000000')
+                    .change(TEST_DATA.changeAddress)
+                    .build();
+                // only the signing session carries the token, the attestation is approved without it
+                const attestation = new TokenlessAttestation(this.transport);
+                this.screens.removeCurrentScreen();
+                const signing = signWrapped(this, appTx, attestation).then(() => null, (error) => error);
+                const [attestFlow] = await approveFlows(this.screens, 1);
+                if (await this.screens.isReadyMainScreen()) {
+                    this.screens.removeCurrentScreen();
+                }
+                const reviewFlow = mergePagedScreens(await this.screens.readFlow());
+                await this.screens.clickOn('Reject');
+                const error = await signing;
+                expect(attestation.stripped).to.be.equal(1);
+                expect(attestFlow).to.not.deep.include(application);
+                expect(reviewFlow).to.deep.include(application);
+                expect(error).to.be.an('error');
+                expect(error.name).to.be.equal('DeviceError');
+
+                // tokenless export replaces the token of the session
+                this.screens.removeCurrentScreen();
+                const tokenless = this.transport.send(0xe0, 0x10, 0x01, 0x00, accountPath);
+                await approveFlows(this.screens, 1);
+                await tokenless;
+
+                // the token isn't remembered, so it has to be approved again
+                this.screens.removeCurrentScreen();
+                const exporting = this.transport.send(0xe0, 0x10, 0x02, 0x00,
+                                                      Buffer.concat([accountPath, token]),
+                                                      [0x9000, 0x6985]);
+                const shown = await Promise.race([this.screens.currentScreen().then(() => true),
+                                                  exporting.then(() => false)]);
+                expect(shown).to.be.true;
+                const exportFlow = mergePagedScreens(await this.screens.readFlow());
+                await this.screens.clickOn('Reject');
+                const response = await exporting;
+                expect(exportFlow).to.deep.include(application);
+                expect(response.readUInt16BE(response.length - 2)).to.be.equal(0x6985);
+            } finally {
+                await this.screens.setTrustedApps(false);
+            }
+        });
     });
 });
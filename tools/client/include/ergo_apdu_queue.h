@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ergo_transport.h"
+
+#define APDU_CLA    0xE0
+#define APDU_SW_OK  0x9000
+#define APDU_HEADER 5
+
+/**
+ * Client errors. Positive results of the client calls are status words of the app.
+ */
+typedef enum {
+    ERGO_CLIENT_OK = 0,
+    ERGO_CLIENT_ERR_IO = -1,       /// transport failure
+    ERGO_CLIENT_ERR_PARAM = -2,    /// request can't be encoded
+    ERGO_CLIENT_ERR_RESPONSE = -3  /// unexpected response data
+} ergo_client_error_e;
+
+/**
+ * Flags of the queued command.
+ */
+typedef enum {
+    APDU_FLAG_SESSION_P2 = 0x01  /// P2 is replaced with the queue session id when sent
+} apdu_flag_e;
+
+typedef struct {
+    uint8_t data[APDU_MAX_COMMAND_LEN];
+    size_t len;
+    uint8_t flags;
+} apdu_command_t;
+
+typedef struct {
+    uint8_t data[APDU_MAX_RESPONSE_LEN - 2];
+    size_t len;
+    uint16_t sw;
+} apdu_response_t;
+
+/**
+ * Encodes the next command of the flow.
+ *
+ * @return 1 if the command is encoded, 0 if the flow is finished, negative integer on error.
+ */
+typedef int (*apdu_producer_fn)(void *ctx, apdu_command_t *command);
+
+/**
+ * Handles the successful response of the command.
+ *
+ * @return false to stop the flow with ERGO_CLIENT_ERR_RESPONSE.
+ */
+typedef bool (*apdu_consumer_fn)(void *ctx,
+                                 const apdu_command_t *command,
+                                 const apdu_response_t *response);
+
+/**
+ * Pipelined APDU queue. The next command is encoded while the response of the
+ * current one is awaited, so the app never waits for the host encoding.
+ * Commands which depend on the session id returned by the app are queued with
+ * APDU_FLAG_SESSION_P2, the id is patched in at send time.
+ */
+typedef struct {
+    ergo_transport_t *transport;
+    apdu_command_t slots[2];
+    uint8_t session;     // session id set by the consumer
+    uint16_t last_sw;    // SW of the last response
+    uint32_t commands;   // commands sent
+    uint64_t bytes_out;  // command bytes sent
+    uint64_t bytes_in;   // response bytes received
+} apdu_queue_t;
+
+void apdu_queue_init(apdu_queue_t *queue, ergo_transport_t *transport);
+
+/**
+ * Runs the flow until the producer is finished or the app returns an error.
+ *
+ * @return 0 if success, the status word if the app rejected a command,
+ *   negative ERGO_CLIENT_ERR_* otherwise.
+ */
+int apdu_queue_run(apdu_queue_t *queue,
+                   apdu_producer_fn produce,
+                   apdu_consumer_fn consume,
+                   void *ctx);
+
+/**
+ * Starts encoding of the command.
+ */
+void apdu_command_init(apdu_command_t *command,
+                       uint8_t ins,
+                       uint8_t p1,
+                       uint8_t p2,
+                       uint8_t flags);
+
+/**
+ * Appends data to the command, updates Lc.
+ *
+ * @return false if the data doesn't fit.
+ */
+bool apdu_command_append(apdu_command_t *command, const uint8_t *data, size_t len);
+bool apdu_command_append_u8(apdu_command_t *command, uint8_t value);
+bool apdu_command_append_u16(apdu_command_t *command, uint16_t value);
+bool apdu_command_append_u32(apdu_command_t *command, uint32_t value);
+bool apdu_command_append_u64(apdu_command_t *command, uint64_t value);
+
+/**
+ * Free space of the command data.
+ */
+static inline size_t apdu_command_space(const apdu_command_t *command) {
+    return APDU_MAX_COMMAND_LEN - command->len;
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ergo_apdu_queue.h"
+#include "ergo_transport.h"
+
+#define ERGO_ID_LEN                 32
+#define ERGO_MAX_BIP32_PATH         10
+#define ERGO_EXT_PUB_KEY_LEN        65
+#define ERGO_ADDRESS_LEN            38
+#define ERGO_SIGNATURE_LEN          56
+#define ERGO_APP_VERSION_LEN        4
+#define ERGO_INPUT_FRAME_MAX_LEN    255
+#define ERGO_FRAME_MAX_TOKENS_COUNT 4
+#define ERGO_EXT_PUB_KEY_RANGE_MAX  20
+
+/**
+ * Instructions of the app.
+ */
+typedef enum {
+    ERGO_INS_GET_APP_VERSION = 0x01,
+    ERGO_INS_GET_APP_NAME = 0x02,
+    ERGO_INS_GET_APP_LIMITS = 0x03,
+    ERGO_INS_GET_APP_CAPABILITIES = 0x04,
+    ERGO_INS_GET_EXTENDED_PUBLIC_KEY = 0x10,
+    ERGO_INS_DERIVE_ADDRESS = 0x11,
+    ERGO_INS_ATTEST_INPUT_BOX = 0x20,
+    ERGO_INS_SIGN_TRANSACTION = 0x21
+} ergo_ins_e;
+
+typedef struct {
+    uint8_t len;
+    uint32_t path[ERGO_MAX_BIP32_PATH];
+} ergo_bip32_path_t;
+
+typedef struct {
+    uint8_t id[ERGO_ID_LEN];
+    uint64_t amount;
+} ergo_token_t;
+
+/**
+ * Box with its transaction reference, as attested or sent inline.
+ */
+typedef struct {
+    uint8_t tx_id[ERGO_ID_LEN];
+    uint16_t index;
+    uint64_t value;
+    uint32_t creation_height;
+    const uint8_t *ergo_tree;
+    uint32_t ergo_tree_len;
+    const ergo_token_t *tokens;
+    uint8_t tokens_count;
+    const uint8_t *registers;
+    uint32_t registers_len;
+} ergo_box_t;
+
+/**
+ * Attested box frame as returned by the app.
+ */
+typedef struct {
+    uint8_t data[ERGO_INPUT_FRAME_MAX_LEN];
+    uint8_t len;
+} ergo_input_frame_t;
+
+/**
+ * Transaction input. Either attested frames or the inline box are sent.
+ */
+typedef struct {
+    const ergo_input_frame_t *frames;  // attested frames, NULL to send the box inline
+    uint8_t frames_count;
+    const ergo_box_t *box;  // inline box
+    const uint8_t *extension;
+    uint32_t extension_len;
+} ergo_input_t;
+
+typedef enum {
+    ERGO_OUTPUT_TREE,        /// ergo tree sent in chunks
+    ERGO_OUTPUT_MINERS_FEE,  /// miners fee tree of the network
+    ERGO_OUTPUT_CHANGE       /// change tree of the registered change path
+} ergo_output_kind_e;
+
+typedef struct {
+    uint32_t index;  // index in the transaction token ids
+    uint64_t amount;
+} ergo_output_token_t;
+
+typedef struct {
+    uint64_t value;
+    uint32_t creation_height;
+    ergo_output_kind_e kind;
+    const uint8_t *ergo_tree;  // ERGO_OUTPUT_TREE
+    uint32_t ergo_tree_len;
+    uint8_t change_path;  // ERGO_OUTPUT_CHANGE: index in change_paths of the request
+    const ergo_output_token_t *tokens;
+    uint8_t tokens_count;
+    const uint8_t *registers;
+    uint32_t registers_len;
+} ergo_output_t;
+
+/**
+ * Transaction to sign with the P2PK key of the path.
+ */
+typedef struct {
+    uint8_t network;
+    ergo_bip32_path_t path;
+    bool has_auth_token;
+    uint32_t auth_token;
+    const ergo_bip32_path_t *change_paths;  // registered once, outputs refer to them by index
+    uint8_t change_paths_count;
+    const uint8_t (*token_ids)[ERGO_ID_LEN];
+    uint16_t token_ids_count;
+    const ergo_input_t *inputs;
+    uint16_t inputs_count;
+    const uint8_t (*data_inputs)[ERGO_ID_LEN];
+    uint16_t data_inputs_count;
+    const ergo_output_t *outputs;
+    uint16_t outputs_count;
+} ergo_sign_request_t;
+
+typedef struct {
+    apdu_queue_t queue;
+} ergo_client_t;
+
+/**
+ * All the calls below return 0 if success, the status word if the app rejected
+ * a command (e.g. 0x6985 if the user denied), negative ERGO_CLIENT_ERR_* otherwise.
+ * Calls are blocking, the client isn't thread safe.
+ */
+
+void ergo_client_init(ergo_client_t *client, ergo_transport_t *transport);
+
+int ergo_client_get_version(ergo_client_t *client, uint8_t version[ERGO_APP_VERSION_LEN]);
+
+/**
+ * Gets app name as NUL terminated string.
+ */
+int ergo_client_get_app_name(ergo_client_t *client, char *name, size_t size);
+
+/**
+ * Gets raw response of INS 0x03 (limits) or 0x04 (capabilities).
+ */
+int ergo_client_get_app_info(ergo_client_t *client,
+                             ergo_ins_e ins,
+                             uint8_t *data,
+                             size_t size,
+                             size_t *len);
+
+/**
+ * Gets extended public key (compressed public key and chain code) of the path.
+ *
+ * @param[in] auth_token
+ *   Authorization token, NULL to send none.
+ */
+int ergo_client_get_ext_pubkey(ergo_client_t *client,
+                               const ergo_bip32_path_t *path,
+                               const uint32_t *auth_token,
+                               uint8_t ext_pubkey[ERGO_EXT_PUB_KEY_LEN]);
+
+/**
+ * Gets extended public keys of consecutive accounts m/44'/429'/first'-(first+count-1)'
+ * after a single approval.
+ *
+ * @param[in] first_account
+ *   Account index without the hardened bit.
+ * @param[in] count
+ *   Accounts count, up to ERGO_EXT_PUB_KEY_RANGE_MAX.
+ */
+int ergo_client_get_ext_pubkeys_range(ergo_client_t *client,
+                                      uint32_t first_account,
+                                      uint8_t count,
+                                      const uint32_t *auth_token,
+                                      uint8_t ext_pubkeys[][ERGO_EXT_PUB_KEY_LEN]);
+
+/**
+ * Derives address of the path. Returns it if display is false, shows it otherwise.
+ */
+int ergo_client_derive_address(ergo_client_t *client,
+                               uint8_t network,
+                               const ergo_bip32_path_t *path,
+                               bool display,
+                               const uint32_t *auth_token,
+                               uint8_t address[ERGO_ADDRESS_LEN]);
+
+/**
+ * Number of attested frames of the box.
+ */
+static inline uint8_t ergo_box_frames_count(const ergo_box_t *box) {
+    return box->tokens_count == 0 ? 1
+                                  : (box->tokens_count + ERGO_FRAME_MAX_TOKENS_COUNT - 1) /
+                                        ERGO_FRAME_MAX_TOKENS_COUNT;
+}
+
+/**
+ * Attests boxes in one pipelined flow.
+ *
+ * @param[out] frames
+ *   Frames of all the boxes in order, ergo_box_frames_count() per box.
+ * @param[in] frames_size
+ *   Capacity of frames.
+ */
+int ergo_client_attest_boxes(ergo_client_t *client,
+                             const ergo_box_t *boxes,
+                             size_t boxes_count,
+                             const uint32_t *auth_token,
+                             ergo_input_frame_t *frames,
+                             size_t frames_size);
+
+/**
+ * Sends the transaction and signs it after the user approval.
+ */
+int ergo_client_sign_transaction(ergo_client_t *client,
+                                 const ergo_sign_request_t *request,
+                                 uint8_t signature[ERGO_SIGNATURE_LEN]);
+
+/**
+ * Parses BIP32 path like "m/44'/429'/0'/0/0" (the "m/" prefix is optional).
+ */
+bool ergo_bip32_path_parse(const char *str, ergo_bip32_path_t *path);
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Max size of APDU command: header(5) + data(255).
+ */
+#define APDU_MAX_COMMAND_LEN (5 + 255)
+
+/**
+ * Max size of APDU response: data(258) + SW(2).
+ */
+#define APDU_MAX_RESPONSE_LEN (258 + 2)
+
+typedef struct ergo_transport_s ergo_transport_t;
+
+/**
+ * Transport operations. The exchange is split into send and receive,
+ * so the caller can prepare the next command while the app processes the current one.
+ */
+typedef struct {
+    /**
+     * Sends APDU command.
+     *
+     * @return false on IO error.
+     */
+    bool (*send)(ergo_transport_t *transport, const uint8_t *command, size_t len);
+    /**
+     * Receives response of the last sent command: response data followed by SW.
+     *
+     * @return false on IO error or if the response doesn't fit the buffer.
+     */
+    bool (*recv)(ergo_transport_t *transport, uint8_t *response, size_t size, size_t *len);
+    /**
+     * Closes the connection and frees the transport.
+     */
+    void (*close)(ergo_transport_t *transport);
+} ergo_transport_ops_t;
+
+/**
+ * Base of the transport implementations, must be their first member.
+ */
+struct ergo_transport_s {
+    const ergo_transport_ops_t *ops;
+};
+
+/**
+ * Connects to the APDU port of Speculos.
+ *
+ * @param[in] host
+ *   Host name or address, e.g. "127.0.0.1".
+ * @param[in] port
+ *   APDU port (--apdu-port of Speculos, 9999 by default).
+ *
+ * @return transport, NULL if connection failed.
+ *
+ */
+ergo_transport_t *ergo_transport_speculos_open(const char *host, uint16_t port);
+
+/**
+ * Opens Ledger device over USB HID. Available if the client is built with hidapi.
+ *
+ * @param[in] path
+ *   hidapi device path, NULL for the first connected Ledger device.
+ *
+ * @return transport, NULL if no device found or hidapi isn't available.
+ *
+ */
+ergo_transport_t *ergo_transport_hid_open(const char *path);
+
+static inline bool ergo_transport_send(ergo_transport_t *transport,
+                                       const uint8_t *command,
+                                       size_t len) {
+    return transport->ops->send(transport, command, len);
+}
+
+static inline bool ergo_transport_recv(ergo_transport_t *transport,
+                                       uint8_t *response,
+                                       size_t size,
+                                       size_t *len) {
+    return transport->ops->recv(transport, response, size, len);
+}
+
+static inline void ergo_transport_close(ergo_transport_t *transport) {
+    if (transport != NULL) transport->ops->close(transport);
+}
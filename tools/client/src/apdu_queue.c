@@ -0,0 +1,104 @@
+#include <string.h>
+
+#include "ergo_apdu_queue.h"
+
+#define OFFSET_P2 3
+#define OFFSET_LC 4
+
+void apdu_queue_init(apdu_queue_t *queue, ergo_transport_t *transport) {
+    memset(queue, 0, sizeof(apdu_queue_t));
+    queue->transport = transport;
+}
+
+static bool send_command(apdu_queue_t *queue, apdu_command_t *command) {
+    if (command->flags & APDU_FLAG_SESSION_P2) {
+        command->data[OFFSET_P2] = queue->session;
+    }
+    if (!ergo_transport_send(queue->transport, command->data, command->len)) return false;
+    queue->commands++;
+    queue->bytes_out += command->len;
+    return true;
+}
+
+static bool recv_response(apdu_queue_t *queue, apdu_response_t *response) {
+    uint8_t buffer[APDU_MAX_RESPONSE_LEN];
+    size_t len = 0;
+    if (!ergo_transport_recv(queue->transport, buffer, sizeof(buffer), &len) || len < 2) {
+        return false;
+    }
+    queue->bytes_in += len;
+    response->len = len - 2;
+    response->sw = (uint16_t) (buffer[len - 2] << 8 | buffer[len - 1]);
+    memcpy(response->data, buffer, response->len);
+    queue->last_sw = response->sw;
+    return true;
+}
+
+int apdu_queue_run(apdu_queue_t *queue,
+                   apdu_producer_fn produce,
+                   apdu_consumer_fn consume,
+                   void *ctx) {
+    apdu_response_t response;
+    uint8_t current = 0;
+    int pending = produce(ctx, &queue->slots[current]);
+
+    while (pending > 0) {
+        apdu_command_t *command = &queue->slots[current];
+        if (!send_command(queue, command)) return ERGO_CLIENT_ERR_IO;
+
+        // The app is busy with the command, encode the next one meanwhile
+        int next = produce(ctx, &queue->slots[current ^ 1]);
+
+        // The response is read even if encoding failed to keep the transport in sync
+        if (!recv_response(queue, &response)) return ERGO_CLIENT_ERR_IO;
+        if (response.sw != APDU_SW_OK) return response.sw;
+        if (consume != NULL && !consume(ctx, command, &response)) {
+            return ERGO_CLIENT_ERR_RESPONSE;
+        }
+
+        current ^= 1;
+        pending = next;
+    }
+    return pending < 0 ? pending : ERGO_CLIENT_OK;
+}
+
+void apdu_command_init(apdu_command_t *command,
+                       uint8_t ins,
+                       uint8_t p1,
+                       uint8_t p2,
+                       uint8_t flags) {
+    command->data[0] = APDU_CLA;
+    command->data[1] = ins;
+    command->data[2] = p1;
+    command->data[OFFSET_P2] = p2;
+    command->data[OFFSET_LC] = 0;
+    command->len = APDU_HEADER;
+    command->flags = flags;
+}
+
+bool apdu_command_append(apdu_command_t *command, const uint8_t *data, size_t len) {
+    if (len > apdu_command_space(command)) return false;
+    if (len > 0) memcpy(command->data + command->len, data, len);
+    command->len += len;
+    command->data[OFFSET_LC] = (uint8_t) (command->len - APDU_HEADER);
+    return true;
+}
+
+bool apdu_command_append_u8(apdu_command_t *command, uint8_t value) {
+    return apdu_command_append(command, &value, 1);
+}
+
+bool apdu_command_append_u16(apdu_command_t *command, uint16_t value) {
+    uint8_t data[2] = {(uint8_t) (value >> 8), (uint8_t) value};
+    return apdu_command_append(command, data, sizeof(data));
+}
+
+bool apdu_command_append_u32(apdu_command_t *command, uint32_t value) {
+    return apdu_command_append_u16(command, (uint16_t) (value >> 16)) &&
+           apdu_command_append_u16(command, (uint16_t) value);
+}
+
+bool apdu_command_append_u64(apdu_command_t *command, uint64_t value) {
+    return apdu_command_append_u32(command, (uint32_t) (value >> 32)) &&
+           apdu_command_append_u32(command, (uint32_t) value);
+}
@@ -0,0 +1,788 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "ergo_client.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+#define BIP32_HARDENED(x)      ((x) | 0x80000000u)
+#define BIP32_ERGO_COIN        429
+#define EXT_PUB_KEYS_PER_APDU  3
+#define IDS_PER_APDU           7
+#define BOX_TOKENS_PER_APDU    6
+#define OUTPUT_TOKENS_PER_APDU 21
+
+// P2 of the commands with optional authorization token
+#define P2_WITHOUT_TOKEN 0x01
+#define P2_WITH_TOKEN    0x02
+
+// Subcommands (P1) of the attest input box instruction
+enum {
+    ATTEST_P1_START = 0x01,
+    ATTEST_P1_TREE_CHUNK = 0x02,
+    ATTEST_P1_TOKENS = 0x03,
+    ATTEST_P1_REGISTERS_CHUNK = 0x04,
+    ATTEST_P1_GET_FRAME = 0x05
+};
+
+// Subcommands (P1) of the sign transaction instruction
+enum {
+    SIGN_P1_START_P2PK = 0x01,
+    SIGN_P1_START_TX = 0x10,
+    SIGN_P1_TOKEN_IDS = 0x11,
+    SIGN_P1_INPUT_FRAME = 0x12,
+    SIGN_P1_CONTEXT_EXTENSION_CHUNK = 0x13,
+    SIGN_P1_DATA_INPUTS = 0x14,
+    SIGN_P1_OUTPUT_START = 0x15,
+    SIGN_P1_OUTPUT_TREE_CHUNK = 0x16,
+    SIGN_P1_OUTPUT_MINERS_FEE_TREE = 0x17,
+    SIGN_P1_OUTPUT_CHANGE_TREE = 0x18,
+    SIGN_P1_OUTPUT_TOKENS = 0x19,
+    SIGN_P1_OUTPUT_REGISTERS_CHUNK = 0x1A,
+    SIGN_P1_INPUT_INLINE_START = 0x1B,
+    SIGN_P1_INPUT_INLINE_TREE_CHUNK = 0x1C,
+    SIGN_P1_INPUT_INLINE_TOKENS = 0x1D,
+    SIGN_P1_INPUT_INLINE_REGISTERS_CHUNK = 0x1E,
+    SIGN_P1_REGISTER_CHANGE_PATH = 0x1F,
+    SIGN_P1_CONFIRM = 0x20
+};
+
+static inline uint8_t auth_token_p2(const uint32_t *auth_token) {
+    return auth_token != NULL ? P2_WITH_TOKEN : P2_WITHOUT_TOKEN;
+}
+
+static bool append_path(apdu_command_t *command, const ergo_bip32_path_t *path) {
+    if (path->len == 0 || path->len > ERGO_MAX_BIP32_PATH) return false;
+    if (!apdu_command_append_u8(command, path->len)) return false;
+    for (uint8_t i = 0; i < path->len; i++) {
+        if (!apdu_command_append_u32(command, path->path[i])) return false;
+    }
+    return true;
+}
+
+static bool append_auth_token(apdu_command_t *command, const uint32_t *auth_token) {
+    return auth_token == NULL || apdu_command_append_u32(command, *auth_token);
+}
+
+// Appends as much of the data as fits, starting from the offset
+static void append_chunk(apdu_command_t *command,
+                         const uint8_t *data,
+                         uint32_t len,
+                         uint32_t *offset) {
+    size_t chunk = MIN(len - *offset, apdu_command_space(command));
+    apdu_command_append(command, data + *offset, chunk);
+    *offset += chunk;
+}
+
+static bool append_box_tokens(apdu_command_t *command, const ergo_box_t *box, uint32_t *offset) {
+    uint32_t end = MIN(box->tokens_count, *offset + BOX_TOKENS_PER_APDU);
+    for (; *offset < end; (*offset)++) {
+        const ergo_token_t *token = &box->tokens[*offset];
+        if (!apdu_command_append(command, token->id, ERGO_ID_LEN) ||
+            !apdu_command_append_u64(command, token->amount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool append_box_header(apdu_command_t *command, const ergo_box_t *box) {
+    return apdu_command_append(command, box->tx_id, ERGO_ID_LEN) &&
+           apdu_command_append_u16(command, box->index) &&
+           apdu_command_append_u64(command, box->value) &&
+           apdu_command_append_u32(command, box->ergo_tree_len) &&
+           apdu_command_append_u32(command, box->creation_height) &&
+           apdu_command_append_u8(command, box->tokens_count) &&
+           apdu_command_append_u32(command, box->registers_len);
+}
+
+void ergo_client_init(ergo_client_t *client, ergo_transport_t *transport) {
+    apdu_queue_init(&client->queue, transport);
+}
+
+/* Single command */
+
+typedef struct {
+    const apdu_command_t *command;
+    bool sent;
+    uint8_t *out;
+    size_t out_size;
+    size_t out_len;
+} single_ctx_t;
+
+static int produce_single(void *ctx, apdu_command_t *command) {
+    single_ctx_t *single = ctx;
+    if (single->sent) return 0;
+    memcpy(command, single->command, sizeof(apdu_command_t));
+    single->sent = true;
+    return 1;
+}
+
+static bool consume_single(void *ctx,
+                           const apdu_command_t *command,
+                           const apdu_response_t *response) {
+    (void) command;
+    single_ctx_t *single = ctx;
+    if (response->len > single->out_size) return false;
+    if (response->len > 0) memcpy(single->out, response->data, response->len);
+    single->out_len = response->len;
+    return true;
+}
+
+static int exchange_single(ergo_client_t *client,
+                           const apdu_command_t *command,
+                           uint8_t *out,
+                           size_t out_size,
+                           size_t *out_len) {
+    single_ctx_t ctx = {.command = command, .out = out, .out_size = out_size};
+    int result = apdu_queue_run(&client->queue, produce_single, consume_single, &ctx);
+    if (out_len != NULL) *out_len = ctx.out_len;
+    return result;
+}
+
+// Exchanges the command which must return exactly out_size bytes
+static int exchange_fixed(ergo_client_t *client,
+                          const apdu_command_t *command,
+                          uint8_t *out,
+                          size_t out_size) {
+    size_t len = 0;
+    int result = exchange_single(client, command, out, out_size, &len);
+    if (result == ERGO_CLIENT_OK && len != out_size) return ERGO_CLIENT_ERR_RESPONSE;
+    return result;
+}
+
+int ergo_client_get_version(ergo_client_t *client, uint8_t version[ERGO_APP_VERSION_LEN]) {
+    apdu_command_t command;
+    apdu_command_init(&command, ERGO_INS_GET_APP_VERSION, 0, 0, 0);
+    return exchange_fixed(client, &command, version, ERGO_APP_VERSION_LEN);
+}
+
+int ergo_client_get_app_name(ergo_client_t *client, char *name, size_t size) {
+    if (size == 0) return ERGO_CLIENT_ERR_PARAM;
+    apdu_command_t command;
+    apdu_command_init(&command, ERGO_INS_GET_APP_NAME, 0, 0, 0);
+    size_t len = 0;
+    int result = exchange_single(client, &command, (uint8_t *) name, size - 1, &len);
+    name[result == ERGO_CLIENT_OK ? len : 0] = '\0';
+    return result;
+}
+
+int ergo_client_get_app_info(ergo_client_t *client,
+                             ergo_ins_e ins,
+                             uint8_t *data,
+                             size_t size,
+                             size_t *len) {
+    if (ins != ERGO_INS_GET_APP_LIMITS && ins != ERGO_INS_GET_APP_CAPABILITIES) {
+        return ERGO_CLIENT_ERR_PARAM;
+    }
+    apdu_command_t command;
+    apdu_command_init(&command, ins, 0, 0, 0);
+    return exchange_single(client, &command, data, size, len);
+}
+
+int ergo_client_get_ext_pubkey(ergo_client_t *client,
+                               const ergo_bip32_path_t *path,
+                               const uint32_t *auth_token,
+                               uint8_t ext_pubkey[ERGO_EXT_PUB_KEY_LEN]) {
+    apdu_command_t command;
+    apdu_command_init(&command, ERGO_INS_GET_EXTENDED_PUBLIC_KEY, auth_token_p2(auth_token), 0, 0);
+    if (!append_path(&command, path) || !append_auth_token(&command, auth_token)) {
+        return ERGO_CLIENT_ERR_PARAM;
+    }
+    return exchange_fixed(client, &command, ext_pubkey, ERGO_EXT_PUB_KEY_LEN);
+}
+
+/* Extended public keys range */
+
+typedef struct {
+    uint32_t first_account;
+    uint8_t count;
+    const uint32_t *auth_token;
+    uint8_t chunks_sent;
+    uint8_t (*ext_pubkeys)[ERGO_EXT_PUB_KEY_LEN];
+    uint8_t received;
+} range_ctx_t;
+
+static int produce_range(void *ctx, apdu_command_t *command) {
+    range_ctx_t *range = ctx;
+    uint8_t chunks = (range->count + EXT_PUB_KEYS_PER_APDU - 1) / EXT_PUB_KEYS_PER_APDU;
+    if (range->chunks_sent >= chunks) return 0;
+    if (range->chunks_sent++ > 0) {
+        // next range chunk
+        apdu_command_init(command, ERGO_INS_GET_EXTENDED_PUBLIC_KEY, 0x01, 0x02, 0);
+        return 1;
+    }
+    ergo_bip32_path_t path = {
+        .len = 3,
+        .path = {BIP32_HARDENED(44), BIP32_HARDENED(BIP32_ERGO_COIN),
+                 BIP32_HARDENED(range->first_account)}};
+    apdu_command_init(command,
+                      ERGO_INS_GET_EXTENDED_PUBLIC_KEY,
+                      auth_token_p2(range->auth_token),
+                      0x01,
+                      0);
+    if (!append_path(command, &path) || !apdu_command_append_u8(command, range->count) ||
+        !append_auth_token(command, range->auth_token)) {
+        return ERGO_CLIENT_ERR_PARAM;
+    }
+    return 1;
+}
+
+static bool consume_range(void *ctx,
+                          const apdu_command_t *command,
+                          const apdu_response_t *response) {
+    (void) command;
+    range_ctx_t *range = ctx;
+    size_t keys = response->len / ERGO_EXT_PUB_KEY_LEN;
+    if (response->len % ERGO_EXT_PUB_KEY_LEN != 0 ||
+        keys > (size_t) (range->count - range->received)) {
+        return false;
+    }
+    memcpy(range->ext_pubkeys[range->received], response->data, response->len);
+    range->received += keys;
+    return true;
+}
+
+int ergo_client_get_ext_pubkeys_range(ergo_client_t *client,
+                                      uint32_t first_account,
+                                      uint8_t count,
+                                      const uint32_t *auth_token,
+                                      uint8_t ext_pubkeys[][ERGO_EXT_PUB_KEY_LEN]) {
+    if (count == 0 || count > ERGO_EXT_PUB_KEY_RANGE_MAX || first_account >= BIP32_HARDENED(0)) {
+        return ERGO_CLIENT_ERR_PARAM;
+    }
+    range_ctx_t ctx = {.first_account = first_account,
+                       .count = count,
+                       .auth_token = auth_token,
+                       .ext_pubkeys = ext_pubkeys};
+    int result = apdu_queue_run(&client->queue, produce_range, consume_range, &ctx);
+    if (result == ERGO_CLIENT_OK && ctx.received != count) return ERGO_CLIENT_ERR_RESPONSE;
+    return result;
+}
+
+int ergo_client_derive_address(ergo_client_t *client,
+                               uint8_t network,
+                               const ergo_bip32_path_t *path,
+                               bool display,
+                               const uint32_t *auth_token,
+                               uint8_t address[ERGO_ADDRESS_LEN]) {
+    apdu_command_t command;
+    apdu_command_init(&command,
+                      ERGO_INS_DERIVE_ADDRESS,
+                      display ? 0x02 : 0x01,
+                      auth_token_p2(auth_token),
+                      0);
+    if (!apdu_command_append_u8(&command, network) || !append_path(&command, path) ||
+        !append_auth_token(&command, auth_token)) {
+        return ERGO_CLIENT_ERR_PARAM;
+    }
+    if (display) return exchange_fixed(client, &command, NULL, 0);
+    return exchange_fixed(client, &command, address, ERGO_ADDRESS_LEN);
+}
+
+/* Boxes attestation */
+
+typedef enum {
+    ATTEST_STAGE_START,
+    ATTEST_STAGE_TREE,
+    ATTEST_STAGE_TOKENS,
+    ATTEST_STAGE_REGISTERS,
+    ATTEST_STAGE_FRAMES
+} attest_stage_e;
+
+typedef struct {
+    apdu_queue_t *queue;
+    const ergo_box_t *boxes;
+    size_t boxes_count;
+    const uint32_t *auth_token;
+    size_t box;
+    attest_stage_e stage;
+    uint32_t offset;
+    ergo_input_frame_t *frames;
+    size_t frames_size;
+    size_t frames_len;
+} attest_ctx_t;
+
+static int produce_attest(void *ctx, apdu_command_t *command) {
+    attest_ctx_t *attest = ctx;
+    while (attest->box < attest->boxes_count) {
+        const ergo_box_t *box = &attest->boxes[attest->box];
+        switch (attest->stage) {
+            case ATTEST_STAGE_START:
+                apdu_command_init(command,
+                                  ERGO_INS_ATTEST_INPUT_BOX,
+                                  ATTEST_P1_START,
+                                  auth_token_p2(attest->auth_token),
+                                  0);
+                if (!append_box_header(command, box) ||
+                    !append_auth_token(command, attest->auth_token)) {
+                    return ERGO_CLIENT_ERR_PARAM;
+                }
+                attest->stage = ATTEST_STAGE_TREE;
+                attest->offset = 0;
+                return 1;
+            case ATTEST_STAGE_TREE:
+                if (attest->offset < box->ergo_tree_len) {
+                    apdu_command_init(command,
+                                      ERGO_INS_ATTEST_INPUT_BOX,
+                                      ATTEST_P1_TREE_CHUNK,
+                                      0,
+                                      APDU_FLAG_SESSION_P2);
+                    append_chunk(command, box->ergo_tree, box->ergo_tree_len, &attest->offset);
+                    return 1;
+                }
+                attest->stage = ATTEST_STAGE_TOKENS;
+                attest->offset = 0;
+                break;
+            case ATTEST_STAGE_TOKENS:
+                if (attest->offset < box->tokens_count) {
+                    apdu_command_init(command,
+                                      ERGO_INS_ATTEST_INPUT_BOX,
+                                      ATTEST_P1_TOKENS,
+                                      0,
+                                      APDU_FLAG_SESSION_P2);
+                    if (!append_box_tokens(command, box, &attest->offset)) {
+                        return ERGO_CLIENT_ERR_PARAM;
+                    }
+                    return 1;
+                }
+                attest->stage = ATTEST_STAGE_REGISTERS;
+                attest->offset = 0;
+                break;
+            case ATTEST_STAGE_REGISTERS:
+                if (attest->offset < box->registers_len) {
+                    apdu_command_init(command,
+                                      ERGO_INS_ATTEST_INPUT_BOX,
+                                      ATTEST_P1_REGISTERS_CHUNK,
+                                      0,
+                                      APDU_FLAG_SESSION_P2);
+                    append_chunk(command, box->registers, box->registers_len, &attest->offset);
+                    return 1;
+                }
+                attest->stage = ATTEST_STAGE_FRAMES;
+                attest->offset = 0;
+                break;
+            case ATTEST_STAGE_FRAMES:
+                if (attest->offset < ergo_box_frames_count(box)) {
+                    apdu_command_init(command,
+                                      ERGO_INS_ATTEST_INPUT_BOX,
+                                      ATTEST_P1_GET_FRAME,
+                                      0,
+                                      APDU_FLAG_SESSION_P2);
+                    apdu_command_append_u8(command, (uint8_t) attest->offset++);
+                    return 1;
+                }
+                attest->box++;
+                attest->stage = ATTEST_STAGE_START;
+                break;
+        }
+    }
+    return 0;
+}
+
+static bool consume_attest(void *ctx,
+                           const apdu_command_t *command,
+                           const apdu_response_t *response) {
+    attest_ctx_t *attest = ctx;
+    switch (command->data[2]) {
+        case ATTEST_P1_START:
+            if (response->len != 1) return false;
+            attest->queue->session = response->data[0];
+            return true;
+        case ATTEST_P1_GET_FRAME: {
+            if (attest->frames_len >= attest->frames_size || response->len == 0 ||
+                response->len > ERGO_INPUT_FRAME_MAX_LEN) {
+                return false;
+            }
+            ergo_input_frame_t *frame = &attest->frames[attest->frames_len++];
+            memcpy(frame->data, response->data, response->len);
+            frame->len = (uint8_t) response->len;
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+int ergo_client_attest_boxes(ergo_client_t *client,
+                             const ergo_box_t *boxes,
+                             size_t boxes_count,
+                             const uint32_t *auth_token,
+                             ergo_input_frame_t *frames,
+                             size_t frames_size) {
+    size_t frames_count = 0;
+    for (size_t i = 0; i < boxes_count; i++) {
+        frames_count += ergo_box_frames_count(&boxes[i]);
+    }
+    if (frames_count > frames_size) return ERGO_CLIENT_ERR_PARAM;
+
+    attest_ctx_t ctx = {.queue = &client->queue,
+                        .boxes = boxes,
+                        .boxes_count = boxes_count,
+                        .auth_token = auth_token,
+                        .frames = frames,
+                        .frames_size = frames_size};
+    int result = apdu_queue_run(&client->queue, produce_attest, consume_attest, &ctx);
+    if (result == ERGO_CLIENT_OK && ctx.frames_len != frames_count) {
+        return ERGO_CLIENT_ERR_RESPONSE;
+    }
+    return result;
+}
+
+/* Transaction signing */
+
+typedef enum {
+    SIGN_STAGE_START,
+    SIGN_STAGE_CHANGE_PATHS,
+    SIGN_STAGE_TX_START,
+    SIGN_STAGE_TOKEN_IDS,
+    SIGN_STAGE_INPUTS,
+    SIGN_STAGE_DATA_INPUTS,
+    SIGN_STAGE_OUTPUTS,
+    SIGN_STAGE_CONFIRM,
+    SIGN_STAGE_DONE
+} sign_stage_e;
+
+// Parts of the input and of the output, sent in this order
+typedef enum {
+    SIGN_PART_HEADER,  // frames of attested input, start of inline input or output
+    SIGN_PART_TREE,
+    SIGN_PART_TOKENS,
+    SIGN_PART_REGISTERS,
+    SIGN_PART_EXTENSION,
+    SIGN_PART_DONE
+} sign_part_e;
+
+typedef struct {
+    apdu_queue_t *queue;
+    const ergo_sign_request_t *request;
+    sign_stage_e stage;
+    uint32_t item;  // change path, id, input or output index
+    sign_part_e part;
+    uint32_t offset;  // offset in the part: bytes, tokens or frames
+    uint8_t *signature;
+} sign_ctx_t;
+
+static inline void sign_init_command(apdu_command_t *command, uint8_t p1) {
+    apdu_command_init(command, ERGO_INS_SIGN_TRANSACTION, p1, 0, APDU_FLAG_SESSION_P2);
+}
+
+static inline void sign_next_part(sign_ctx_t *sign, sign_part_e part) {
+    sign->part = part;
+    sign->offset = 0;
+}
+
+static void append_ids(apdu_command_t *command,
+                       const uint8_t (*ids)[ERGO_ID_LEN],
+                       uint32_t count,
+                       uint32_t *item) {
+    uint32_t end = MIN(count, *item + IDS_PER_APDU);
+    for (; *item < end; (*item)++) {
+        apdu_command_append(command, ids[*item], ERGO_ID_LEN);
+    }
+}
+
+static int produce_attested_input(sign_ctx_t *sign,
+                                  const ergo_input_t *input,
+                                  apdu_command_t *command) {
+    if (sign->part == SIGN_PART_HEADER) {
+        if (input->frames_count == 0) return ERGO_CLIENT_ERR_PARAM;
+        if (sign->offset < input->frames_count) {
+            const ergo_input_frame_t *frame = &input->frames[sign->offset];
+            sign_init_command(command, SIGN_P1_INPUT_FRAME);
+            if (!apdu_command_append(command, frame->data, frame->len) ||
+                (sign->offset == 0 && !apdu_command_append_u32(command, input->extension_len))) {
+                return ERGO_CLIENT_ERR_PARAM;
+            }
+            sign->offset++;
+            return 1;
+        }
+        sign_next_part(sign, SIGN_PART_EXTENSION);
+    }
+    return 0;
+}
+
+static int produce_inline_input(sign_ctx_t *sign,
+                                const ergo_input_t *input,
+                                apdu_command_t *command) {
+    const ergo_box_t *box = input->box;
+    switch (sign->part) {
+        case SIGN_PART_HEADER:
+            sign_init_command(command, SIGN_P1_INPUT_INLINE_START);
+            if (!append_box_header(command, box) ||
+                !apdu_command_append_u32(command, input->extension_len)) {
+                return ERGO_CLIENT_ERR_PARAM;
+            }
+            sign_next_part(sign, SIGN_PART_TREE);
+            return 1;
+        case SIGN_PART_TREE:
+            if (sign->offset < box->ergo_tree_len) {
+                sign_init_command(command, SIGN_P1_INPUT_INLINE_TREE_CHUNK);
+                append_chunk(command, box->ergo_tree, box->ergo_tree_len, &sign->offset);
+                return 1;
+            }
+            sign_next_part(sign, SIGN_PART_TOKENS);
+            // fall through
+        case SIGN_PART_TOKENS:
+            if (sign->offset < box->tokens_count) {
+                sign_init_command(command, SIGN_P1_INPUT_INLINE_TOKENS);
+                if (!append_box_tokens(command, box, &sign->offset)) return ERGO_CLIENT_ERR_PARAM;
+                return 1;
+            }
+            sign_next_part(sign, SIGN_PART_REGISTERS);
+            // fall through
+        case SIGN_PART_REGISTERS:
+            if (sign->offset < box->registers_len) {
+                sign_init_command(command, SIGN_P1_INPUT_INLINE_REGISTERS_CHUNK);
+                append_chunk(command, box->registers, box->registers_len, &sign->offset);
+                return 1;
+            }
+            sign_next_part(sign, SIGN_PART_EXTENSION);
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+// Encodes the next command of the input. Returns 0 when the input is finished.
+static int produce_input(sign_ctx_t *sign, apdu_command_t *command) {
+    const ergo_input_t *input = &sign->request->inputs[sign->item];
+    if (sign->part != SIGN_PART_EXTENSION) {
+        int result = input->frames != NULL ? produce_attested_input(sign, input, command)
+                                           : produce_inline_input(sign, input, command);
+        if (result != 0) return result;
+    }
+    if (sign->offset < input->extension_len) {
+        sign_init_command(command, SIGN_P1_CONTEXT_EXTENSION_CHUNK);
+        append_chunk(command, input->extension, input->extension_len, &sign->offset);
+        return 1;
+    }
+    return 0;
+}
+
+static bool append_output_tokens(apdu_command_t *command,
+                                 const ergo_output_t *output,
+                                 uint32_t *offset) {
+    uint32_t end = MIN(output->tokens_count, *offset + OUTPUT_TOKENS_PER_APDU);
+    for (; *offset < end; (*offset)++) {
+        const ergo_output_token_t *token = &output->tokens[*offset];
+        if (!apdu_command_append_u32(command, token->index) ||
+            !apdu_command_append_u64(command, token->amount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Encodes the next command of the output. Returns 0 when the output is finished.
+static int produce_output(sign_ctx_t *sign, apdu_command_t *command) {
+    const ergo_output_t *output = &sign->request->outputs[sign->item];
+    switch (sign->part) {
+        case SIGN_PART_HEADER: {
+            uint32_t tree_len = output->kind == ERGO_OUTPUT_TREE ? output->ergo_tree_len : 0;
+            if (output->kind == ERGO_OUTPUT_TREE && tree_len == 0) return ERGO_CLIENT_ERR_PARAM;
+            sign_init_command(command, SIGN_P1_OUTPUT_START);
+            if (!apdu_command_append_u64(command, output->value) ||
+                !apdu_command_append_u32(command, tree_len) ||
+                !apdu_command_append_u32(command, output->creation_height) ||
+                !apdu_command_append_u8(command, output->tokens_count) ||
+                !apdu_command_append_u32(command, output->registers_len)) {
+                return ERGO_CLIENT_ERR_PARAM;
+            }
+            sign_next_part(sign, SIGN_PART_TREE);
+            return 1;
+        }
+        case SIGN_PART_TREE:
+            switch (output->kind) {
+                case ERGO_OUTPUT_TREE:
+                    if (sign->offset < output->ergo_tree_len) {
+                        sign_init_command(command, SIGN_P1_OUTPUT_TREE_CHUNK);
+                        append_chunk(command,
+                                     output->ergo_tree,
+                                     output->ergo_tree_len,
+                                     &sign->offset);
+                        return 1;
+                    }
+                    break;
+                case ERGO_OUTPUT_MINERS_FEE:
+                    sign_init_command(command, SIGN_P1_OUTPUT_MINERS_FEE_TREE);
+                    sign_next_part(sign, SIGN_PART_TOKENS);
+                    return 1;
+                case ERGO_OUTPUT_CHANGE:
+                    if (output->change_path >= sign->request->change_paths_count) {
+                        return ERGO_CLIENT_ERR_PARAM;
+                    }
+                    sign_init_command(command, SIGN_P1_OUTPUT_CHANGE_TREE);
+                    apdu_command_append_u8(command, output->change_path);
+                    sign_next_part(sign, SIGN_PART_TOKENS);
+                    return 1;
+            }
+            sign_next_part(sign, SIGN_PART_TOKENS);
+            // fall through
+        case SIGN_PART_TOKENS:
+            if (sign->offset < output->tokens_count) {
+                sign_init_command(command, SIGN_P1_OUTPUT_TOKENS);
+                if (!append_output_tokens(command, output, &sign->offset)) {
+                    return ERGO_CLIENT_ERR_PARAM;
+                }
+                return 1;
+            }
+            sign_next_part(sign, SIGN_PART_REGISTERS);
+            // fall through
+        case SIGN_PART_REGISTERS:
+            if (sign->offset < output->registers_len) {
+                sign_init_command(command, SIGN_P1_OUTPUT_REGISTERS_CHUNK);
+                append_chunk(command, output->registers, output->registers_len, &sign->offset);
+                return 1;
+            }
+            sign_next_part(sign, SIGN_PART_DONE);
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+static inline void sign_next_stage(sign_ctx_t *sign, sign_stage_e stage) {
+    sign->stage = stage;
+    sign->item = 0;
+    sign_next_part(sign, SIGN_PART_HEADER);
+}
+
+static int produce_sign(void *ctx, apdu_command_t *command) {
+    sign_ctx_t *sign = ctx;
+    const ergo_sign_request_t *request = sign->request;
+    const uint32_t *auth_token = request->has_auth_token ? &request->auth_token : NULL;
+    int result;
+
+    for (;;) {
+        switch (sign->stage) {
+            case SIGN_STAGE_START:
+                apdu_command_init(command,
+                                  ERGO_INS_SIGN_TRANSACTION,
+                                  SIGN_P1_START_P2PK,
+                                  auth_token_p2(auth_token),
+                                  0);
+                if (!apdu_command_append_u8(command, request->network) ||
+                    !append_path(command, &request->path) ||
+                    !append_auth_token(command, auth_token)) {
+                    return ERGO_CLIENT_ERR_PARAM;
+                }
+                sign_next_stage(sign, SIGN_STAGE_CHANGE_PATHS);
+                return 1;
+            case SIGN_STAGE_CHANGE_PATHS:
+                if (sign->item < request->change_paths_count) {
+                    sign_init_command(command, SIGN_P1_REGISTER_CHANGE_PATH);
+                    if (!append_path(command, &request->change_paths[sign->item++])) {
+                        return ERGO_CLIENT_ERR_PARAM;
+                    }
+                    return 1;
+                }
+                sign_next_stage(sign, SIGN_STAGE_TX_START);
+                break;
+            case SIGN_STAGE_TX_START:
+                sign_init_command(command, SIGN_P1_START_TX);
+                apdu_command_append_u16(command, request->inputs_count);
+                apdu_command_append_u16(command, request->data_inputs_count);
+                apdu_command_append_u16(command, request->token_ids_count);
+                apdu_command_append_u16(command, request->outputs_count);
+                sign_next_stage(sign, SIGN_STAGE_TOKEN_IDS);
+                return 1;
+            case SIGN_STAGE_TOKEN_IDS:
+                if (sign->item < request->token_ids_count) {
+                    sign_init_command(command, SIGN_P1_TOKEN_IDS);
+                    append_ids(command, request->token_ids, request->token_ids_count, &sign->item);
+                    return 1;
+                }
+                sign_next_stage(sign, SIGN_STAGE_INPUTS);
+                break;
+            case SIGN_STAGE_INPUTS:
+                if (sign->item < request->inputs_count) {
+                    if ((result = produce_input(sign, command)) != 0) return result;
+                    sign->item++;
+                    sign_next_part(sign, SIGN_PART_HEADER);
+                    break;
+                }
+                sign_next_stage(sign, SIGN_STAGE_DATA_INPUTS);
+                break;
+            case SIGN_STAGE_DATA_INPUTS:
+                if (sign->item < request->data_inputs_count) {
+                    sign_init_command(command, SIGN_P1_DATA_INPUTS);
+                    append_ids(command,
+                               request->data_inputs,
+                               request->data_inputs_count,
+                               &sign->item);
+                    return 1;
+                }
+                sign_next_stage(sign, SIGN_STAGE_OUTPUTS);
+                break;
+            case SIGN_STAGE_OUTPUTS:
+                if (sign->item < request->outputs_count) {
+                    if ((result = produce_output(sign, command)) != 0) return result;
+                    sign->item++;
+                    sign_next_part(sign, SIGN_PART_HEADER);
+                    break;
+                }
+                sign_next_stage(sign, SIGN_STAGE_CONFIRM);
+                break;
+            case SIGN_STAGE_CONFIRM:
+                sign_init_command(command, SIGN_P1_CONFIRM);
+                sign_next_stage(sign, SIGN_STAGE_DONE);
+                return 1;
+            case SIGN_STAGE_DONE:
+                return 0;
+        }
+    }
+}
+
+static bool consume_sign(void *ctx,
+                         const apdu_command_t *command,
+                         const apdu_response_t *response) {
+    sign_ctx_t *sign = ctx;
+    switch (command->data[2]) {
+        case SIGN_P1_START_P2PK:
+            if (response->len != 1) return false;
+            sign->queue->session = response->data[0];
+            return true;
+        case SIGN_P1_REGISTER_CHANGE_PATH:
+            // paths are distinct and registered in order, so the index is known in advance
+            return response->len == 1;
+        case SIGN_P1_CONFIRM:
+            if (response->len != ERGO_SIGNATURE_LEN) return false;
+            memcpy(sign->signature, response->data, ERGO_SIGNATURE_LEN);
+            return true;
+        default:
+            return response->len == 0;
+    }
+}
+
+int ergo_client_sign_transaction(ergo_client_t *client,
+                                 const ergo_sign_request_t *request,
+                                 uint8_t signature[ERGO_SIGNATURE_LEN]) {
+    if (request->inputs_count == 0 || request->outputs_count == 0) return ERGO_CLIENT_ERR_PARAM;
+    sign_ctx_t ctx = {.queue = &client->queue, .request = request, .signature = signature};
+    return apdu_queue_run(&client->queue, produce_sign, consume_sign, &ctx);
+}
+
+bool ergo_bip32_path_parse(const char *str, ergo_bip32_path_t *path) {
+    memset(path, 0, sizeof(ergo_bip32_path_t));
+    if (str[0] == 'm' && str[1] == '/') str += 2;
+    while (*str != '\0') {
+        if (path->len >= ERGO_MAX_BIP32_PATH || *str < '0' || *str > '9') return false;
+        char *end = NULL;
+        unsigned long index = strtoul(str, &end, 10);
+        if (index >= BIP32_HARDENED(0)) return false;
+        path->path[path->len] = (uint32_t) index;
+        if (*end == '\'' || *end == 'h' || *end == 'H') {
+            path->path[path->len] = BIP32_HARDENED(path->path[path->len]);
+            end++;
+        }
+        path->len++;
+        if (*end == '/' && end[1] != '\0') {
+            end++;
+        } else if (*end != '\0') {
+            return false;
+        }
+        str = end;
+    }
+    return path->len > 0;
+}
@@ -0,0 +1,289 @@
+// Command line client of the Ergo Ledger app.
+// Speaks the APDU protocol over Speculos TCP or USB HID and reports
+// APDU throughput of every flow with -v.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ergo_client.h"
+#include "tx_file.h"
+
+#define DEFAULT_SPECULOS_HOST "127.0.0.1"
+#define DEFAULT_SPECULOS_PORT 9999
+#define APP_INFO_MAX_LEN      255
+
+typedef struct {
+    const char *transport;
+    bool has_auth_token;
+    uint32_t auth_token;
+    bool verbose;
+} options_t;
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [-t speculos[:host[:port]] | -t hid[:path]] [-a auth-token] [-v] <command>\n"
+            "\n"
+            "Commands:\n"
+            "  version                           app version\n"
+            "  name                              app name\n"
+            "  limits | capabilities             raw INS 0x03 / 0x04 record\n"
+            "  pubkey <path>                     extended public key\n"
+            "  pubkeys <first account> <count>   extended public keys of the accounts range\n"
+            "  address <path> [network] [show]   derive address, show it on the device\n"
+            "  attest <tx file>                  attest inputs of the transaction, print frames\n"
+            "  sign <tx file> [attest]           sign transaction, inputs are sent inline\n"
+            "                                    or attested first\n"
+            "\n"
+            "Transaction file format is described in tools/client/README.md.\n",
+            name);
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e3 + (double) ts.tv_nsec / 1e6;
+}
+
+static void print_hex(const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", data[i]);
+    }
+    printf("\n");
+}
+
+static ergo_transport_t *open_transport(const char *spec) {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%s", spec);
+    char *kind = buffer, *arg = strchr(buffer, ':');
+    if (arg != NULL) *arg++ = '\0';
+
+    if (strcmp(kind, "hid") == 0) {
+        return ergo_transport_hid_open(arg);
+    }
+    if (strcmp(kind, "speculos") == 0) {
+        const char *host = DEFAULT_SPECULOS_HOST;
+        unsigned long port = DEFAULT_SPECULOS_PORT;
+        if (arg != NULL) {
+            char *port_str = strrchr(arg, ':');
+            if (port_str != NULL) {
+                *port_str++ = '\0';
+                port = strtoul(port_str, NULL, 10);
+            }
+            if (arg[0] != '\0') host = arg;
+        }
+        if (port == 0 || port > UINT16_MAX) return NULL;
+        return ergo_transport_speculos_open(host, (uint16_t) port);
+    }
+    return NULL;
+}
+
+static bool parse_path(const char *str, ergo_bip32_path_t *path) {
+    if (ergo_bip32_path_parse(str, path)) return true;
+    fprintf(stderr, "Invalid BIP32 path '%s'\n", str);
+    return false;
+}
+
+static size_t total_frames(const tx_file_t *tx) {
+    size_t count = 0;
+    for (uint16_t i = 0; i < tx->request.inputs_count; i++) {
+        count += ergo_box_frames_count(&tx->boxes[i]);
+    }
+    return count;
+}
+
+// Attests all the inputs, frames are stored in the order of inputs
+static int attest_inputs(ergo_client_t *client,
+                         const tx_file_t *tx,
+                         const uint32_t *auth_token,
+                         ergo_input_frame_t **frames) {
+    size_t count = total_frames(tx);
+    *frames = calloc(count, sizeof(ergo_input_frame_t));
+    if (*frames == NULL) return ERGO_CLIENT_ERR_PARAM;
+    return ergo_client_attest_boxes(client,
+                                    tx->boxes,
+                                    tx->request.inputs_count,
+                                    auth_token,
+                                    *frames,
+                                    count);
+}
+
+static int command_tx(ergo_client_t *client,
+                      const options_t *options,
+                      const char *command,
+                      int argc,
+                      char *argv[]) {
+    if (argc < 1) return ERGO_CLIENT_ERR_PARAM;
+    tx_file_t tx;
+    if (!tx_file_read(argv[0], &tx)) return ERGO_CLIENT_ERR_PARAM;
+    // authorization token of the command line wins over the file one
+    if (options->has_auth_token) {
+        tx.request.has_auth_token = true;
+        tx.request.auth_token = options->auth_token;
+    }
+    const uint32_t *auth_token = tx.request.has_auth_token ? &tx.request.auth_token : NULL;
+
+    ergo_input_frame_t *frames = NULL;
+    int result = ERGO_CLIENT_OK;
+    bool sign = strcmp(command, "sign") == 0;
+    if (!sign || (argc > 1 && strcmp(argv[1], "attest") == 0)) {
+        result = attest_inputs(client, &tx, auth_token, &frames);
+    }
+    if (result == ERGO_CLIENT_OK && !sign) {
+        for (size_t i = 0; i < total_frames(&tx); i++) {
+            print_hex(frames[i].data, frames[i].len);
+        }
+    }
+    if (result == ERGO_CLIENT_OK && sign) {
+        if (frames != NULL) {
+            const ergo_input_frame_t *frame = frames;
+            for (uint16_t i = 0; i < tx.request.inputs_count; i++) {
+                tx.inputs[i].frames = frame;
+                tx.inputs[i].frames_count = ergo_box_frames_count(&tx.boxes[i]);
+                frame += tx.inputs[i].frames_count;
+            }
+        }
+        uint8_t signature[ERGO_SIGNATURE_LEN];
+        result = ergo_client_sign_transaction(client, &tx.request, signature);
+        if (result == ERGO_CLIENT_OK) print_hex(signature, sizeof(signature));
+    }
+    free(frames);
+    tx_file_free(&tx);
+    return result;
+}
+
+static int run_command(ergo_client_t *client,
+                       const options_t *options,
+                       const char *command,
+                       int argc,
+                       char *argv[]) {
+    const uint32_t *auth_token = options->has_auth_token ? &options->auth_token : NULL;
+    ergo_bip32_path_t path;
+    int result;
+
+    if (strcmp(command, "version") == 0) {
+        uint8_t version[ERGO_APP_VERSION_LEN];
+        if ((result = ergo_client_get_version(client, version)) == ERGO_CLIENT_OK) {
+            const char *debug = version[0] ? " (debug)" : "";
+            printf("%u.%u.%u%s\n", version[1], version[2], version[3], debug);
+        }
+        return result;
+    }
+    if (strcmp(command, "name") == 0) {
+        char name[APP_INFO_MAX_LEN + 1];
+        if ((result = ergo_client_get_app_name(client, name, sizeof(name))) == ERGO_CLIENT_OK) {
+            printf("%s\n", name);
+        }
+        return result;
+    }
+    if (strcmp(command, "limits") == 0 || strcmp(command, "capabilities") == 0) {
+        uint8_t data[APP_INFO_MAX_LEN];
+        size_t len = 0;
+        ergo_ins_e ins =
+            command[0] == 'l' ? ERGO_INS_GET_APP_LIMITS : ERGO_INS_GET_APP_CAPABILITIES;
+        if ((result = ergo_client_get_app_info(client, ins, data, sizeof(data), &len)) ==
+            ERGO_CLIENT_OK) {
+            print_hex(data, len);
+        }
+        return result;
+    }
+    if (strcmp(command, "pubkey") == 0) {
+        if (argc < 1 || !parse_path(argv[0], &path)) return ERGO_CLIENT_ERR_PARAM;
+        uint8_t ext_pubkey[ERGO_EXT_PUB_KEY_LEN];
+        if ((result = ergo_client_get_ext_pubkey(client, &path, auth_token, ext_pubkey)) ==
+            ERGO_CLIENT_OK) {
+            print_hex(ext_pubkey, sizeof(ext_pubkey));
+        }
+        return result;
+    }
+    if (strcmp(command, "pubkeys") == 0) {
+        if (argc < 2) return ERGO_CLIENT_ERR_PARAM;
+        unsigned long first = strtoul(argv[0], NULL, 10), count = strtoul(argv[1], NULL, 10);
+        if (count == 0 || count > ERGO_EXT_PUB_KEY_RANGE_MAX) return ERGO_CLIENT_ERR_PARAM;
+        uint8_t ext_pubkeys[ERGO_EXT_PUB_KEY_RANGE_MAX][ERGO_EXT_PUB_KEY_LEN];
+        result = ergo_client_get_ext_pubkeys_range(client,
+                                                   (uint32_t) first,
+                                                   (uint8_t) count,
+                                                   auth_token,
+                                                   ext_pubkeys);
+        for (unsigned long i = 0; result == ERGO_CLIENT_OK && i < count; i++) {
+            print_hex(ext_pubkeys[i], ERGO_EXT_PUB_KEY_LEN);
+        }
+        return result;
+    }
+    if (strcmp(command, "address") == 0) {
+        if (argc < 1 || !parse_path(argv[0], &path)) return ERGO_CLIENT_ERR_PARAM;
+        uint8_t network = argc > 1 ? (uint8_t) strtoul(argv[1], NULL, 0) : 0;
+        bool display = argc > 2 && strcmp(argv[2], "show") == 0;
+        uint8_t address[ERGO_ADDRESS_LEN];
+        result = ergo_client_derive_address(client, network, &path, display, auth_token, address);
+        if (result == ERGO_CLIENT_OK && !display) print_hex(address, sizeof(address));
+        return result;
+    }
+    if (strcmp(command, "attest") == 0 || strcmp(command, "sign") == 0) {
+        return command_tx(client, options, command, argc, argv);
+    }
+    return ERGO_CLIENT_ERR_PARAM;
+}
+
+int main(int argc, char *argv[]) {
+    options_t options = {.transport = "speculos"};
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (strcmp(argv[arg], "-v") == 0) {
+            options.verbose = true;
+        } else if (strcmp(argv[arg], "-t") == 0 && arg + 1 < argc) {
+            options.transport = argv[++arg];
+        } else if (strcmp(argv[arg], "-a") == 0 && arg + 1 < argc) {
+            options.has_auth_token = true;
+            options.auth_token = (uint32_t) strtoul(argv[++arg], NULL, 0);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (arg >= argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    ergo_transport_t *transport = open_transport(options.transport);
+    if (transport == NULL) {
+        fprintf(stderr, "Can't open transport '%s'\n", options.transport);
+        return 1;
+    }
+    ergo_client_t client;
+    ergo_client_init(&client, transport);
+
+    double started_at = now_ms();
+    int result = run_command(&client, &options, argv[arg], argc - arg - 1, argv + arg + 1);
+    double elapsed = now_ms() - started_at;
+
+    if (options.verbose) {
+        const apdu_queue_t *queue = &client.queue;
+        fprintf(stderr,
+                "%u APDUs, %llu bytes out, %llu bytes in, %.1f ms, %.1f APDU/s\n",
+                queue->commands,
+                (unsigned long long) queue->bytes_out,
+                (unsigned long long) queue->bytes_in,
+                elapsed,
+                elapsed > 0 ? queue->commands * 1e3 / elapsed : 0.0);
+    }
+    ergo_transport_close(transport);
+
+    if (result == ERGO_CLIENT_ERR_PARAM) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (result != ERGO_CLIENT_OK) {
+        if (result > 0) {
+            fprintf(stderr, "Error: SW %04X\n", result);
+        } else {
+            fprintf(stderr, "Error: %s\n", result == ERGO_CLIENT_ERR_IO ? "transport failure"
+                                                                        : "unexpected response");
+        }
+        return 1;
+    }
+    return 0;
+}
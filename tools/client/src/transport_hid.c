@@ -0,0 +1,130 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "ergo_transport.h"
+
+#ifdef HAVE_HIDAPI
+
+#include <hidapi.h>
+
+// Ledger HID framing. Every 64-byte report starts with
+//   channel (2 bytes) | tag 0x05 (1 byte) | sequence index (2 bytes)
+// and the first report of the message has its length (2 bytes) after the header.
+
+#define LEDGER_VENDOR_ID    0x2C97
+#define LEDGER_USAGE_PAGE   0xFFA0
+#define HID_REPORT_LEN      64
+#define HID_CHANNEL         0x0101
+#define HID_TAG_APDU        0x05
+#define HID_HEADER_LEN      5
+#define HID_READ_TIMEOUT_MS -1
+
+typedef struct {
+    ergo_transport_t base;
+    hid_device *device;
+} hid_transport_t;
+
+static void write_header(uint8_t *report, uint16_t sequence) {
+    report[0] = HID_CHANNEL >> 8;
+    report[1] = HID_CHANNEL & 0xFF;
+    report[2] = HID_TAG_APDU;
+    report[3] = sequence >> 8;
+    report[4] = sequence & 0xFF;
+}
+
+static bool hid_send(ergo_transport_t *transport, const uint8_t *command, size_t len) {
+    hid_transport_t *hid = (hid_transport_t *) transport;
+    size_t offset = 0;
+    for (uint16_t sequence = 0; sequence == 0 || offset < len; sequence++) {
+        // report id 0 followed by the report
+        uint8_t report[1 + HID_REPORT_LEN] = {0};
+        uint8_t *data = report + 1;
+        size_t data_offset = HID_HEADER_LEN;
+        write_header(data, sequence);
+        if (sequence == 0) {
+            data[data_offset++] = (uint8_t) (len >> 8);
+            data[data_offset++] = (uint8_t) len;
+        }
+        size_t chunk = HID_REPORT_LEN - data_offset;
+        if (chunk > len - offset) chunk = len - offset;
+        memcpy(data + data_offset, command + offset, chunk);
+        offset += chunk;
+        if (hid_write(hid->device, report, sizeof(report)) < 0) return false;
+    }
+    return true;
+}
+
+static bool hid_recv(ergo_transport_t *transport, uint8_t *response, size_t size, size_t *len) {
+    hid_transport_t *hid = (hid_transport_t *) transport;
+    size_t expected = 0, offset = 0;
+    for (uint16_t sequence = 0; sequence == 0 || offset < expected; sequence++) {
+        uint8_t report[HID_REPORT_LEN];
+        if (hid_read_timeout(hid->device, report, sizeof(report), HID_READ_TIMEOUT_MS) !=
+            HID_REPORT_LEN) {
+            return false;
+        }
+        uint8_t header[HID_HEADER_LEN];
+        write_header(header, sequence);
+        if (memcmp(report, header, HID_HEADER_LEN) != 0) return false;
+        size_t data_offset = HID_HEADER_LEN;
+        if (sequence == 0) {
+            expected = (size_t) report[data_offset] << 8 | report[data_offset + 1];
+            data_offset += 2;
+            if (expected > size || expected < 2) return false;
+        }
+        size_t chunk = HID_REPORT_LEN - data_offset;
+        if (chunk > expected - offset) chunk = expected - offset;
+        memcpy(response + offset, report + data_offset, chunk);
+        offset += chunk;
+    }
+    *len = expected;
+    return true;
+}
+
+static void hid_close_transport(ergo_transport_t *transport) {
+    hid_transport_t *hid = (hid_transport_t *) transport;
+    hid_close(hid->device);
+    free(hid);
+    hid_exit();
+}
+
+static const ergo_transport_ops_t HID_OPS = {.send = hid_send,
+                                             .recv = hid_recv,
+                                             .close = hid_close_transport};
+
+// Finds the APDU interface of the first Ledger device
+static hid_device *open_first_ledger(void) {
+    struct hid_device_info *devices = hid_enumerate(LEDGER_VENDOR_ID, 0);
+    hid_device *device = NULL;
+    for (struct hid_device_info *info = devices; info != NULL && device == NULL;
+         info = info->next) {
+        if (info->interface_number == 0 || info->usage_page == LEDGER_USAGE_PAGE) {
+            device = hid_open_path(info->path);
+        }
+    }
+    hid_free_enumeration(devices);
+    return device;
+}
+
+ergo_transport_t *ergo_transport_hid_open(const char *path) {
+    if (hid_init() != 0) return NULL;
+    hid_device *device = path != NULL ? hid_open_path(path) : open_first_ledger();
+    hid_transport_t *hid = device != NULL ? calloc(1, sizeof(hid_transport_t)) : NULL;
+    if (hid == NULL) {
+        if (device != NULL) hid_close(device);
+        hid_exit();
+        return NULL;
+    }
+    hid->base.ops = &HID_OPS;
+    hid->device = device;
+    return &hid->base;
+}
+
+#else
+
+ergo_transport_t *ergo_transport_hid_open(const char *path) {
+    (void) path;
+    return NULL;
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "ergo_transport.h"
+
+// Speculos APDU port framing (all integers are big-endian):
+//   command: length (4 bytes) | command
+//   response: data length (4 bytes, without SW) | data | SW (2 bytes)
+
+typedef struct {
+    ergo_transport_t base;
+    int socket;
+} speculos_transport_t;
+
+static bool write_all(int fd, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        ssize_t written = send(fd, data, len, 0);
+        if (written <= 0) return false;
+        data += written;
+        len -= (size_t) written;
+    }
+    return true;
+}
+
+static bool read_all(int fd, uint8_t *data, size_t len) {
+    while (len > 0) {
+        ssize_t received = recv(fd, data, len, 0);
+        if (received <= 0) return false;
+        data += received;
+        len -= (size_t) received;
+    }
+    return true;
+}
+
+static bool speculos_send(ergo_transport_t *transport, const uint8_t *command, size_t len) {
+    speculos_transport_t *speculos = (speculos_transport_t *) transport;
+    uint8_t frame[4 + APDU_MAX_COMMAND_LEN];
+    if (len > APDU_MAX_COMMAND_LEN) return false;
+    frame[0] = 0;
+    frame[1] = 0;
+    frame[2] = (uint8_t) (len >> 8);
+    frame[3] = (uint8_t) len;
+    memcpy(frame + 4, command, len);
+    // single write, so the command isn't split into several TCP segments
+    return write_all(speculos->socket, frame, 4 + len);
+}
+
+static bool speculos_recv(ergo_transport_t *transport,
+                          uint8_t *response,
+                          size_t size,
+                          size_t *len) {
+    speculos_transport_t *speculos = (speculos_transport_t *) transport;
+    uint8_t header[4];
+    if (!read_all(speculos->socket, header, sizeof(header))) return false;
+    size_t data_len = (size_t) header[0] << 24 | (size_t) header[1] << 16 |
+                      (size_t) header[2] << 8 | header[3];
+    if (data_len + 2 > size) return false;
+    if (!read_all(speculos->socket, response, data_len + 2)) return false;
+    *len = data_len + 2;
+    return true;
+}
+
+static void speculos_close(ergo_transport_t *transport) {
+    speculos_transport_t *speculos = (speculos_transport_t *) transport;
+    close(speculos->socket);
+    free(speculos);
+}
+
+static const ergo_transport_ops_t SPECULOS_OPS = {.send = speculos_send,
+                                                  .recv = speculos_recv,
+                                                  .close = speculos_close};
+
+ergo_transport_t *ergo_transport_speculos_open(const char *host, uint16_t port) {
+    char service[8];
+    snprintf(service, sizeof(service), "%u", port);
+
+    struct addrinfo hints = {.ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM};
+    struct addrinfo *addresses = NULL;
+    if (getaddrinfo(host, service, &hints, &addresses) != 0) return NULL;
+
+    int fd = -1;
+    for (struct addrinfo *address = addresses; address != NULL; address = address->ai_next) {
+        fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd < 0) continue;
+        if (connect(fd, address->ai_addr, address->ai_addrlen) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) return NULL;
+
+    // commands are small and latency bound
+    int no_delay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+    speculos_transport_t *speculos = calloc(1, sizeof(speculos_transport_t));
+    if (speculos == NULL) {
+        close(fd);
+        return NULL;
+    }
+    speculos->base.ops = &SPECULOS_OPS;
+    speculos->socket = fd;
+    return &speculos->base;
+}
@@ -0,0 +1,253 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tx_file.h"
+
+#define TX_FILE_MAX_LINE   (256 * 1024)
+#define TX_FILE_MAX_FIELDS 512
+
+// Appends zeroed item to the array of count items
+static void *append_item(void **array, size_t count, size_t item_size) {
+    uint8_t *grown = realloc(*array, (count + 1) * item_size);
+    if (grown == NULL) return NULL;
+    memset(grown + count * item_size, 0, item_size);
+    *array = grown;
+    return grown + count * item_size;
+}
+
+static void *tx_alloc(tx_file_t *tx, size_t size) {
+    void **slot = append_item((void **) &tx->allocations, tx->allocations_count, sizeof(void *));
+    if (slot == NULL) return NULL;
+    *slot = malloc(size > 0 ? size : 1);
+    if (*slot == NULL) return NULL;
+    tx->allocations_count++;
+    return *slot;
+}
+
+static int hex_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool decode_hex(const char *str, uint8_t *out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        int high = hex_digit(str[2 * i]), low = hex_digit(str[2 * i + 1]);
+        if (high < 0 || low < 0) return false;
+        out[i] = (uint8_t) (high << 4 | low);
+    }
+    return true;
+}
+
+// Parses hex bytes, "-" is empty
+static bool parse_bytes(tx_file_t *tx, const char *str, const uint8_t **out, uint32_t *len) {
+    *out = NULL;
+    *len = 0;
+    if (strcmp(str, "-") == 0) return true;
+    size_t str_len = strlen(str);
+    if (str_len == 0 || str_len % 2 != 0 || str_len / 2 > UINT32_MAX) return false;
+    uint8_t *data = tx_alloc(tx, str_len / 2);
+    if (data == NULL || !decode_hex(str, data, str_len / 2)) return false;
+    *out = data;
+    *len = (uint32_t) (str_len / 2);
+    return true;
+}
+
+static bool parse_id(const char *str, uint8_t id[ERGO_ID_LEN]) {
+    return strlen(str) == 2 * ERGO_ID_LEN && decode_hex(str, id, ERGO_ID_LEN);
+}
+
+static bool parse_u64(const char *str, uint64_t max, uint64_t *value) {
+    char *end = NULL;
+    errno = 0;
+    unsigned long long parsed = strtoull(str, &end, 0);
+    if (errno != 0 || end == str || *end != '\0' || str[0] == '-' || parsed > max) return false;
+    *value = parsed;
+    return true;
+}
+
+static bool parse_u32(const char *str, uint32_t *value) {
+    uint64_t parsed;
+    if (!parse_u64(str, UINT32_MAX, &parsed)) return false;
+    *value = (uint32_t) parsed;
+    return true;
+}
+
+// Splits "<key>:<amount>"
+static char *split_pair(char *str, uint64_t *amount) {
+    char *separator = strchr(str, ':');
+    if (separator == NULL) return NULL;
+    *separator = '\0';
+    return parse_u64(separator + 1, UINT64_MAX, amount) ? str : NULL;
+}
+
+static bool parse_input(tx_file_t *tx, char **fields, size_t count) {
+    if (count < 8 || count - 8 > UINT8_MAX) return false;
+    ergo_sign_request_t *request = &tx->request;
+    ergo_box_t *box = append_item((void **) &tx->boxes, request->inputs_count, sizeof(ergo_box_t));
+    if (box == NULL) return false;
+    ergo_input_t *input =
+        append_item((void **) &tx->inputs, request->inputs_count, sizeof(ergo_input_t));
+    if (input == NULL) return false;
+    request->inputs_count++;
+
+    uint64_t index, value;
+    if (!parse_id(fields[1], box->tx_id) || !parse_u64(fields[2], UINT16_MAX, &index) ||
+        !parse_u64(fields[3], UINT64_MAX, &value) ||
+        !parse_u32(fields[4], &box->creation_height) ||
+        !parse_bytes(tx, fields[5], &box->ergo_tree, &box->ergo_tree_len) ||
+        !parse_bytes(tx, fields[6], &box->registers, &box->registers_len) ||
+        !parse_bytes(tx, fields[7], &input->extension, &input->extension_len)) {
+        return false;
+    }
+    box->index = (uint16_t) index;
+    box->value = value;
+
+    box->tokens_count = (uint8_t) (count - 8);
+    ergo_token_t *tokens = tx_alloc(tx, box->tokens_count * sizeof(ergo_token_t));
+    if (tokens == NULL) return false;
+    for (size_t i = 0; i < box->tokens_count; i++) {
+        char *id = split_pair(fields[8 + i], &tokens[i].amount);
+        if (id == NULL || !parse_id(id, tokens[i].id)) return false;
+    }
+    box->tokens = tokens;
+    return true;
+}
+
+static bool parse_output(tx_file_t *tx, char **fields, size_t count) {
+    if (count < 5 || count - 5 > UINT8_MAX) return false;
+    ergo_sign_request_t *request = &tx->request;
+    ergo_output_t *output =
+        append_item((void **) &tx->outputs, request->outputs_count, sizeof(ergo_output_t));
+    if (output == NULL) return false;
+    request->outputs_count++;
+
+    if (!parse_u64(fields[1], UINT64_MAX, &output->value) ||
+        !parse_u32(fields[2], &output->creation_height) ||
+        !parse_bytes(tx, fields[4], &output->registers, &output->registers_len)) {
+        return false;
+    }
+    uint64_t change_path;
+    if (strcmp(fields[3], "fee") == 0) {
+        output->kind = ERGO_OUTPUT_MINERS_FEE;
+    } else if (strncmp(fields[3], "change:", 7) == 0) {
+        if (!parse_u64(fields[3] + 7, UINT8_MAX, &change_path)) return false;
+        output->kind = ERGO_OUTPUT_CHANGE;
+        output->change_path = (uint8_t) change_path;
+    } else {
+        output->kind = ERGO_OUTPUT_TREE;
+        if (!parse_bytes(tx, fields[3], &output->ergo_tree, &output->ergo_tree_len)) return false;
+    }
+
+    output->tokens_count = (uint8_t) (count - 5);
+    ergo_output_token_t *tokens = tx_alloc(tx, output->tokens_count * sizeof(ergo_output_token_t));
+    if (tokens == NULL) return false;
+    for (size_t i = 0; i < output->tokens_count; i++) {
+        char *index = split_pair(fields[5 + i], &tokens[i].amount);
+        if (index == NULL || !parse_u32(index, &tokens[i].index)) return false;
+    }
+    output->tokens = tokens;
+    return true;
+}
+
+static bool parse_line(tx_file_t *tx, char **fields, size_t count) {
+    ergo_sign_request_t *request = &tx->request;
+    const char *key = fields[0];
+    uint64_t value;
+
+    if (strcmp(key, "input") == 0) return parse_input(tx, fields, count);
+    if (strcmp(key, "output") == 0) return parse_output(tx, fields, count);
+    if (count != 2) return false;
+    if (strcmp(key, "network") == 0) {
+        if (!parse_u64(fields[1], UINT8_MAX, &value)) return false;
+        request->network = (uint8_t) value;
+        return true;
+    }
+    if (strcmp(key, "path") == 0) return ergo_bip32_path_parse(fields[1], &request->path);
+    if (strcmp(key, "auth-token") == 0) {
+        request->has_auth_token = true;
+        return parse_u32(fields[1], &request->auth_token);
+    }
+    if (strcmp(key, "change-path") == 0) {
+        ergo_bip32_path_t *path = append_item((void **) &tx->change_paths,
+                                              request->change_paths_count,
+                                              sizeof(ergo_bip32_path_t));
+        if (path == NULL || request->change_paths_count == UINT8_MAX) return false;
+        request->change_paths_count++;
+        return ergo_bip32_path_parse(fields[1], path);
+    }
+    if (strcmp(key, "token-id") == 0 || strcmp(key, "data-input") == 0) {
+        bool token = key[0] == 't';
+        uint16_t *ids_count = token ? &request->token_ids_count : &request->data_inputs_count;
+        uint8_t(*id)[ERGO_ID_LEN] = append_item(token ? (void **) &tx->token_ids
+                                                      : (void **) &tx->data_inputs,
+                                                *ids_count,
+                                                ERGO_ID_LEN);
+        if (id == NULL || *ids_count == UINT16_MAX) return false;
+        (*ids_count)++;
+        return parse_id(fields[1], *id);
+    }
+    return false;
+}
+
+bool tx_file_read(const char *path, tx_file_t *tx) {
+    memset(tx, 0, sizeof(tx_file_t));
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    char *line = malloc(TX_FILE_MAX_LINE);
+    char **fields = malloc(TX_FILE_MAX_FIELDS * sizeof(char *));
+    bool result = line != NULL && fields != NULL;
+    for (size_t number = 1; result && fgets(line, TX_FILE_MAX_LINE, file) != NULL; number++) {
+        size_t count = 0;
+        char *saveptr = NULL;
+        for (char *field = strtok_r(line, " \t\r\n", &saveptr);
+             field != NULL && count < TX_FILE_MAX_FIELDS;
+             field = strtok_r(NULL, " \t\r\n", &saveptr)) {
+            fields[count++] = field;
+        }
+        if (count == 0 || fields[0][0] == '#') continue;
+        if (!parse_line(tx, fields, count)) {
+            fprintf(stderr, "%s:%zu: invalid '%s' line\n", path, number, fields[0]);
+            result = false;
+        }
+    }
+    free(fields);
+    free(line);
+    fclose(file);
+    if (!result) {
+        tx_file_free(tx);
+        return false;
+    }
+
+    // arrays are complete, so the pointers are stable now
+    ergo_sign_request_t *request = &tx->request;
+    for (uint16_t i = 0; i < request->inputs_count; i++) {
+        tx->inputs[i].box = &tx->boxes[i];
+    }
+    request->inputs = tx->inputs;
+    request->change_paths = tx->change_paths;
+    request->token_ids = (const uint8_t(*)[ERGO_ID_LEN]) tx->token_ids;
+    request->data_inputs = (const uint8_t(*)[ERGO_ID_LEN]) tx->data_inputs;
+    request->outputs = tx->outputs;
+    return true;
+}
+
+void tx_file_free(tx_file_t *tx) {
+    for (size_t i = 0; i < tx->allocations_count; i++) {
+        free(tx->allocations[i]);
+    }
+    free(tx->allocations);
+    free(tx->boxes);
+    free(tx->inputs);
+    free(tx->change_paths);
+    free(tx->token_ids);
+    free(tx->data_inputs);
+    free(tx->outputs);
+    memset(tx, 0, sizeof(tx_file_t));
+}
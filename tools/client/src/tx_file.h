@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ergo_client.h"
+
+/**
+ * Transaction description read from a text file, one item per line:
+ *
+ *   network <id>
+ *   path <bip32 path>
+ *   auth-token <u32>
+ *   change-path <bip32 path>
+ *   token-id <hex id>
+ *   input <tx id> <index> <value> <height> <tree hex> <registers hex|-> <extension hex|->
+ *         [<token id>:<amount> ...]
+ *   data-input <box id>
+ *   output <value> <height> <tree hex|fee|change:<index>> <registers hex|->
+ *          [<token index>:<amount> ...]
+ *
+ * Empty lines and lines starting with '#' are skipped.
+ */
+typedef struct {
+    ergo_sign_request_t request;
+    ergo_box_t *boxes;  // input boxes, in the order of inputs
+    ergo_input_t *inputs;
+    ergo_bip32_path_t *change_paths;
+    uint8_t (*token_ids)[ERGO_ID_LEN];
+    uint8_t (*data_inputs)[ERGO_ID_LEN];
+    ergo_output_t *outputs;
+    void **allocations;  // buffers referenced by boxes and outputs
+    size_t allocations_count;
+} tx_file_t;
+
+/**
+ * Reads the file. Prints the error with the line number to stderr.
+ */
+bool tx_file_read(const char *path, tx_file_t *tx);
+
+void tx_file_free(tx_file_t *tx);
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""Flash size report of the application grouped by module.
+
+Reads the linker map of the device build, sums the flash sections (code, read-only
+and initialized data) of every symbol and groups them by the source module:
+the directory of the object file under src/ (e.g. ergo, commands/signtx, ui, common).
+Files of src/ itself are grouped as "src", objects outside src/ (SDK, glyphs) as "sdk".
+
+With --baseline the module sizes are compared with the checked-in baseline and the
+script fails if a module exceeds its budget or isn't in the baseline. A new module is
+accepted only when it's listed with --allow-new, until the baseline is written again.
+--write-baseline stores the current sizes.
+
+Usage: size_report.py <app.map> [--symbols N] [--baseline FILE] [--allow-new MODULE]...
+                      [--write-baseline FILE]
+"""
+
+import argparse
+import math
+import re
+import sys
+from collections import defaultdict
+
+# Input sections placed in flash. .bss (RAM) isn't counted.
+FLASH_SECTIONS = ('.text', '.rodata', '.data')
+# Nested source directories reported as their parent module
+MODULE_ALIASES = {'commands/signtx/operations': 'commands/signtx'}
+SDK_MODULE = 'sdk'
+# Budget of the new baseline entry: size plus slack, rounded up
+BUDGET_SLACK = 0.05
+BUDGET_ROUND = 64
+
+SECTION_RE = re.compile(r'^ (\.[^\s]+)(?:\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(.+))?$')
+PLACEMENT_RE = re.compile(r'^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(.+)$')
+# Objects of the app sources: build/<target>/obj/app/src/... (SDK ones are under obj/sdk/)
+APP_SOURCES_RE = re.compile(r'(?:^|/)src/')
+
+
+def module_of(object_path):
+    path = object_path.replace('\\', '/')
+    match = APP_SOURCES_RE.search(path)
+    if match is None or '/sdk/' in path[:match.end()] or path.startswith('sdk/'):
+        return SDK_MODULE
+    relative = path[match.end():]
+    directory = relative.rsplit('/', 1)[0] if '/' in relative else 'src'
+    return MODULE_ALIASES.get(directory, directory)
+
+
+def symbol_of(section):
+    # -ffunction-sections and -fdata-sections: .text.<symbol>, .rodata.<symbol>
+    for prefix in FLASH_SECTIONS:
+        if section.startswith(prefix + '.'):
+            return section[len(prefix) + 1:]
+    return section
+
+
+def is_flash(section):
+    return any(section == prefix or section.startswith(prefix + '.') for prefix in FLASH_SECTIONS)
+
+
+def parse_map(map_path):
+    """Returns {module: {symbol: size}} of the sections kept by the linker."""
+    modules = defaultdict(lambda: defaultdict(int))
+    with open(map_path, encoding='utf-8', errors='replace') as map_file:
+        lines = iter(map_file.read().splitlines())
+
+    # Discarded sections are listed before the memory map
+    for line in lines:
+        if line.startswith('Linker script and memory map'):
+            break
+
+    pending = None
+    for line in lines:
+        if pending is not None:
+            match = PLACEMENT_RE.match(line)
+            if match:
+                size, obj = int(match.group(2), 16), match.group(3)
+                if size > 0:
+                    modules[module_of(obj)][symbol_of(pending)] += size
+            pending = None
+            continue
+        match = SECTION_RE.match(line)
+        if not match or not is_flash(match.group(1)):
+            continue
+        if match.group(2) is None:
+            # long section name, placement is on the next line
+            pending = match.group(1)
+        else:
+            size, obj = int(match.group(3), 16), match.group(4)
+            if size > 0:
+                modules[module_of(obj)][symbol_of(match.group(1))] += size
+    return modules
+
+
+def read_baseline(path):
+    """Returns {module: (size, budget)}."""
+    baseline = {}
+    with open(path, encoding='utf-8') as baseline_file:
+        for line in baseline_file:
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            module, size, budget = line.split()
+            baseline[module] = (int(size), int(budget))
+    return baseline
+
+
+def write_baseline(path, totals, previous):
+    with open(path, 'w', encoding='utf-8') as baseline_file:
+        baseline_file.write('# Flash size baseline, generated by tools/size_report.py\n')
+        baseline_file.write('# module size budget (bytes)\n')
+        for module in sorted(totals):
+            size = totals[module]
+            budget = math.ceil(size * (1 + BUDGET_SLACK) / BUDGET_ROUND) * BUDGET_ROUND
+            # budgets raised by hand are kept
+            if module in previous:
+                budget = max(budget, previous[module][1])
+            baseline_file.write('{} {} {}\n'.format(module, size, budget))
+
+
+def print_symbols(modules, count):
+    for module in sorted(modules):
+        symbols = sorted(modules[module].items(), key=lambda item: (-item[1], item[0]))
+        print('\n{} ({} symbols)'.format(module, len(symbols)))
+        for symbol, size in symbols[:count]:
+            print('  {:8d}  {}'.format(size, symbol))
+
+
+def compare(totals, baseline, allowed):
+    """Prints the module table and returns the lists of modules over budget and unknown ones.
+    Without a baseline (allowed is None) nothing is checked."""
+    over = []
+    unknown = []
+    print('{:<24} {:>8} {:>8} {:>8} {:>8}'.format('module', 'size', 'baseline', 'delta', 'budget'))
+    for module in sorted(set(totals) | set(baseline)):
+        size = totals.get(module, 0)
+        base, budget = baseline.get(module, (None, None))
+        if base is None:
+            status = ''
+            if allowed is not None and module in allowed:
+                status = '  NEW (allowed)'
+            elif allowed is not None:
+                status = '  NOT IN BASELINE'
+                unknown.append(module)
+            print('{:<24} {:8d} {:>8} {:>8} {:>8}{}'.format(module, size, '-', '-', '-', status))
+            continue
+        status = ''
+        if size > budget:
+            status = '  OVER BUDGET'
+            over.append(module)
+        print('{:<24} {:8d} {:8d} {:+8d} {:8d}{}'.format(module, size, base, size - base, budget,
+                                                          status))
+    print('{:<24} {:8d}'.format('total', sum(totals.values())))
+    return over, unknown
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Flash size report grouped by module.')
+    parser.add_argument('map', help='linker map of the device build')
+    parser.add_argument('--symbols', type=int, default=10,
+                        help='number of largest symbols listed per module (0 to skip)')
+    parser.add_argument('--baseline', help='baseline to compare with, fails if over budget or not in it')
+    parser.add_argument('--allow-new', action='append', default=[], metavar='MODULE',
+                        help='accept a module missing from the baseline (repeatable)')
+    parser.add_argument('--write-baseline', help='store current sizes as the baseline')
+    args = parser.parse_args()
+
+    modules = parse_map(args.map)
+    if not modules:
+        print('No flash sections found in {}'.format(args.map), file=sys.stderr)
+        return 1
+    totals = {module: sum(symbols.values()) for module, symbols in modules.items()}
+
+    baseline = {}
+    if args.baseline:
+        try:
+            baseline = read_baseline(args.baseline)
+        except FileNotFoundError:
+            print('No baseline {}, create it with --write-baseline'.format(args.baseline),
+                  file=sys.stderr)
+            if not args.write_baseline:
+                return 1
+
+    over, unknown = compare(totals, baseline, set(args.allow_new) if args.baseline else None)
+    if args.symbols > 0:
+        print_symbols(modules, args.symbols)
+
+    if args.write_baseline:
+        write_baseline(args.write_baseline, totals, baseline)
+        print('\nBaseline written to {}'.format(args.write_baseline))
+        return 0
+    if over:
+        print('\nModules over budget: {}'.format(', '.join(over)), file=sys.stderr)
+    if unknown:
+        print('\nModules not in the baseline: {}, allow them with --allow-new or write the '
+              'baseline'.format(', '.join(unknown)), file=sys.stderr)
+    return 1 if over or unknown else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,36 @@
+#include "cx.h"
+
+cx_err_t cx_blake2b_init_no_throw(cx_blake2b_t *hash, size_t out_len) {
+    if (out_len != CX_BLAKE2B_256_SIZE * 8) return CX_INVALID_PARAM;
+    hash->info.md_type = CX_BLAKE2B;
+    hash->info.output_size = out_len;
+    blake2b_app_256_init(&hash->state);
+    return CX_OK;
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash,
+                          uint32_t mode,
+                          const uint8_t *in,
+                          size_t len,
+                          uint8_t *out,
+                          size_t out_len) {
+    if (hash->md_type != CX_BLAKE2B) return CX_INVALID_PARAM;
+    cx_blake2b_t *blake2b = (cx_blake2b_t *) hash;
+    if (len > 0) blake2b_app_update(&blake2b->state, in, len);
+    if ((mode & CX_LAST) == 0) return CX_OK;
+
+    if (out == NULL || out_len < CX_BLAKE2B_256_SIZE) return CX_INVALID_PARAM;
+    blake2b_app_256_finalize(&blake2b->state, out);
+    if ((mode & CX_NO_REINIT) == 0) blake2b_app_256_init(&blake2b->state);
+    return CX_OK;
+}
+
+cx_err_t cx_blake2b_256_hash(const uint8_t *data,
+                             size_t len,
+                             uint8_t out[static CX_BLAKE2B_256_SIZE]) {
+    blake2b_app_ctx_t state;
+    blake2b_app_256_init(&state);
+    blake2b_app_update(&state, data, len);
+    blake2b_app_256_finalize(&state, out);
+    return CX_OK;
+}
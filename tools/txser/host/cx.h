@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "helpers/blake2b_app.h"
+
+/**
+ * Host backend of the cx BLAKE2b API used by the serializers.
+ * The hash state is stored in the context itself, so contexts can be used
+ * concurrently from several threads and don't need to be freed.
+ */
+
+typedef int cx_err_t;
+
+typedef enum cx_md_e { CX_BLAKE2B = 9 } cx_md_t;
+
+typedef struct cx_hash_header_s cx_hash_t;
+
+struct cx_hash_header_s {
+    cx_md_t md_type;
+    size_t output_size;
+};
+
+struct cx_blake2b_s {
+    struct cx_hash_header_s info;
+    blake2b_app_ctx_t state;
+};
+typedef struct cx_blake2b_s cx_blake2b_t;
+
+#define CX_OK               0
+#define CX_INVALID_PARAM    -1
+#define CX_BLAKE2B_256_SIZE 32
+
+/*
+ * Bit 0
+ */
+#define CX_LAST (1 << 0)
+/*
+ * Bit 15
+ */
+#define CX_NO_REINIT (1 << 15)
+
+/**
+ * Initialize BLAKE2b state. Only 256-bit digests are supported.
+ */
+cx_err_t cx_blake2b_init_no_throw(cx_blake2b_t *hash, size_t out_len);
+
+/**
+ * Absorb data, write the digest if mode has CX_LAST.
+ * The state is initialized again after the digest unless mode has CX_NO_REINIT.
+ */
+cx_err_t cx_hash_no_throw(cx_hash_t *hash,
+                          uint32_t mode,
+                          const uint8_t *in,
+                          size_t len,
+                          uint8_t *out,
+                          size_t out_len);
+
+cx_err_t cx_blake2b_256_hash(const uint8_t *data,
+                             size_t len,
+                             uint8_t out[static CX_BLAKE2B_256_SIZE]);
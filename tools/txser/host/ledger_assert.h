@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdlib.h>
+
+// The app is reset on the failed assertion, the host library aborts in all build types
+#define LEDGER_ASSERT(_test, ...) \
+    do {                          \
+        if (!(_test)) abort();    \
+    } while (0)
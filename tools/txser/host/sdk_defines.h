@@ -0,0 +1,4 @@
+// Macros defined by the SDK Makefiles, force included into the library sources
+#pragma once
+
+#define UNUSED(x) (void) (x)
@@ -0,0 +1,12 @@
+// Force included into the library sources after sdk_defines.h. The sources are built with
+// -fvisibility=hidden, only the functions declared by the txser API headers are exported.
+#pragma once
+
+// Dependencies of the API headers are declared first, so they stay hidden
+#include <buffer.h>
+#include "cx.h"
+#include "common/macros_ext.h"
+
+#pragma GCC visibility push(default)
+#include "ergo_txser.h"
+#pragma GCC visibility pop
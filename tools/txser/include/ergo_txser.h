@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * Ergo transaction and box serializers of the Ledger app, built for the host.
+ *
+ * The serializers hash exactly what the app hashes: transaction id is the BLAKE2b-256
+ * of the transaction bytes without proofs, box id is the BLAKE2b-256 of the box bytes
+ * followed by the transaction id and the output index.
+ *
+ * All the state lives in the caller owned contexts (cx_blake2b_t, token_table_t and the
+ * serializer contexts), the library has no globals. Contexts can be used from several
+ * threads at once as long as each one is used by a single thread at a time.
+ *
+ * token_table_t size depends on TOKEN_MAX_COUNT, build with the flags of
+ * `pkg-config --cflags ergo_txser`.
+ */
+
+#include "ergo/tx_ser_full.h"
+#include "ergo/tx_ser_box.h"
+#include "ergo/tx_ser_input.h"
+#include "ergo/tx_ser_table.h"
+#include "ergo/ergo_tree.h"
+#include "helpers/blake2b.h"
+
+#define ERGO_TXSER_VERSION_MAJOR 0
+#define ERGO_TXSER_VERSION_MINOR 1
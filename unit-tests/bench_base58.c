@@ -0,0 +1,78 @@
+// Host benchmark of the base58 encoders.
+// Compares the byte-wise SDK encoder with the limb-based one on address lengths.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/base58_fast.h"
+#include "ergo/address.h"
+#include "base58.h"
+
+#define BENCH_DEFAULT_ITERATIONS 200000
+
+typedef int (*encode_fn)(const uint8_t *in, size_t in_len, char *out, size_t out_len);
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+static double bench_encode(encode_fn encode,
+                           const uint8_t *in,
+                           size_t in_len,
+                           unsigned long iterations) {
+    char out[BASE58_FAST_MAX_DEC_INPUT_SIZE];
+    volatile int sink = 0;
+    double start = now_ns();
+    for (unsigned long i = 0; i < iterations; i++) {
+        sink += encode(in, in_len, out, sizeof(out));
+    }
+    (void) sink;
+    return (now_ns() - start) / (double) iterations;
+}
+
+static int bench_length(const char *name, size_t len, unsigned long iterations) {
+    uint8_t in[BASE58_FAST_MAX_ENC_INPUT_SIZE];
+    char expected[BASE58_FAST_MAX_DEC_INPUT_SIZE];
+    char out[BASE58_FAST_MAX_DEC_INPUT_SIZE];
+
+    for (size_t i = 0; i < len; i++) {
+        in[i] = (uint8_t) (i * 151 + 7);
+    }
+    in[0] = 0x01;  // mainnet P2PK-like prefix
+
+    int expected_len = base58_encode(in, len, expected, sizeof(expected));
+    int out_len = base58_fast_encode(in, len, out, sizeof(out));
+    if (expected_len != out_len || memcmp(expected, out, out_len) != 0) {
+        fprintf(stderr, "%s: encoders mismatch\n", name);
+        return 1;
+    }
+
+    double reference = bench_encode(base58_encode, in, len, iterations);
+    double fast = bench_encode(base58_fast_encode, in, len, iterations);
+    printf("%-6s %3zu bytes: sdk %8.1f ns, limbs %8.1f ns, x%.2f\n",
+           name,
+           len,
+           reference,
+           fast,
+           reference / fast);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+        if (iterations == 0) iterations = BENCH_DEFAULT_ITERATIONS;
+    }
+
+    int result = 0;
+    result |= bench_length("P2SH", P2SH_ADDRESS_LEN, iterations);
+    result |= bench_length("P2PK", P2PK_ADDRESS_LEN, iterations);
+    result |= bench_length("max", BASE58_FAST_MAX_ENC_INPUT_SIZE, iterations);
+    return result;
+}
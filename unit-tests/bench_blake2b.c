@@ -0,0 +1,127 @@
+// Host benchmark of the BLAKE2b engines.
+// Compares the reference BLAKE2b (the cx software path without the syscall)
+// with the in-app one on update sizes the serializers produce.
+// Syscall overhead is measured on Speculos or device, see README.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "helpers/blake2b_app.h"
+#include "blake2b-ref.h"
+
+#define BENCH_DEFAULT_ITERATIONS 2000
+#define BENCH_MAX_UPDATE_LEN     255
+
+// Update sizes of one hashed object, repeated until the object size is reached
+typedef struct {
+    const char *name;
+    const uint8_t *sizes;
+    size_t sizes_count;
+    size_t object_len;
+} bench_profile_t;
+
+// VLQ integers: values, heights, counts
+static const uint8_t VLQ_SIZES[] = {1, 2, 1, 4, 8, 3, 1, 5};
+// Token list: 32-byte id followed by VLQ amount
+static const uint8_t TOKEN_SIZES[] = {32, 3, 32, 8, 32, 1};
+// Box: header integers, tree and registers chunks
+static const uint8_t BOX_SIZES[] = {1, 5, 4, 200, 255, 1, 32, 3, 1, 120};
+
+static const bench_profile_t PROFILES[] = {
+    {"vlq", VLQ_SIZES, sizeof(VLQ_SIZES), 1024},
+    {"tokens", TOKEN_SIZES, sizeof(TOKEN_SIZES), 4096},
+    {"box", BOX_SIZES, sizeof(BOX_SIZES), 4096},
+};
+
+static uint8_t G_data[BENCH_MAX_UPDATE_LEN];
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+static size_t next_len(const bench_profile_t *profile, size_t index, size_t left) {
+    size_t len = profile->sizes[index % profile->sizes_count];
+    return len < left ? len : left;
+}
+
+static double bench_reference(const bench_profile_t *profile,
+                              unsigned long iterations,
+                              uint8_t out[static BLAKE2B_APP_256_LEN]) {
+    double start = now_ns();
+    for (unsigned long i = 0; i < iterations; i++) {
+        blake2b_state ctx;
+        blake2b_ref_init(&ctx, BLAKE2B_APP_256_LEN);
+        size_t left = profile->object_len;
+        for (size_t j = 0; left > 0; j++) {
+            size_t len = next_len(profile, j, left);
+            blake2b_ref_update(&ctx, G_data, len);
+            left -= len;
+        }
+        blake2b_ref_final(&ctx, out, BLAKE2B_APP_256_LEN);
+    }
+    return (now_ns() - start) / (double) iterations;
+}
+
+static double bench_app(const bench_profile_t *profile,
+                        unsigned long iterations,
+                        uint8_t out[static BLAKE2B_APP_256_LEN]) {
+    double start = now_ns();
+    for (unsigned long i = 0; i < iterations; i++) {
+        blake2b_app_ctx_t ctx;
+        blake2b_app_256_init(&ctx);
+        size_t left = profile->object_len;
+        for (size_t j = 0; left > 0; j++) {
+            size_t len = next_len(profile, j, left);
+            blake2b_app_update(&ctx, G_data, len);
+            left -= len;
+        }
+        blake2b_app_256_finalize(&ctx, out);
+    }
+    return (now_ns() - start) / (double) iterations;
+}
+
+static int bench_profile(const bench_profile_t *profile, unsigned long iterations) {
+    uint8_t expected[BLAKE2B_APP_256_LEN];
+    uint8_t out[BLAKE2B_APP_256_LEN];
+
+    double reference = bench_reference(profile, iterations, expected);
+    double app = bench_app(profile, iterations, out);
+    if (memcmp(expected, out, sizeof(out)) != 0) {
+        fprintf(stderr, "%s: digests mismatch\n", profile->name);
+        return 1;
+    }
+
+    double mb = (double) profile->object_len / 1e6;
+    printf("%-7s %5zu bytes: ref %8.1f ns (%6.1f MB/s), in-app %8.1f ns (%6.1f MB/s), x%.2f\n",
+           profile->name,
+           profile->object_len,
+           reference,
+           mb / (reference / 1e9),
+           app,
+           mb / (app / 1e9),
+           reference / app);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+        if (iterations == 0) iterations = BENCH_DEFAULT_ITERATIONS;
+    }
+
+    for (size_t i = 0; i < sizeof(G_data); i++) {
+        G_data[i] = (uint8_t) (i * 151 + 7);
+    }
+
+    int result = 0;
+    for (size_t i = 0; i < sizeof(PROFILES) / sizeof(PROFILES[0]); i++) {
+        result |= bench_profile(&PROFILES[i], iterations);
+    }
+    return result;
+}
@@ -0,0 +1,40 @@
+#!/bin/bash
+
+# Aggregates GCC stack usage files (-fstack-usage) of the app sources.
+# Usage: ./stack_usage.sh [directory with .su files] [number of top functions]
+# Device build: `make STACK_PROFILE=1`, then `./stack_usage.sh ../build`.
+# Host build: `cmake -Bbuild -H. -DSTACK_USAGE=ON && make -C build`, then `./stack_usage.sh build`.
+
+set -e
+
+SU_DIRECTORY=${1:-build/}
+TOP_COUNT=${2:-20}
+
+SU_FILES=$(find "${SU_DIRECTORY}" -name '*.su' | grep '/src/' || true)
+if [ -z "${SU_FILES}" ]; then
+    echo "No .su files of src/ found in '${SU_DIRECTORY}'." >&2
+    exit 1
+fi
+
+# "path/src/module/file.c:line:col:function<TAB>bytes<TAB>qualifier" -> "bytes module file function qualifier"
+FRAMES=$(cat ${SU_FILES} | awk -F '\t' '{
+    split($1, location, ":");
+    path = location[1];
+    sub(/.*\/src\//, "", path);
+    # headers included with relative paths, e.g. ergo/../common/rwbuffer.h
+    while (sub(/[^\/.][^\/]*\/\.\.\//, "", path));
+    module = path;
+    if (!sub(/\/[^\/]*$/, "", module)) module = ".";
+    print $2, module, path ":" location[2], location[4], $3
+}' | sort -n -r -k1,1 | uniq)
+
+echo "Max frame per module (bytes):"
+echo "${FRAMES}" | awk '!seen[$2]++ { printf "  %6d  %-24s %s (%s)\n", $1, $2, $4, $3 }' | sort -n -r
+
+echo
+echo "Top ${TOP_COUNT} frames (bytes):"
+echo "${FRAMES}" | head -n "${TOP_COUNT}" | awk '{ printf "  %6d  %-40s %s%s\n", $1, $4, $3, ($5 == "static" ? "" : " [" $5 "]") }'
+
+DYNAMIC=$(echo "${FRAMES}" | awk '$5 != "static"' | wc -l)
+echo
+echo "Functions with dynamic frames: ${DYNAMIC}"
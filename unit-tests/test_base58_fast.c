@@ -0,0 +1,129 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "common/base58_fast.h"
+#include "base58.h"
+
+static const uint8_t P2PK_ADDRESS[38] = {
+    0x01, 0x03, 0x8b, 0x9f, 0xf8, 0x5d, 0xdd, 0x9f, 0x1e, 0x22, 0x88, 0xfc, 0x53,
+    0x9d, 0x39, 0xc7, 0xc4, 0xee, 0xb7, 0xa5, 0x56, 0xf4, 0xd8, 0x11, 0xcb, 0x73,
+    0x99, 0x64, 0x18, 0xde, 0x5a, 0xbd, 0xcb, 0x2a, 0xb5, 0x2d, 0xca, 0xce};
+static const char P2PK_ADDRESS_STRING[] = "9hXJDp23A7cXuB4ecsnsXgHPMRSp6reRB5udM4fAE3UaVhD25kR";
+
+static uint32_t random_state = 0x12345678;
+
+static uint8_t random_byte(void) {
+    random_state = random_state * 1103515245 + 12345;
+    return (uint8_t) (random_state >> 16);
+}
+
+static void test_base58_fast_encode_address(void **state) {
+    (void) state;
+
+    char out[60] = {0};
+    int len = base58_fast_encode(P2PK_ADDRESS, sizeof(P2PK_ADDRESS), out, sizeof(out));
+    assert_int_equal(len, strlen(P2PK_ADDRESS_STRING));
+    assert_string_equal(out, P2PK_ADDRESS_STRING);
+
+    uint8_t decoded[38];
+    len = base58_fast_decode(P2PK_ADDRESS_STRING,
+                             strlen(P2PK_ADDRESS_STRING),
+                             decoded,
+                             sizeof(decoded));
+    assert_int_equal(len, sizeof(P2PK_ADDRESS));
+    assert_memory_equal(decoded, P2PK_ADDRESS, sizeof(P2PK_ADDRESS));
+}
+
+static void test_base58_fast_leading_zeros(void **state) {
+    (void) state;
+
+    const uint8_t in[] = {0x00, 0x00, 0x00, 0x01};
+    char out[10] = {0};
+    assert_int_equal(base58_fast_encode(in, sizeof(in), out, sizeof(out)), 4);
+    assert_string_equal(out, "1112");
+
+    const uint8_t zeros[3] = {0};
+    memset(out, 0, sizeof(out));
+    assert_int_equal(base58_fast_encode(zeros, sizeof(zeros), out, sizeof(out)), 3);
+    assert_string_equal(out, "111");
+
+    uint8_t decoded[10];
+    assert_int_equal(base58_fast_decode("1112", 4, decoded, sizeof(decoded)), 4);
+    assert_memory_equal(decoded, in, sizeof(in));
+    assert_int_equal(base58_fast_decode("111", 3, decoded, sizeof(decoded)), 3);
+    assert_memory_equal(decoded, zeros, sizeof(zeros));
+}
+
+static void test_base58_fast_matches_reference(void **state) {
+    (void) state;
+
+    uint8_t in[BASE58_FAST_MAX_ENC_INPUT_SIZE];
+    char expected[BASE58_FAST_MAX_DEC_INPUT_SIZE];
+    char out[BASE58_FAST_MAX_DEC_INPUT_SIZE];
+    uint8_t decoded[BASE58_FAST_MAX_ENC_INPUT_SIZE];
+
+    for (size_t len = 1; len <= BASE58_FAST_MAX_ENC_INPUT_SIZE; len++) {
+        for (uint8_t round = 0; round < 4; round++) {
+            for (size_t i = 0; i < len; i++) {
+                in[i] = random_byte();
+            }
+            // leading zero bytes and maximal bytes
+            if (round == 1) in[0] = 0;
+            if (round == 2) memset(in, 0xFF, len);
+            if (round == 3 && len > 2) memset(in, 0, len / 2);
+
+            int expected_len = base58_encode(in, len, expected, sizeof(expected));
+            int out_len = base58_fast_encode(in, len, out, sizeof(out));
+            assert_true(expected_len > 0);
+            assert_int_equal(out_len, expected_len);
+            assert_memory_equal(out, expected, out_len);
+
+            assert_int_equal(base58_fast_decode(out, out_len, decoded, sizeof(decoded)), len);
+            assert_memory_equal(decoded, in, len);
+        }
+    }
+}
+
+static void test_base58_fast_errors(void **state) {
+    (void) state;
+
+    uint8_t in[BASE58_FAST_MAX_ENC_INPUT_SIZE + 1] = {0xFF};
+    char out[BASE58_FAST_MAX_DEC_INPUT_SIZE + 1];
+    assert_int_equal(base58_fast_encode(in, sizeof(in), out, sizeof(out)), -1);
+    // output buffer is too small
+    assert_int_equal(base58_fast_encode(P2PK_ADDRESS,
+                                        sizeof(P2PK_ADDRESS),
+                                        out,
+                                        strlen(P2PK_ADDRESS_STRING) - 1),
+                     -1);
+
+    uint8_t decoded[BASE58_FAST_MAX_ENC_INPUT_SIZE];
+    // invalid characters
+    assert_int_equal(base58_fast_decode("9hX0", 4, decoded, sizeof(decoded)), -1);
+    assert_int_equal(base58_fast_decode("9hXl", 4, decoded, sizeof(decoded)), -1);
+    assert_int_equal(base58_fast_decode("9h I", 4, decoded, sizeof(decoded)), -1);
+    // output buffer is too small
+    assert_int_equal(base58_fast_decode(P2PK_ADDRESS_STRING,
+                                        strlen(P2PK_ADDRESS_STRING),
+                                        decoded,
+                                        sizeof(P2PK_ADDRESS) - 1),
+                     -1);
+    // input is too long
+    memset(out, 'z', sizeof(out));
+    assert_int_equal(base58_fast_decode(out, sizeof(out), decoded, sizeof(decoded)), -1);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_base58_fast_encode_address),
+                                       cmocka_unit_test(test_base58_fast_leading_zeros),
+                                       cmocka_unit_test(test_base58_fast_matches_reference),
+                                       cmocka_unit_test(test_base58_fast_errors)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,89 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "helpers/blake2b_app.h"
+#include "blake2b-ref.h"
+
+static uint32_t random_state = 0x2468ace0;
+
+static uint8_t random_byte(void) {
+    random_state = random_state * 1103515245 + 12345;
+    return (uint8_t) (random_state >> 16);
+}
+
+static void test_blake2b_app_empty(void **state) {
+    (void) state;
+
+    // BLAKE2b-256 of the empty string
+    const uint8_t expected[BLAKE2B_APP_256_LEN] = {
+        0x0e, 0x57, 0x51, 0xc0, 0x26, 0xe5, 0x43, 0xb2, 0xe8, 0xab, 0x2e,
+        0xb0, 0x60, 0x99, 0xda, 0xa1, 0xd1, 0xe5, 0xdf, 0x47, 0x77, 0x8f,
+        0x77, 0x87, 0xfa, 0xab, 0x45, 0xcd, 0xf1, 0x2f, 0xe3, 0xa8};
+    blake2b_app_ctx_t ctx;
+    uint8_t out[BLAKE2B_APP_256_LEN];
+    blake2b_app_256_init(&ctx);
+    blake2b_app_256_finalize(&ctx, out);
+    assert_memory_equal(out, expected, sizeof(expected));
+}
+
+static void test_blake2b_app_block_boundaries(void **state) {
+    (void) state;
+
+    uint8_t data[4 * BLAKE2B_APP_BLOCK_LEN + 1];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = random_byte();
+    }
+
+    // Single update of every length around the block boundaries
+    for (size_t len = 0; len <= sizeof(data); len++) {
+        blake2b_app_ctx_t ctx;
+        uint8_t out[BLAKE2B_APP_256_LEN];
+        uint8_t expected[BLAKE2B_APP_256_LEN];
+        blake2b_app_256_init(&ctx);
+        blake2b_app_update(&ctx, data, len);
+        blake2b_app_256_finalize(&ctx, out);
+        assert_int_equal(blake2b_ref(expected, sizeof(expected), data, len, NULL, 0), 0);
+        assert_memory_equal(out, expected, sizeof(expected));
+    }
+}
+
+static void test_blake2b_app_split_updates(void **state) {
+    (void) state;
+
+    uint8_t data[2048];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = random_byte();
+    }
+    uint8_t expected[BLAKE2B_APP_256_LEN];
+    assert_int_equal(blake2b_ref(expected, sizeof(expected), data, sizeof(data), NULL, 0), 0);
+
+    // Small and large updates mixed, as serializers do
+    for (uint8_t round = 0; round < 16; round++) {
+        blake2b_app_ctx_t ctx;
+        uint8_t out[BLAKE2B_APP_256_LEN];
+        blake2b_app_256_init(&ctx);
+        size_t offset = 0;
+        while (offset < sizeof(data)) {
+            size_t len = random_byte() % 4 == 0 ? random_byte() + 100 : random_byte() % 33;
+            if (len > sizeof(data) - offset) len = sizeof(data) - offset;
+            blake2b_app_update(&ctx, data + offset, len);
+            offset += len;
+        }
+        blake2b_app_256_finalize(&ctx, out);
+        assert_memory_equal(out, expected, sizeof(expected));
+    }
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_blake2b_app_empty),
+                                       cmocka_unit_test(test_blake2b_app_block_boundaries),
+                                       cmocka_unit_test(test_blake2b_app_split_updates)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
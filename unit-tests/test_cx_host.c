@@ -0,0 +1,81 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+// host cx backend of libergo_txser
+#include "cx.h"
+
+// BLAKE2b-256("abc")
+static const uint8_t ABC_DIGEST[CX_BLAKE2B_256_SIZE] = {
+    0xbd, 0xdd, 0x81, 0x3c, 0x63, 0x42, 0x39, 0x72, 0x31, 0x71, 0xef, 0x3f, 0xee, 0x98, 0x57, 0x9b,
+    0x94, 0x96, 0x4e, 0x3b, 0xb1, 0xcb, 0x3e, 0x42, 0x72, 0x62, 0xc8, 0xc0, 0x68, 0xd5, 0x23, 0x19};
+
+static void test_cx_host_one_shot(void **state) {
+    (void) state;
+
+    uint8_t digest[CX_BLAKE2B_256_SIZE];
+    assert_int_equal(cx_blake2b_256_hash((const uint8_t *) "abc", 3, digest), CX_OK);
+    assert_memory_equal(digest, ABC_DIGEST, sizeof(digest));
+}
+
+static void test_cx_host_stream(void **state) {
+    (void) state;
+
+    uint8_t data[1000];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t) i;
+    uint8_t expected[CX_BLAKE2B_256_SIZE];
+    assert_int_equal(cx_blake2b_256_hash(data, sizeof(data), expected), CX_OK);
+
+    // interleaved contexts with different chunk sizes
+    cx_blake2b_t first, second;
+    assert_int_equal(cx_blake2b_init_no_throw(&first, 256), CX_OK);
+    assert_int_equal(cx_blake2b_init_no_throw(&second, 256), CX_OK);
+    for (size_t offset = 0; offset < sizeof(data); offset += 7) {
+        size_t len = sizeof(data) - offset < 7 ? sizeof(data) - offset : 7;
+        assert_int_equal(cx_hash_no_throw(&first.info, 0, data + offset, len, NULL, 0), CX_OK);
+    }
+    for (size_t offset = 0; offset < sizeof(data); offset += 200) {
+        assert_int_equal(cx_hash_no_throw(&second.info, 0, data + offset, 200, NULL, 0), CX_OK);
+    }
+
+    uint8_t digest[CX_BLAKE2B_256_SIZE];
+    assert_int_equal(
+        cx_hash_no_throw(&first.info, CX_LAST | CX_NO_REINIT, NULL, 0, digest, sizeof(digest)),
+        CX_OK);
+    assert_memory_equal(digest, expected, sizeof(digest));
+    assert_int_equal(
+        cx_hash_no_throw(&second.info, CX_LAST | CX_NO_REINIT, NULL, 0, digest, sizeof(digest)),
+        CX_OK);
+    assert_memory_equal(digest, expected, sizeof(digest));
+}
+
+static void test_cx_host_reinit(void **state) {
+    (void) state;
+
+    cx_blake2b_t hash;
+    uint8_t digest[CX_BLAKE2B_256_SIZE];
+    assert_int_equal(cx_blake2b_init_no_throw(&hash, 256), CX_OK);
+    // state is initialized again after CX_LAST without CX_NO_REINIT
+    assert_int_equal(cx_hash_no_throw(&hash.info, CX_LAST, (const uint8_t *) "xyz", 3, digest, 32),
+                     CX_OK);
+    assert_int_equal(cx_hash_no_throw(&hash.info, CX_LAST, (const uint8_t *) "abc", 3, digest, 32),
+                     CX_OK);
+    assert_memory_equal(digest, ABC_DIGEST, sizeof(digest));
+
+    assert_int_not_equal(cx_blake2b_init_no_throw(&hash, 512), CX_OK);
+    assert_int_equal(cx_blake2b_init_no_throw(&hash, 256), CX_OK);
+    assert_int_not_equal(cx_hash_no_throw(&hash.info, CX_LAST, NULL, 0, digest, 16), CX_OK);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_cx_host_one_shot),
+                                       cmocka_unit_test(test_cx_host_stream),
+                                       cmocka_unit_test(test_cx_host_reinit)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,285 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "ergo_client.h"
+
+#define MOCK_MAX_COMMANDS 32
+#define MOCK_SESSION      0x07
+
+// Transport answering the sign flow commands, records the sent commands
+typedef struct {
+    ergo_transport_t base;
+    apdu_command_t sent[MOCK_MAX_COMMANDS];
+    size_t sent_count;
+    size_t received_count;
+    size_t pending;  // commands sent without received response
+    size_t fail_at;  // index of the command answered with fail_sw
+    uint16_t fail_sw;
+} mock_transport_t;
+
+static bool mock_send(ergo_transport_t *transport, const uint8_t *command, size_t len) {
+    mock_transport_t *mock = (mock_transport_t *) transport;
+    assert_true(mock->sent_count < MOCK_MAX_COMMANDS);
+    assert_int_equal(mock->pending, 0);
+    memcpy(mock->sent[mock->sent_count].data, command, len);
+    mock->sent[mock->sent_count++].len = len;
+    mock->pending++;
+    return true;
+}
+
+static bool mock_recv(ergo_transport_t *transport, uint8_t *response, size_t size, size_t *len) {
+    mock_transport_t *mock = (mock_transport_t *) transport;
+    assert_int_equal(mock->pending, 1);
+    mock->pending--;
+    const uint8_t *command = mock->sent[mock->received_count].data;
+    uint16_t sw = mock->received_count == mock->fail_at ? mock->fail_sw : APDU_SW_OK;
+    mock->received_count++;
+
+    size_t data_len = 0;
+    if (sw == APDU_SW_OK && command[1] == ERGO_INS_SIGN_TRANSACTION) {
+        if (command[2] == 0x01) {
+            response[data_len++] = MOCK_SESSION;
+        } else if (command[2] == 0x1F) {
+            response[data_len++] = 0;
+        } else if (command[2] == 0x20) {
+            memset(response, 0xAB, ERGO_SIGNATURE_LEN);
+            data_len = ERGO_SIGNATURE_LEN;
+        }
+    }
+    assert_true(data_len + 2 <= size);
+    response[data_len++] = sw >> 8;
+    response[data_len++] = sw & 0xFF;
+    *len = data_len;
+    return true;
+}
+
+static void mock_close(ergo_transport_t *transport) {
+    (void) transport;
+}
+
+static const ergo_transport_ops_t MOCK_OPS = {.send = mock_send,
+                                              .recv = mock_recv,
+                                              .close = mock_close};
+
+static void mock_init(mock_transport_t *mock) {
+    memset(mock, 0, sizeof(mock_transport_t));
+    mock->base.ops = &MOCK_OPS;
+    mock->fail_at = MOCK_MAX_COMMANDS;
+}
+
+typedef struct {
+    mock_transport_t *mock;
+    apdu_queue_t *queue;
+    uint8_t produced;
+    uint8_t count;
+    size_t received_at_produce[MOCK_MAX_COMMANDS];
+    uint8_t consumed;
+} counter_flow_t;
+
+static int produce_counter(void *ctx, apdu_command_t *command) {
+    counter_flow_t *flow = ctx;
+    if (flow->produced == flow->count) return 0;
+    flow->received_at_produce[flow->produced] = flow->mock->received_count;
+    if (flow->produced == 0) {
+        apdu_command_init(command, ERGO_INS_SIGN_TRANSACTION, 0x01, 0, 0);
+    } else {
+        apdu_command_init(command, ERGO_INS_SIGN_TRANSACTION, 0x10, 0, APDU_FLAG_SESSION_P2);
+    }
+    flow->produced++;
+    return 1;
+}
+
+static bool consume_counter(void *ctx,
+                            const apdu_command_t *command,
+                            const apdu_response_t *response) {
+    counter_flow_t *flow = ctx;
+    (void) command;
+    if (flow->consumed++ == 0) {
+        if (response->len != 1) return false;
+        flow->queue->session = response->data[0];
+    }
+    return true;
+}
+
+static void test_apdu_queue_pipelining(void **state) {
+    (void) state;
+
+    mock_transport_t mock;
+    mock_init(&mock);
+    apdu_queue_t queue;
+    apdu_queue_init(&queue, &mock.base);
+    counter_flow_t flow = {.mock = &mock, .queue = &queue, .count = 4};
+
+    assert_int_equal(apdu_queue_run(&queue, produce_counter, consume_counter, &flow), 0);
+    assert_int_equal(mock.sent_count, 4);
+    assert_int_equal(flow.consumed, 4);
+    assert_int_equal(queue.commands, 4);
+    // every next command is encoded before the response of the previous one
+    for (uint8_t i = 1; i < 4; i++) {
+        assert_int_equal(flow.received_at_produce[i], i - 1);
+    }
+    // session id of the first response is patched into P2 of the next ones
+    assert_int_equal(mock.sent[0].data[3], 0);
+    for (size_t i = 1; i < 4; i++) {
+        assert_int_equal(mock.sent[i].data[3], MOCK_SESSION);
+    }
+}
+
+static void test_apdu_queue_error_sw(void **state) {
+    (void) state;
+
+    mock_transport_t mock;
+    mock_init(&mock);
+    mock.fail_at = 1;
+    mock.fail_sw = 0x6985;
+    apdu_queue_t queue;
+    apdu_queue_init(&queue, &mock.base);
+    counter_flow_t flow = {.mock = &mock, .queue = &queue, .count = 4};
+
+    assert_int_equal(apdu_queue_run(&queue, produce_counter, consume_counter, &flow), 0x6985);
+    assert_int_equal(mock.sent_count, 2);
+    assert_int_equal(flow.consumed, 1);
+    assert_int_equal(queue.last_sw, 0x6985);
+}
+
+static void test_apdu_command_append(void **state) {
+    (void) state;
+
+    apdu_command_t command;
+    apdu_command_init(&command, 0x21, 0x15, 0x01, 0);
+    assert_true(apdu_command_append_u16(&command, 0x0102));
+    assert_true(apdu_command_append_u64(&command, 0x030405060708090AULL));
+    assert_int_equal(command.len, APDU_HEADER + 10);
+    const uint8_t expected[] = {0xE0, 0x21, 0x15, 0x01, 10, 0x01, 0x02, 0x03, 0x04, 0x05,
+                                0x06, 0x07, 0x08, 0x09, 0x0A};
+    assert_memory_equal(command.data, expected, sizeof(expected));
+
+    uint8_t data[255] = {0};
+    assert_false(apdu_command_append(&command, data, sizeof(data)));
+    assert_int_equal(command.len, APDU_HEADER + 10);
+    assert_true(apdu_command_append(&command, data, apdu_command_space(&command)));
+    assert_int_equal(command.data[4], 255);
+    assert_false(apdu_command_append_u8(&command, 0));
+}
+
+static void test_sign_transaction_chunks(void **state) {
+    (void) state;
+
+    uint8_t tree[300];
+    memset(tree, 0x11, sizeof(tree));
+    const uint8_t token_ids[1][ERGO_ID_LEN] = {{0x22}};
+    ergo_output_token_t output_tokens[22];
+    for (size_t i = 0; i < 22; i++) {
+        output_tokens[i] = (ergo_output_token_t){.index = 0, .amount = i + 1};
+    }
+    const ergo_box_t box = {.value = 1000, .ergo_tree = tree, .ergo_tree_len = 3};
+    const ergo_input_t input = {.box = &box};
+    const ergo_output_t outputs[] = {{.value = 900,
+                                      .kind = ERGO_OUTPUT_TREE,
+                                      .ergo_tree = tree,
+                                      .ergo_tree_len = sizeof(tree),
+                                      .tokens = output_tokens,
+                                      .tokens_count = 22},
+                                     {.value = 100, .kind = ERGO_OUTPUT_MINERS_FEE}};
+    ergo_sign_request_t request = {.token_ids = token_ids,
+                                   .token_ids_count = 1,
+                                   .inputs = &input,
+                                   .inputs_count = 1,
+                                   .outputs = outputs,
+                                   .outputs_count = 2};
+    assert_true(ergo_bip32_path_parse("m/44'/429'/0'/0/0", &request.path));
+
+    mock_transport_t mock;
+    mock_init(&mock);
+    ergo_client_t client;
+    ergo_client_init(&client, &mock.base);
+    uint8_t signature[ERGO_SIGNATURE_LEN];
+    assert_int_equal(ergo_client_sign_transaction(&client, &request, signature), 0);
+
+    const struct {
+        uint8_t p1;
+        uint8_t lc;
+    } expected[] = {{0x01, 22},       // start, without change paths
+                    {0x10, 8},        // tx start
+                    {0x11, 32},       // token ids
+                    {0x1B, 59},       // inline input box
+                    {0x1C, 3},        // tree
+                    {0x15, 21},       // output
+                    {0x16, 255},      // tree chunks
+                    {0x16, 45},       //
+                    {0x19, 21 * 12},  // tokens chunks
+                    {0x19, 1 * 12},   //
+                    {0x15, 21},       // fee output
+                    {0x17, 0},        //
+                    {0x20, 0}};       // confirm
+    assert_int_equal(mock.sent_count, sizeof(expected) / sizeof(expected[0]));
+    for (size_t i = 0; i < mock.sent_count; i++) {
+        const uint8_t *command = mock.sent[i].data;
+        assert_int_equal(command[0], APDU_CLA);
+        assert_int_equal(command[1], ERGO_INS_SIGN_TRANSACTION);
+        assert_int_equal(command[2], expected[i].p1);
+        assert_int_equal(command[3], i == 0 ? 0x01 : MOCK_SESSION);
+        assert_int_equal(command[4], expected[i].lc);
+    }
+    uint8_t expected_signature[ERGO_SIGNATURE_LEN];
+    memset(expected_signature, 0xAB, sizeof(expected_signature));
+    assert_memory_equal(signature, expected_signature, sizeof(signature));
+}
+
+static void test_sign_transaction_denied(void **state) {
+    (void) state;
+
+    const uint8_t tree[] = {0x00, 0x08, 0xCD};
+    const ergo_box_t box = {.value = 1000, .ergo_tree = tree, .ergo_tree_len = sizeof(tree)};
+    const ergo_input_t input = {.box = &box};
+    const ergo_output_t output = {.value = 1000, .kind = ERGO_OUTPUT_MINERS_FEE};
+    ergo_sign_request_t request = {.inputs = &input,
+                                   .inputs_count = 1,
+                                   .outputs = &output,
+                                   .outputs_count = 1};
+    assert_true(ergo_bip32_path_parse("m/44'/429'/0'/0/0", &request.path));
+
+    mock_transport_t mock;
+    mock_init(&mock);
+    mock.fail_at = 6;  // confirm
+    mock.fail_sw = 0x6985;
+    ergo_client_t client;
+    ergo_client_init(&client, &mock.base);
+    uint8_t signature[ERGO_SIGNATURE_LEN];
+    assert_int_equal(ergo_client_sign_transaction(&client, &request, signature), 0x6985);
+    assert_int_equal(mock.sent_count, 7);
+    assert_int_equal(mock.sent[6].data[2], 0x20);
+}
+
+static void test_bip32_path_parse(void **state) {
+    (void) state;
+
+    ergo_bip32_path_t path;
+    assert_true(ergo_bip32_path_parse("m/44'/429'/1'/0/5", &path));
+    assert_int_equal(path.len, 5);
+    assert_int_equal(path.path[0], 0x8000002C);
+    assert_int_equal(path.path[1], 0x800001AD);
+    assert_int_equal(path.path[2], 0x80000001);
+    assert_int_equal(path.path[4], 5);
+    assert_false(ergo_bip32_path_parse("", &path));
+    assert_false(ergo_bip32_path_parse("m/44'//1", &path));
+    assert_false(ergo_bip32_path_parse("m/44'/x", &path));
+    assert_false(ergo_bip32_path_parse("m/1/2/3/4/5/6/7/8/9/10/11", &path));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_apdu_queue_pipelining),
+                                       cmocka_unit_test(test_apdu_queue_error_sw),
+                                       cmocka_unit_test(test_apdu_command_append),
+                                       cmocka_unit_test(test_sign_transaction_chunks),
+                                       cmocka_unit_test(test_sign_transaction_denied),
+                                       cmocka_unit_test(test_bip32_path_parse)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
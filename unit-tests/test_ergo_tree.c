@@ -26,6 +26,22 @@ static void test_ergo_tree_generate_p2pk(void **state) {
     assert_memory_equal(tree, expected, sizeof(expected));
 }
 
+static void test_ergo_tree_generate_p2pk_compressed(void **state) {
+    (void) state;
+
+    const uint8_t public_key[COMPRESSED_PUBLIC_KEY_LEN] = {
+        0x03, 0x8b, 0x9f, 0xf8, 0x5d, 0xdd, 0x9f, 0x1e, 0x22, 0x88, 0xfc, 0x53, 0x9d,
+        0x39, 0xc7, 0xc4, 0xee, 0xb7, 0xa5, 0x56, 0xf4, 0xd8, 0x11, 0xcb, 0x73, 0x99,
+        0x64, 0x18, 0xde, 0x5a, 0xbd, 0xcb, 0x2a};
+    uint8_t tree[ERGO_TREE_P2PK_LEN] = {0};
+    ergo_tree_generate_p2pk_compressed(public_key, tree);
+    uint8_t expected[ERGO_TREE_P2PK_LEN] = {0x00, 0x08, 0xcd, 0x03, 0x8b, 0x9f, 0xf8, 0x5d, 0xdd,
+                                            0x9f, 0x1e, 0x22, 0x88, 0xfc, 0x53, 0x9d, 0x39, 0xc7,
+                                            0xc4, 0xee, 0xb7, 0xa5, 0x56, 0xf4, 0xd8, 0x11, 0xcb,
+                                            0x73, 0x99, 0x64, 0x18, 0xde, 0x5a, 0xbd, 0xcb, 0x2a};
+    assert_memory_equal(tree, expected, sizeof(expected));
+}
+
 static void test_ergo_tree_miners_fee_tree_mainnet(void **state) {
     (void) state;
 
@@ -66,6 +82,7 @@ static void test_ergo_tree_miners_fee_tree_testnet(void **state) {
 
 int main() {
     const struct CMUnitTest tests[] = {cmocka_unit_test(test_ergo_tree_generate_p2pk),
+                                       cmocka_unit_test(test_ergo_tree_generate_p2pk_compressed),
                                        cmocka_unit_test(test_ergo_tree_miners_fee_tree_mainnet),
                                        cmocka_unit_test(test_ergo_tree_miners_fee_tree_testnet)};
 
@@ -457,13 +457,10 @@ static void test_ergo_tx_serializer_full_add_box_change_tree(void** state) {
     (void) state;
 
     ERGO_TX_SERIALIZER_FULL_ADD_BOX();
-    const uint8_t raw_pub_key[] = {0x04, 0x8b, 0x9f, 0xf8, 0x5d, 0xdd, 0x9f, 0x1e, 0x22, 0x88, 0xfc,
-                                   0x53, 0x9d, 0x39, 0xc7, 0xc4, 0xee, 0xb7, 0xa5, 0x56, 0xf4, 0xd8,
-                                   0x11, 0xcb, 0x73, 0x99, 0x64, 0x18, 0xde, 0x5a, 0xbd, 0xcb, 0x2a,
-                                   0xfa, 0x2d, 0x53, 0x17, 0x16, 0x0a, 0x59, 0x50, 0x0f, 0x5d, 0x31,
-                                   0xfa, 0xe8, 0x6b, 0xce, 0xe9, 0xab, 0x1a, 0x60, 0x53, 0xa1, 0x1d,
-                                   0x53, 0x5d, 0x2d, 0x04, 0x3c, 0xe5, 0xcf, 0xf1, 0x0a, 0xe7};
-    assert_int_equal(ergo_tx_serializer_full_add_box_change_tree(&context, raw_pub_key),
+    const uint8_t pub_key[] = {0x03, 0x8b, 0x9f, 0xf8, 0x5d, 0xdd, 0x9f, 0x1e, 0x22, 0x88, 0xfc,
+                               0x53, 0x9d, 0x39, 0xc7, 0xc4, 0xee, 0xb7, 0xa5, 0x56, 0xf4, 0xd8,
+                               0x11, 0xcb, 0x73, 0x99, 0x64, 0x18, 0xde, 0x5a, 0xbd, 0xcb, 0x2a};
+    assert_int_equal(ergo_tx_serializer_full_add_box_change_tree(&context, pub_key),
                      ERGO_TX_SERIALIZER_FULL_RES_OK);
 }
 
@@ -0,0 +1,93 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "helpers/stats.h"
+#include "apdu_dispatcher.h"
+
+static void test_stats_accumulate(void **state) {
+    (void) state;
+    app_stats_reset();
+
+    app_stats_begin(CMD_SIGN_TRANSACTION, 0x10, 8);
+    APP_STATS_INC(blake2b_updates);
+    APP_STATS_INC(blake2b_updates);
+    app_stats_end();
+    app_stats_begin(CMD_ATTEST_INPUT_BOX, 0x01, 60);
+    APP_STATS_INC(hmac_calls);
+    app_stats_end();
+    app_stats_begin(CMD_SIGN_TRANSACTION, 0x10, 20);
+    APP_STATS_INC(derivations);
+    app_stats_end();
+
+    assert_int_equal(G_app_stats.count, 2);
+    const app_stats_entry_t *sign = &G_app_stats.entries[0];
+    assert_int_equal(sign->ins, CMD_SIGN_TRANSACTION);
+    assert_int_equal(sign->p1, 0x10);
+    assert_int_equal(sign->calls, 2);
+    assert_int_equal(sign->bytes_in, 28);
+    assert_int_equal(sign->blake2b_updates, 2);
+    assert_int_equal(sign->derivations, 1);
+    assert_int_equal(sign->hmac_calls, 0);
+    const app_stats_entry_t *attest = &G_app_stats.entries[1];
+    assert_int_equal(attest->calls, 1);
+    assert_int_equal(attest->bytes_in, 60);
+    assert_int_equal(attest->hmac_calls, 1);
+}
+
+static void test_stats_not_tracked(void **state) {
+    (void) state;
+    app_stats_reset();
+
+    // counters outside of a command and reading of the stats aren't counted
+    APP_STATS_INC(blake2b_updates);
+    app_stats_begin(CMD_GET_APP_STATS, 0x01, 0);
+    APP_STATS_INC(blake2b_updates);
+    app_stats_end();
+    assert_int_equal(G_app_stats.count, 0);
+
+    for (uint8_t i = 0; i < APP_STATS_MAX_ENTRIES; i++) {
+        app_stats_begin(CMD_SIGN_TRANSACTION, i, 1);
+        app_stats_end();
+    }
+    // table is full, new pairs are skipped, known ones are still counted
+    app_stats_begin(CMD_SIGN_TRANSACTION, APP_STATS_MAX_ENTRIES, 1);
+    APP_STATS_INC(derivations);
+    app_stats_end();
+    assert_int_equal(G_app_stats.count, APP_STATS_MAX_ENTRIES);
+    app_stats_begin(CMD_SIGN_TRANSACTION, 0, 1);
+    app_stats_end();
+    assert_int_equal(G_app_stats.entries[0].calls, 2);
+    for (uint8_t i = 0; i < APP_STATS_MAX_ENTRIES; i++) {
+        assert_int_equal(G_app_stats.entries[i].derivations, 0);
+    }
+}
+
+static void test_stats_end_without_begin(void **state) {
+    (void) state;
+    app_stats_reset();
+
+    // the end hook runs after failed commands too, the next command starts clean
+    app_stats_begin(CMD_DERIVE_ADDRESS, 0x01, 5);
+    app_stats_end();
+    app_stats_end();
+    APP_STATS_INC(derivations);
+    assert_int_equal(G_app_stats.entries[0].derivations, 0);
+
+    app_stats_reset();
+    assert_int_equal(G_app_stats.count, 0);
+    assert_null(G_app_stats.current);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_stats_accumulate),
+                                       cmocka_unit_test(test_stats_not_tracked),
+                                       cmocka_unit_test(test_stats_end_without_begin)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,111 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "commands/signtx/stx_change_paths.h"
+
+static void make_path(uint32_t path[static MAX_BIP32_PATH], uint32_t address) {
+    memset(path, 0, MAX_BIP32_PATH * sizeof(uint32_t));
+    path[0] = BIP32_HARDENED(44);
+    path[1] = BIP32_HARDENED(429);
+    path[2] = BIP32_HARDENED(0);
+    path[3] = 1;
+    path[4] = address;
+}
+
+static void make_key(uint8_t key[static COMPRESSED_PUBLIC_KEY_LEN], uint8_t seed) {
+    memset(key, seed, COMPRESSED_PUBLIC_KEY_LEN);
+    key[0] = 0x02;
+}
+
+static void test_stx_change_paths_add_get(void **state) {
+    (void) state;
+
+    sign_transaction_change_paths_ctx_t ctx;
+    stx_change_paths_init(&ctx);
+    assert_null(stx_change_paths_get(&ctx, 0));
+
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t key[COMPRESSED_PUBLIC_KEY_LEN];
+    uint8_t index = 0xFF;
+    make_path(path, 7);
+    make_key(key, 0x07);
+    assert_true(stx_change_paths_add(&ctx, path, 5, key, &index));
+    assert_int_equal(index, 0);
+    make_path(path, 8);
+    make_key(key, 0x08);
+    assert_true(stx_change_paths_add(&ctx, path, 5, key, &index));
+    assert_int_equal(index, 1);
+
+    const sign_transaction_change_path_t *change = stx_change_paths_get(&ctx, 1);
+    assert_non_null(change);
+    assert_int_equal(change->len, 5);
+    assert_memory_equal(change->path, path, 5 * sizeof(uint32_t));
+    assert_memory_equal(change->public_key, key, COMPRESSED_PUBLIC_KEY_LEN);
+    make_key(key, 0x07);
+    assert_memory_equal(stx_change_paths_get(&ctx, 0)->public_key, key, COMPRESSED_PUBLIC_KEY_LEN);
+    assert_null(stx_change_paths_get(&ctx, 2));
+}
+
+static void test_stx_change_paths_find(void **state) {
+    (void) state;
+
+    sign_transaction_change_paths_ctx_t ctx;
+    stx_change_paths_init(&ctx);
+
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t key[COMPRESSED_PUBLIC_KEY_LEN] = {0};
+    uint8_t index = 0;
+    make_path(path, 1);
+    assert_false(stx_change_paths_find(&ctx, path, 5, &index));
+    assert_true(stx_change_paths_add(&ctx, path, 5, key, &index));
+    make_path(path, 2);
+    assert_true(stx_change_paths_add(&ctx, path, 5, key, &index));
+
+    make_path(path, 2);
+    assert_true(stx_change_paths_find(&ctx, path, 5, &index));
+    assert_int_equal(index, 1);
+    make_path(path, 1);
+    assert_true(stx_change_paths_find(&ctx, path, 5, &index));
+    assert_int_equal(index, 0);
+    // Prefix of the registered path is another path
+    assert_false(stx_change_paths_find(&ctx, path, 4, &index));
+    make_path(path, 3);
+    assert_false(stx_change_paths_find(&ctx, path, 5, &index));
+}
+
+static void test_stx_change_paths_add_full(void **state) {
+    (void) state;
+
+    sign_transaction_change_paths_ctx_t ctx;
+    stx_change_paths_init(&ctx);
+
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t key[COMPRESSED_PUBLIC_KEY_LEN] = {0};
+    uint8_t index = 0;
+    for (uint8_t i = 0; i < CHANGE_PATHS_MAX_COUNT; i++) {
+        make_path(path, i);
+        assert_true(stx_change_paths_add(&ctx, path, 5, key, &index));
+        assert_int_equal(index, i);
+    }
+    make_path(path, CHANGE_PATHS_MAX_COUNT);
+    assert_false(stx_change_paths_add(&ctx, path, 5, key, &index));
+    assert_int_equal(ctx.count, CHANGE_PATHS_MAX_COUNT);
+
+    stx_change_paths_init(&ctx);
+    assert_false(stx_change_paths_add(&ctx, path, MAX_BIP32_PATH + 1, key, &index));
+    assert_int_equal(ctx.count, 0);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_stx_change_paths_add_get),
+                                       cmocka_unit_test(test_stx_change_paths_find),
+                                       cmocka_unit_test(test_stx_change_paths_add_full)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
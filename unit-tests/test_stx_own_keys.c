@@ -0,0 +1,128 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "commands/signtx/stx_own_keys.h"
+
+static void make_key(uint8_t key[static COMPRESSED_PUBLIC_KEY_LEN], uint8_t prefix, uint32_t x) {
+    memset(key, 0xAB, COMPRESSED_PUBLIC_KEY_LEN);
+    key[0] = prefix;
+    key[1] = x >> 24;
+    key[2] = x >> 16;
+    key[3] = x >> 8;
+    key[4] = x;
+}
+
+static void test_stx_own_keys_add_sorted(void **state) {
+    (void) state;
+
+    sign_transaction_own_keys_ctx_t ctx;
+    stx_own_keys_init(&ctx);
+    assert_true(stx_own_keys_is_empty(&ctx));
+
+    uint32_t xs[] = {0x30000000, 0x10000000, 0xF0000000, 0x20000000, 0x00000001};
+    uint8_t key[COMPRESSED_PUBLIC_KEY_LEN];
+    for (uint8_t i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+        make_key(key, 0x02, xs[i]);
+        assert_true(stx_own_keys_add(&ctx, key));
+    }
+    make_key(key, 0x03, 0x00000000);
+    assert_true(stx_own_keys_add(&ctx, key));
+    assert_false(stx_own_keys_is_empty(&ctx));
+    assert_int_equal(ctx.count, 6);
+
+    uint32_t expected[] = {0x00000001, 0x10000000, 0x20000000, 0x30000000, 0xF0000000};
+    for (uint8_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        make_key(key, 0x02, expected[i]);
+        assert_memory_equal(ctx.keys[i], key, COMPRESSED_PUBLIC_KEY_LEN);
+    }
+    // prefix is compared first
+    make_key(key, 0x03, 0x00000000);
+    assert_memory_equal(ctx.keys[5], key, COMPRESSED_PUBLIC_KEY_LEN);
+}
+
+static void test_stx_own_keys_add_duplicate(void **state) {
+    (void) state;
+
+    sign_transaction_own_keys_ctx_t ctx;
+    stx_own_keys_init(&ctx);
+
+    uint8_t key[COMPRESSED_PUBLIC_KEY_LEN];
+    make_key(key, 0x02, 0x10);
+    assert_true(stx_own_keys_add(&ctx, key));
+    assert_true(stx_own_keys_add(&ctx, key));
+    assert_int_equal(ctx.count, 1);
+}
+
+static void test_stx_own_keys_add_full(void **state) {
+    (void) state;
+
+    sign_transaction_own_keys_ctx_t ctx;
+    stx_own_keys_init(&ctx);
+
+    uint8_t key[COMPRESSED_PUBLIC_KEY_LEN];
+    for (uint16_t i = 0; i < STX_OWN_KEYS_MAX_COUNT; i++) {
+        make_key(key, 0x02, STX_OWN_KEYS_MAX_COUNT - i);
+        assert_true(stx_own_keys_add(&ctx, key));
+    }
+    make_key(key, 0x02, 0);
+    assert_false(stx_own_keys_add(&ctx, key));
+    // already added key is still accepted
+    make_key(key, 0x02, 1);
+    assert_true(stx_own_keys_add(&ctx, key));
+    assert_int_equal(ctx.count, STX_OWN_KEYS_MAX_COUNT);
+    for (uint16_t i = 1; i < ctx.count; i++) {
+        assert_true(memcmp(ctx.keys[i - 1], ctx.keys[i], COMPRESSED_PUBLIC_KEY_LEN) < 0);
+    }
+}
+
+static void test_stx_own_keys_contains(void **state) {
+    (void) state;
+
+    sign_transaction_own_keys_ctx_t ctx;
+    stx_own_keys_init(&ctx);
+
+    uint8_t key[COMPRESSED_PUBLIC_KEY_LEN];
+    make_key(key, 0x02, 0x10);
+    assert_false(stx_own_keys_contains(&ctx, key));
+
+    make_key(key, 0x02, 0x10);
+    assert_true(stx_own_keys_add(&ctx, key));
+    make_key(key, 0x02, 0x30);
+    assert_true(stx_own_keys_add(&ctx, key));
+    make_key(key, 0x02, 0x20);
+    assert_true(stx_own_keys_add(&ctx, key));
+
+    make_key(key, 0x02, 0x10);
+    assert_true(stx_own_keys_contains(&ctx, key));
+    make_key(key, 0x02, 0x20);
+    assert_true(stx_own_keys_contains(&ctx, key));
+    make_key(key, 0x02, 0x30);
+    assert_true(stx_own_keys_contains(&ctx, key));
+
+    // same X prefix, other parity or tail
+    make_key(key, 0x03, 0x20);
+    assert_false(stx_own_keys_contains(&ctx, key));
+    make_key(key, 0x02, 0x20);
+    key[COMPRESSED_PUBLIC_KEY_LEN - 1] ^= 0x01;
+    assert_false(stx_own_keys_contains(&ctx, key));
+
+    make_key(key, 0x02, 0x15);
+    assert_false(stx_own_keys_contains(&ctx, key));
+    make_key(key, 0x02, 0x40);
+    assert_false(stx_own_keys_contains(&ctx, key));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_stx_own_keys_add_sorted),
+                                       cmocka_unit_test(test_stx_own_keys_add_duplicate),
+                                       cmocka_unit_test(test_stx_own_keys_add_full),
+                                       cmocka_unit_test(test_stx_own_keys_contains)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
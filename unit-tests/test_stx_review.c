@@ -0,0 +1,282 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "commands/signtx/stx_review.h"
+#include "sw.h"
+
+// type + tree is set + box is finished
+#define FINISHED_STATE(type) ((uint8_t) (type) | 0xC0)
+
+static token_table_t tokens_table = {0};
+
+static void make_address_output(sign_transaction_output_info_ctx_t *output,
+                                uint64_t value,
+                                uint8_t key_byte) {
+    stx_output_info_init(output, value, &tokens_table);
+    output->state = FINISHED_STATE(SIGN_TRANSACTION_OUTPUT_INFO_TYPE_ADDRESS);
+    memset(output->public_key, key_byte, COMPRESSED_PUBLIC_KEY_LEN);
+}
+
+static void test_stx_review_add_load_output(void **state) {
+    (void) state;
+
+    static sign_transaction_review_ctx_t review;
+    static sign_transaction_output_info_ctx_t output;
+    stx_review_init(&review);
+
+    make_address_output(&output, 1000, 0x02);
+    output.tokens[3] = 10;
+    output.tokens[200] = 20;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    stx_output_info_init(&output, 2000, &tokens_table);
+    output.state = FINISHED_STATE(SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32);
+    output.bip32_path.len = 5;
+    for (uint8_t i = 0; i < 5; i++) output.bip32_path.path[i] = i;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    make_address_output(&output, 3000, 0x03);
+    output.tokens[7] = 30;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    assert_int_equal(stx_review_outputs_count(&review), 3);
+    assert_int_equal(review.tokens_count, 3);
+
+    memset(&output, 0xFF, sizeof(output));
+    assert_int_equal(stx_review_load_output(&review, 0, &tokens_table, &output), SW_OK);
+    assert_int_equal(stx_output_info_type(&output), SIGN_TRANSACTION_OUTPUT_INFO_TYPE_ADDRESS);
+    assert_true(stx_output_info_is_finished(&output));
+    assert_int_equal(output.value, 1000);
+    assert_ptr_equal(output.tokens_table, &tokens_table);
+    assert_int_equal(output.public_key[0], 0x02);
+    assert_int_equal(output.public_key[COMPRESSED_PUBLIC_KEY_LEN - 1], 0x02);
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+        uint64_t expected = i == 3 ? 10 : i == 200 ? 20 : 0;
+        assert_int_equal(output.tokens[i], expected);
+    }
+
+    assert_int_equal(stx_review_load_output(&review, 1, &tokens_table, &output), SW_OK);
+    assert_int_equal(stx_output_info_type(&output), SIGN_TRANSACTION_OUTPUT_INFO_TYPE_BIP32);
+    assert_int_equal(output.value, 2000);
+    assert_int_equal(output.bip32_path.len, 5);
+    assert_int_equal(output.bip32_path.path[4], 4);
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+        assert_int_equal(output.tokens[i], 0);
+    }
+
+    assert_int_equal(stx_review_load_output(&review, 2, &tokens_table, &output), SW_OK);
+    assert_int_equal(output.value, 3000);
+    assert_int_equal(output.public_key[0], 0x03);
+    assert_int_equal(output.tokens[7], 30);
+    assert_int_equal(output.tokens[3], 0);
+
+    assert_int_equal(stx_review_load_output(&review, 3, &tokens_table, &output), SW_BAD_STATE);
+}
+
+static void test_stx_review_add_not_finished(void **state) {
+    (void) state;
+
+    static sign_transaction_review_ctx_t review;
+    static sign_transaction_output_info_ctx_t output;
+    stx_review_init(&review);
+
+    make_address_output(&output, 1000, 0x02);
+    output.state &= 0x7F;  // box isn't finished
+    assert_int_equal(stx_review_add_output(&review, &output), SW_BAD_STATE);
+    assert_int_equal(stx_review_outputs_count(&review), 0);
+}
+
+static void test_stx_review_outputs_overflow(void **state) {
+    (void) state;
+
+    static sign_transaction_review_ctx_t review;
+    static sign_transaction_output_info_ctx_t output;
+    stx_review_init(&review);
+
+    for (uint16_t i = 0; i < REVIEW_MAX_OUTPUTS; i++) {
+        make_address_output(&output, 1000, (uint8_t) i);
+        assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+    }
+    make_address_output(&output, 1000, (uint8_t) REVIEW_MAX_OUTPUTS);
+    assert_int_equal(stx_review_add_output(&review, &output), SW_SCREENS_BUFFER_OVERFLOW);
+    assert_int_equal(stx_review_outputs_count(&review), REVIEW_MAX_OUTPUTS);
+
+    // Known destination is still added
+    make_address_output(&output, 1000, 0);
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+    assert_int_equal(review.outputs[0].value, 2000);
+}
+
+static void test_stx_review_aggregate_by_destination(void **state) {
+    (void) state;
+
+    static sign_transaction_review_ctx_t review;
+    static sign_transaction_output_info_ctx_t output;
+    stx_review_init(&review);
+
+    make_address_output(&output, 1000, 0x02);
+    output.tokens[3] = 10;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    stx_output_info_init(&output, 500, &tokens_table);
+    output.state = FINISHED_STATE(SIGN_TRANSACTION_OUTPUT_INFO_TYPE_SCRIPT_HASH);
+    memset(output.tree_hash, 0x02, CX_BLAKE2B_256_SIZE);
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    make_address_output(&output, 2000, 0x02);
+    output.tokens[3] = 5;
+    output.tokens[4] = 7;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    stx_output_info_init(&output, 700, &tokens_table);
+    output.state = FINISHED_STATE(SIGN_TRANSACTION_OUTPUT_INFO_TYPE_SCRIPT_HASH);
+    memset(output.tree_hash, 0x02, CX_BLAKE2B_256_SIZE);
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    stx_output_info_init(&output, 10, &tokens_table);
+    output.state = FINISHED_STATE(SIGN_TRANSACTION_OUTPUT_INFO_TYPE_MINERS_FEE);
+    output.tokens[9] = 1;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    assert_int_equal(stx_review_outputs_count(&review), 3);
+    assert_int_equal(review.tokens_count, 3);
+    assert_int_equal(stx_review_output_tokens_count(&review, 0), 2);
+    assert_int_equal(stx_review_output_tokens_count(&review, 1), 0);
+    assert_int_equal(stx_review_output_tokens_count(&review, 2), 1);
+    assert_int_equal(stx_review_output_type(&review, 1),
+                     SIGN_TRANSACTION_OUTPUT_INFO_TYPE_SCRIPT_HASH);
+
+    assert_int_equal(stx_review_load_output(&review, 0, &tokens_table, &output), SW_OK);
+    assert_int_equal(stx_output_info_type(&output), SIGN_TRANSACTION_OUTPUT_INFO_TYPE_ADDRESS);
+    assert_int_equal(output.value, 3000);
+    assert_int_equal(output.tokens[3], 15);
+    assert_int_equal(output.tokens[4], 7);
+    assert_int_equal(output.tokens[9], 0);
+
+    assert_int_equal(stx_review_load_output(&review, 1, &tokens_table, &output), SW_OK);
+    assert_int_equal(stx_output_info_type(&output), SIGN_TRANSACTION_OUTPUT_INFO_TYPE_SCRIPT_HASH);
+    assert_int_equal(output.value, 1200);
+
+    assert_int_equal(stx_review_load_output(&review, 2, &tokens_table, &output), SW_OK);
+    assert_int_equal(stx_output_info_type(&output), SIGN_TRANSACTION_OUTPUT_INFO_TYPE_MINERS_FEE);
+    assert_int_equal(output.value, 20);
+    assert_int_equal(output.tokens[9], 2);
+}
+
+static void test_stx_review_aggregate_overflow(void **state) {
+    (void) state;
+
+    static sign_transaction_review_ctx_t review;
+    static sign_transaction_output_info_ctx_t output;
+    stx_review_init(&review);
+
+    make_address_output(&output, UINT64_MAX - 1, 0x02);
+    output.tokens[1] = 1;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    make_address_output(&output, 2, 0x02);
+    output.tokens[1] = 1;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_U64_OVERFLOW);
+
+    make_address_output(&output, 1, 0x02);
+    output.tokens[1] = UINT64_MAX;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_U64_OVERFLOW);
+
+    // Log isn't changed by the failed outputs
+    assert_int_equal(review.outputs[0].value, UINT64_MAX - 1);
+    assert_int_equal(review.token_values[0], 1);
+}
+
+static void test_stx_review_tokens_overflow(void **state) {
+    (void) state;
+
+    static sign_transaction_review_ctx_t review;
+    static sign_transaction_output_info_ctx_t output;
+    stx_review_init(&review);
+
+    make_address_output(&output, 1000, 0x02);
+    for (uint16_t i = 0; i < REVIEW_MAX_TOKENS - 1; i++) {
+        output.tokens[i] = 1;
+    }
+    assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+
+    // Two more tokens don't fit, output isn't added
+    make_address_output(&output, 2000, 0x03);
+    output.tokens[0] = 1;
+    output.tokens[1] = 1;
+    assert_int_equal(stx_review_add_output(&review, &output), SW_SCREENS_BUFFER_OVERFLOW);
+    assert_int_equal(stx_review_outputs_count(&review), 1);
+    assert_int_equal(review.tokens_count, REVIEW_MAX_TOKENS - 1);
+}
+
+static void test_stx_review_all_tokens(void **state) {
+    (void) state;
+
+    static sign_transaction_review_ctx_t review;
+    static sign_transaction_output_info_ctx_t output;
+    stx_review_init(&review);
+
+    // Every token of the transaction is sent to one address in boxes of 85 tokens
+    for (uint16_t box = 0; box < 3; box++) {
+        make_address_output(&output, 1000, 0x02);
+        for (uint16_t i = box * 85; i < (box + 1) * 85; i++) {
+            output.tokens[i] = i + 1;
+        }
+        assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+    }
+    assert_int_equal(stx_review_outputs_count(&review), 1);
+    // Address, amount, token id and value screens: more than 255 review screens
+    assert_int_equal(stx_review_output_tokens_count(&review, 0), TOKEN_MAX_COUNT);
+
+    assert_int_equal(stx_review_load_output(&review, 0, &tokens_table, &output), SW_OK);
+    assert_int_equal(output.value, 3000);
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+        assert_int_equal(output.tokens[i], i + 1);
+    }
+}
+
+static void test_stx_review_previous_limits(void **state) {
+    (void) state;
+
+    static sign_transaction_review_ctx_t review;
+    static sign_transaction_output_info_ctx_t output;
+    stx_review_init(&review);
+
+    // 100 tokens and 105 destinations were shown before the review log
+    for (uint16_t i = 0; i < 105; i++) {
+        make_address_output(&output, 1000 + i, (uint8_t) i);
+        if (i < 100) output.tokens[i] = i + 1;
+        assert_int_equal(stx_review_add_output(&review, &output), SW_OK);
+    }
+    assert_int_equal(stx_review_outputs_count(&review), 105);
+    assert_int_equal(review.tokens_count, 100);
+
+    assert_int_equal(stx_review_load_output(&review, 99, &tokens_table, &output), SW_OK);
+    assert_int_equal(output.value, 1099);
+    assert_int_equal(output.public_key[0], 99);
+    assert_int_equal(output.tokens[99], 100);
+    assert_int_equal(output.tokens[98], 0);
+    assert_int_equal(stx_review_load_output(&review, 104, &tokens_table, &output), SW_OK);
+    assert_int_equal(output.value, 1104);
+    assert_int_equal(stx_review_output_tokens_count(&review, 104), 0);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_stx_review_add_load_output),
+                                       cmocka_unit_test(test_stx_review_add_not_finished),
+                                       cmocka_unit_test(test_stx_review_outputs_overflow),
+                                       cmocka_unit_test(test_stx_review_aggregate_by_destination),
+                                       cmocka_unit_test(test_stx_review_aggregate_overflow),
+                                       cmocka_unit_test(test_stx_review_tokens_overflow),
+                                       cmocka_unit_test(test_stx_review_all_tokens),
+                                       cmocka_unit_test(test_stx_review_previous_limits)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
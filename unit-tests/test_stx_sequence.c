@@ -0,0 +1,182 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "commands/signtx/stx_sequence.h"
+#include "ergo/tx_ser_full.h"
+#include "common/rwbuffer.h"
+
+static const uint8_t INPUT_ID[ERGO_ID_LEN] = {0xee, 0x52, 0x85, 0xa4};
+// Address 3WxoJWccGfjzGAo6XXp4ugrUuMz3SjkqkMS21yfNm7DP1iwakvXs
+static uint8_t ERGO_TREE[] = {0x00, 0x08, 0xcd, 0x03, 0x20, 0x94, 0xbc, 0x1f, 0xc3,
+                              0xe5, 0x13, 0x36, 0x2a, 0x2e, 0x3d, 0x2e, 0xb8, 0x02,
+                              0x28, 0x3c, 0x98, 0xbc, 0x31, 0x40, 0xdf, 0xf8, 0xf5,
+                              0x4c, 0x6f, 0x40, 0x9d, 0xd6, 0x4e, 0xae, 0x18, 0xc3};
+
+// Data calls of a transaction with one input and an output with the miners fee
+#define TX_CALLS_COUNT 5
+
+typedef struct {
+    ergo_tx_serializer_full_context_t tx;
+    cx_blake2b_t hash;
+    token_table_t tokens_table;
+    sign_transaction_sequence_t sequence;
+} session_t;
+
+static ergo_tx_serializer_full_result_e tx_call(session_t *session, uint8_t call) {
+    BUFFER_NEW_LOCAL_EMPTY(empty, 1);
+    BUFFER_FROM_ARRAY(tree, ERGO_TREE, sizeof(ERGO_TREE));
+    switch (call) {
+        case 0:
+            return ergo_tx_serializer_full_add_input(&session->tx, INPUT_ID, 1, 0);
+        case 1:
+            return ergo_tx_serializer_full_add_input_tokens(&session->tx, INPUT_ID, 0, &empty);
+        case 2:
+            return ergo_tx_serializer_full_add_box(&session->tx, 1000, sizeof(ERGO_TREE), 1, 0, 0);
+        case 3:
+            return ergo_tx_serializer_full_add_box_ergo_tree(&session->tx, &tree);
+        case 4:
+            return ergo_tx_serializer_full_add_box(&session->tx, 100, 0, 1, 0, 0);
+        default:
+            return ergo_tx_serializer_full_add_box_miners_fee_tree(&session->tx, false);
+    }
+}
+
+static void session_start(session_t *session) {
+    memset(session, 0, sizeof(session_t));
+    assert_true(blake2b_256_init(&session->hash));
+    assert_int_equal(ergo_tx_serializer_full_init(&session->tx,
+                                                  1,
+                                                  0,
+                                                  2,
+                                                  0,
+                                                  &session->hash,
+                                                  &session->tokens_table),
+                     ERGO_TX_SERIALIZER_FULL_RES_OK);
+    stx_sequence_init(&session->sequence);
+}
+
+// Sends the call like the handler: acknowledged only if it was processed
+static bool session_send(session_t *session, uint8_t call) {
+    bool is_ok = tx_call(session, call) == ERGO_TX_SERIALIZER_FULL_RES_OK;
+    stx_sequence_acknowledge(&session->sequence, is_ok);
+    return is_ok;
+}
+
+static void session_end(session_t *session) {
+    _cx_blake2b_free_data(&session->hash);
+}
+
+static void test_stx_sequence_in_order(void **state) {
+    (void) state;
+
+    static session_t session;
+    session_start(&session);
+    uint16_t count = 0xFFFF;
+    assert_true(stx_sequence_resume(&session.sequence, &count));
+    assert_int_equal(count, 0);
+
+    for (uint8_t call = 0; call <= TX_CALLS_COUNT; call++) {
+        assert_true(session_send(&session, call));
+        assert_true(stx_sequence_resume(&session.sequence, &count));
+        assert_int_equal(count, call + 1);
+    }
+    assert_true(ergo_tx_serializer_full_is_finished(&session.tx));
+    session_end(&session);
+}
+
+static void test_stx_sequence_out_of_order(void **state) {
+    (void) state;
+
+    static session_t session;
+    session_start(&session);
+    uint16_t count = 0;
+
+    assert_true(session_send(&session, 0));
+    // output box before the input is finished
+    assert_false(session_send(&session, 2));
+    assert_false(stx_sequence_resume(&session.sequence, &count));
+
+    // next calls aren't counted, session can't be resumed
+    assert_false(session_send(&session, 1));
+    stx_sequence_acknowledge(&session.sequence, true);
+    assert_false(stx_sequence_resume(&session.sequence, &count));
+    assert_int_equal(session.sequence.count, 1);
+    session_end(&session);
+}
+
+static void test_stx_sequence_duplicate(void **state) {
+    (void) state;
+
+    static session_t session;
+    session_start(&session);
+    uint16_t count = 0;
+
+    assert_true(session_send(&session, 0));
+    assert_true(session_send(&session, 1));
+    // repeated call after a transport failure
+    assert_false(session_send(&session, 1));
+    assert_false(stx_sequence_resume(&session.sequence, &count));
+    assert_int_equal(session.sequence.count, 2);
+    session_end(&session);
+}
+
+static void test_stx_sequence_resume(void **state) {
+    (void) state;
+
+    static session_t session;
+    session_start(&session);
+    uint16_t count = 0;
+
+    // response of the third call is lost, client asks where to continue
+    for (uint8_t call = 0; call < 3; call++) {
+        assert_true(session_send(&session, call));
+    }
+    assert_true(stx_sequence_resume(&session.sequence, &count));
+    assert_int_equal(count, 3);
+
+    // and skips the acknowledged calls
+    for (uint8_t call = count; call <= TX_CALLS_COUNT; call++) {
+        assert_true(session_send(&session, call));
+    }
+    assert_true(ergo_tx_serializer_full_is_finished(&session.tx));
+    assert_true(stx_sequence_resume(&session.sequence, &count));
+    assert_int_equal(count, TX_CALLS_COUNT + 1);
+    session_end(&session);
+}
+
+static void test_stx_sequence_wraparound(void **state) {
+    (void) state;
+
+    sign_transaction_sequence_t sequence;
+    stx_sequence_init(&sequence);
+    sequence.count = UINT16_MAX - 1;
+    uint16_t count = 0;
+
+    stx_sequence_acknowledge(&sequence, true);
+    assert_true(stx_sequence_resume(&sequence, &count));
+    assert_int_equal(count, UINT16_MAX);
+
+    stx_sequence_acknowledge(&sequence, true);
+    assert_true(stx_sequence_resume(&sequence, &count));
+    assert_int_equal(count, 0);
+
+    stx_sequence_acknowledge(&sequence, true);
+    assert_true(stx_sequence_resume(&sequence, &count));
+    assert_int_equal(count, 1);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_stx_sequence_in_order),
+                                       cmocka_unit_test(test_stx_sequence_out_of_order),
+                                       cmocka_unit_test(test_stx_sequence_duplicate),
+                                       cmocka_unit_test(test_stx_sequence_resume),
+                                       cmocka_unit_test(test_stx_sequence_wraparound)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,129 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include <os.h>
+#include "storage.h"
+#include "helpers/trusted_apps.h"
+
+// NVM of the app, writable on the host
+const internal_storage_t N_storage_real __attribute__((section(".data.nvm")));
+
+void nvm_write(void *dst_adr, void *src_adr, unsigned int src_len) {
+    memcpy(dst_adr, src_adr, src_len);
+}
+
+static void storage_reset(bool enabled) {
+    internal_storage_t storage;
+    memset(&storage, 0, sizeof(storage));
+    nvm_write((void *) &N_storage, &storage, sizeof(storage));
+    trusted_apps_set_enabled(enabled);
+}
+
+static void test_trusted_apps_add_contains(void **state) {
+    (void) state;
+    storage_reset(true);
+
+    assert_true(trusted_apps_is_enabled());
+    assert_int_equal(trusted_apps_count(), 0);
+    assert_false(trusted_apps_contains(0x01020304));
+
+    trusted_apps_add(0x01020304);
+    trusted_apps_add(0x05060708);
+    assert_int_equal(trusted_apps_count(), 2);
+    assert_true(trusted_apps_contains(0x01020304));
+    assert_true(trusted_apps_contains(0x05060708));
+    assert_false(trusted_apps_contains(0x090a0b0c));
+
+    // already remembered token takes no slot
+    trusted_apps_add(0x01020304);
+    assert_int_equal(trusted_apps_count(), 2);
+    assert_int_equal(N_storage.trusted_apps_next, 2);
+}
+
+static void test_trusted_apps_zero_id(void **state) {
+    (void) state;
+    storage_reset(true);
+
+    // 0 is an empty slot, never remembered nor found
+    trusted_apps_add(0);
+    assert_int_equal(trusted_apps_count(), 0);
+    assert_false(trusted_apps_contains(0));
+    assert_int_equal(N_storage.trusted_apps_next, 0);
+}
+
+static void test_trusted_apps_evict(void **state) {
+    (void) state;
+    storage_reset(true);
+
+    for (uint32_t id = 1; id <= TRUSTED_APPS_MAX_COUNT; id++) {
+        trusted_apps_add(id);
+    }
+    assert_int_equal(trusted_apps_count(), TRUSTED_APPS_MAX_COUNT);
+    assert_int_equal(N_storage.trusted_apps_next, 0);
+
+    // the oldest token is replaced
+    trusted_apps_add(TRUSTED_APPS_MAX_COUNT + 1);
+    assert_int_equal(trusted_apps_count(), TRUSTED_APPS_MAX_COUNT);
+    assert_false(trusted_apps_contains(1));
+    assert_true(trusted_apps_contains(2));
+    assert_true(trusted_apps_contains(TRUSTED_APPS_MAX_COUNT + 1));
+
+    trusted_apps_add(TRUSTED_APPS_MAX_COUNT + 2);
+    assert_false(trusted_apps_contains(2));
+    assert_true(trusted_apps_contains(3));
+    assert_int_equal(N_storage.trusted_apps_next, 2);
+}
+
+static void test_trusted_apps_forget(void **state) {
+    (void) state;
+    storage_reset(true);
+
+    trusted_apps_add(0x01020304);
+    trusted_apps_add(0x05060708);
+    trusted_apps_clear();
+    assert_true(trusted_apps_is_enabled());
+    assert_int_equal(trusted_apps_count(), 0);
+    assert_false(trusted_apps_contains(0x01020304));
+    assert_int_equal(N_storage.trusted_apps_next, 0);
+
+    // slots are reused from the start
+    trusted_apps_add(0x090a0b0c);
+    assert_int_equal(N_storage.trusted_apps[0], 0x090a0b0c);
+}
+
+static void test_trusted_apps_disabled(void **state) {
+    (void) state;
+    storage_reset(true);
+
+    trusted_apps_add(0x01020304);
+    // disabling forgets remembered tokens
+    trusted_apps_set_enabled(false);
+    assert_false(trusted_apps_is_enabled());
+    assert_int_equal(trusted_apps_count(), 0);
+
+    trusted_apps_add(0x05060708);
+    assert_int_equal(trusted_apps_count(), 0);
+    assert_false(trusted_apps_contains(0x05060708));
+
+    // enabling again starts with an empty registry
+    trusted_apps_set_enabled(true);
+    assert_false(trusted_apps_contains(0x01020304));
+    trusted_apps_add(0x05060708);
+    assert_true(trusted_apps_contains(0x05060708));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_trusted_apps_add_contains),
+                                       cmocka_unit_test(test_trusted_apps_zero_id),
+                                       cmocka_unit_test(test_trusted_apps_evict),
+                                       cmocka_unit_test(test_trusted_apps_forget),
+                                       cmocka_unit_test(test_trusted_apps_disabled)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
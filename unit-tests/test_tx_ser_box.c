@@ -59,7 +59,7 @@ static void test_ergo_tx_serializer_box_init_too_many_tokens(void **state) {
     uint64_t value = 12345;
     uint32_t ergo_tree_size = 2;
     uint32_t creation_height = 3;
-    uint8_t tokens_count = TOKEN_MAX_COUNT + 1;
+    uint8_t tokens_count = BOX_TOKEN_MAX_COUNT + 1;
     uint32_t registers_size = 1;
     cx_blake2b_t hash;
     ergo_tx_serializer_box_id_hash_init(&hash);
@@ -310,13 +310,11 @@ static void test_ergo_tx_serializer_box_add_change_tree(void **state) {
     (void) state;
 
     ERGO_TX_SERIALIZER_BOX_INIT(context);
-    const uint8_t raw_public_key[] = {
-        0x04, 0x8b, 0x9f, 0xf8, 0x5d, 0xdd, 0x9f, 0x1e, 0x22, 0x88, 0xfc, 0x53, 0x9d,
-        0x39, 0xc7, 0xc4, 0xee, 0xb7, 0xa5, 0x56, 0xf4, 0xd8, 0x11, 0xcb, 0x73, 0x99,
-        0x64, 0x18, 0xde, 0x5a, 0xbd, 0xcb, 0x2a, 0xfa, 0x2d, 0x53, 0x17, 0x16, 0x0a,
-        0x59, 0x50, 0x0f, 0x5d, 0x31, 0xfa, 0xe8, 0x6b, 0xce, 0xe9, 0xab, 0x1a, 0x60,
-        0x53, 0xa1, 0x1d, 0x53, 0x5d, 0x2d, 0x04, 0x3c, 0xe5, 0xcf, 0xf1, 0x0a, 0xe7};
-    assert_int_equal(ergo_tx_serializer_box_add_change_tree(&context, raw_public_key),
+    const uint8_t public_key[] = {0x03, 0x8b, 0x9f, 0xf8, 0x5d, 0xdd, 0x9f, 0x1e, 0x22,
+                                  0x88, 0xfc, 0x53, 0x9d, 0x39, 0xc7, 0xc4, 0xee, 0xb7,
+                                  0xa5, 0x56, 0xf4, 0xd8, 0x11, 0xcb, 0x73, 0x99, 0x64,
+                                  0x18, 0xde, 0x5a, 0xbd, 0xcb, 0x2a};
+    assert_int_equal(ergo_tx_serializer_box_add_change_tree(&context, public_key),
                      ERGO_TX_SERIALIZER_BOX_RES_OK);
     uint8_t expected_hash[] = {0xb9, 0x60, 0x00, 0x08, 0xcd, 0x03, 0x8b, 0x9f, 0xf8, 0x5d,
                                0xdd, 0x9f, 0x1e, 0x22, 0x88, 0xfc, 0x53, 0x9d, 0x39, 0xc7,
@@ -333,8 +331,8 @@ static void test_ergo_tx_serializer_box_add_change_tree_bad_state(void **state)
     ergo_tx_serializer_box_context_t context;
     memset(&context, 0, sizeof(ergo_tx_serializer_box_context_t));
     context.state = ERGO_TX_SERIALIZER_BOX_STATE_TREE_ADDED;
-    const uint8_t raw_public_key[PUBLIC_KEY_LEN] = {0};
-    assert_int_equal(ergo_tx_serializer_box_add_change_tree(&context, raw_public_key),
+    const uint8_t public_key[COMPRESSED_PUBLIC_KEY_LEN] = {0};
+    assert_int_equal(ergo_tx_serializer_box_add_change_tree(&context, public_key),
                      ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_STATE);
     assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_ERROR);
 }
@@ -343,9 +341,9 @@ static void test_ergo_tx_serializer_box_add_change_tree_bad_hash(void **state) {
     (void) state;
 
     ERGO_TX_SERIALIZER_BOX_INIT(context);
-    const uint8_t raw_public_key[PUBLIC_KEY_LEN] = {0};
+    const uint8_t public_key[COMPRESSED_PUBLIC_KEY_LEN] = {0};
     memset(context.hash, 0, sizeof(*context.hash));
-    assert_int_equal(ergo_tx_serializer_box_add_change_tree(&context, raw_public_key),
+    assert_int_equal(ergo_tx_serializer_box_add_change_tree(&context, public_key),
                      ERGO_TX_SERIALIZER_BOX_RES_ERR_HASHER);
     assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_ERROR);
 }
@@ -387,6 +385,212 @@ static void test_ergo_tx_serializer_box_add_tokens(void **state) {
     assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_TOKENS_ADDED);
 }
 
+static void test_ergo_tx_serializer_box_add_tokens_wide_index(void **state) {
+    (void) state;
+
+    ergo_tx_serializer_box_context_t context;
+    cx_blake2b_t hash;
+    assert_true(ergo_tx_serializer_box_id_hash_init(&hash));
+    assert_int_equal(ergo_tx_serializer_box_init(&context, 12345, 2, 3, 2, 1, &hash),
+                     ERGO_TX_SERIALIZER_BOX_RES_OK);
+
+    token_table_t table = {0};
+    ergo_tx_serializer_table_context_t table_ctx;
+    assert_int_equal(ergo_tx_serializer_table_init(&table_ctx, TOKEN_MAX_COUNT, &table),
+                     ERGO_TX_SERIALIZER_TABLE_RES_OK);
+    for (uint16_t i = 0; i < TOKEN_MAX_COUNT; i++) {
+        uint8_t id[ERGO_ID_LEN];
+        memset(id, (uint8_t) i, ERGO_ID_LEN);
+        assert_int_equal(token_table_add_token(&table, id), i);
+    }
+
+    uint8_t tree_chunk_array[] = {0x01, 0x02};
+    BUFFER_FROM_ARRAY(tree_chunk, tree_chunk_array, sizeof(tree_chunk_array));
+    ergo_tx_serializer_box_add_tree(&context, &tree_chunk);
+    // index 200 takes 2 bytes in VLQ
+    uint8_t tokens_array[] = {0x00, 0x00, 0x00, 0xC8, 0x00, 0x00, 0x00, 0x00,
+                              0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xFE,
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02};
+    BUFFER_FROM_ARRAY(tokens, tokens_array, sizeof(tokens_array));
+    assert_int_equal(ergo_tx_serializer_box_add_tokens(&context, &tokens, &table_ctx),
+                     ERGO_TX_SERIALIZER_BOX_RES_OK);
+
+    uint8_t expected_hash[] = {0xb9, 0x60, 0x01, 0x02, 0x03, 0x02, 0xc8,
+                               0x01, 0x01, 0xfe, 0x01, 0x02};
+    VERIFY_HASH(context.hash, expected_hash);
+    assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_TOKENS_ADDED);
+}
+
+static void test_ergo_tx_serializer_box_add_tokens_bad_index(void **state) {
+    (void) state;
+
+    ERGO_TX_SERIALIZER_BOX_INIT(context);
+
+    token_table_t table = {0};
+    ergo_tx_serializer_table_context_t table_ctx;
+    assert_int_equal(ergo_tx_serializer_table_init(&table_ctx, TOKEN_MAX_COUNT, &table),
+                     ERGO_TX_SERIALIZER_TABLE_RES_OK);
+
+    uint8_t tree_chunk_array[] = {0x01, 0x02};
+    BUFFER_FROM_ARRAY(tree_chunk, tree_chunk_array, sizeof(tree_chunk_array));
+    ergo_tx_serializer_box_add_tree(&context, &tree_chunk);
+    uint8_t tokens_array[] = {0x00, 0x00, 0x00, TOKEN_MAX_COUNT, 0x00, 0x00,
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
+    BUFFER_FROM_ARRAY(tokens, tokens_array, sizeof(tokens_array));
+    assert_int_equal(ergo_tx_serializer_box_add_tokens(&context, &tokens, &table_ctx),
+                     ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_INDEX);
+    assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_ERROR);
+    _cx_blake2b_free_data(&hash);
+}
+
+typedef struct {
+    uint8_t calls;
+    uint8_t ids[16];  // first byte of the token id
+    uint64_t values[16];
+} token_calls_t;
+
+static ergo_tx_serializer_box_result_e on_token(ergo_tx_serializer_box_type_e type,
+                                                const uint8_t id[static ERGO_ID_LEN],
+                                                uint64_t value,
+                                                void *context) {
+    (void) type;
+    token_calls_t *calls = (token_calls_t *) context;
+    calls->ids[calls->calls] = id[0];
+    calls->values[calls->calls] = value;
+    calls->calls++;
+    return ERGO_TX_SERIALIZER_BOX_RES_OK;
+}
+
+static void test_ergo_tx_serializer_box_add_tokens_batches(void **state) {
+    (void) state;
+
+    ergo_tx_serializer_box_context_t context;
+    cx_blake2b_t hash;
+    assert_true(ergo_tx_serializer_box_id_hash_init(&hash));
+    assert_int_equal(ergo_tx_serializer_box_init(&context, 12345, 2, 3, 10, 1, &hash),
+                     ERGO_TX_SERIALIZER_BOX_RES_OK);
+    token_calls_t calls = {0};
+    ergo_tx_serializer_box_set_callbacks(&context, NULL, on_token, NULL, &calls);
+
+    token_table_t table = {0};
+    ergo_tx_serializer_table_context_t table_ctx;
+    assert_int_equal(ergo_tx_serializer_table_init(&table_ctx, 10, &table),
+                     ERGO_TX_SERIALIZER_TABLE_RES_OK);
+    for (uint8_t i = 0; i < 10; i++) {
+        uint8_t id[ERGO_ID_LEN];
+        memset(id, 0xA0 + i, ERGO_ID_LEN);
+        assert_int_equal(token_table_add_token(&table, id), i);
+    }
+
+    uint8_t tree_chunk_array[] = {0x01, 0x02};
+    BUFFER_FROM_ARRAY(tree_chunk, tree_chunk_array, sizeof(tree_chunk_array));
+    ergo_tx_serializer_box_add_tree(&context, &tree_chunk);
+
+    // 10 pairs in reverse order: index 9 - i, value 1 + i
+    uint8_t tokens_array[10 * 12] = {0};
+    for (uint8_t i = 0; i < 10; i++) {
+        tokens_array[i * 12 + 3] = 9 - i;
+        tokens_array[i * 12 + 11] = 1 + i;
+    }
+    // First chunk fits one batch, second one takes two batches
+    BUFFER_FROM_ARRAY(first, tokens_array, 3 * 12);
+    assert_int_equal(ergo_tx_serializer_box_add_tokens(&context, &first, &table_ctx),
+                     ERGO_TX_SERIALIZER_BOX_RES_MORE_DATA);
+    assert_int_equal(context.tokens_count, 7);
+    BUFFER_FROM_ARRAY(second, tokens_array + 3 * 12, 7 * 12);
+    assert_int_equal(ergo_tx_serializer_box_add_tokens(&context, &second, &table_ctx),
+                     ERGO_TX_SERIALIZER_BOX_RES_OK);
+
+    assert_int_equal(calls.calls, 10);
+    for (uint8_t i = 0; i < 10; i++) {
+        assert_int_equal(calls.ids[i], 0xA0 + 9 - i);
+        assert_int_equal(calls.values[i], 1 + i);
+    }
+    uint8_t expected_hash[6 + 10 * 2] = {0xb9, 0x60, 0x01, 0x02, 0x03, 0x0a};
+    for (uint8_t i = 0; i < 10; i++) {
+        expected_hash[6 + i * 2] = 9 - i;
+        expected_hash[6 + i * 2 + 1] = 1 + i;
+    }
+    VERIFY_HASH(context.hash, expected_hash);
+    assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_TOKENS_ADDED);
+}
+
+static void test_ergo_tx_serializer_box_add_tokens_full_ids(void **state) {
+    (void) state;
+
+    ergo_tx_serializer_box_context_t context;
+    cx_blake2b_t hash;
+    assert_true(ergo_tx_serializer_box_id_hash_init(&hash));
+    assert_int_equal(ergo_tx_serializer_box_init(&context, 12345, 2, 3, 5, 1, &hash),
+                     ERGO_TX_SERIALIZER_BOX_RES_OK);
+    token_calls_t calls = {0};
+    ergo_tx_serializer_box_set_callbacks(&context, NULL, on_token, NULL, &calls);
+
+    uint8_t tree_chunk_array[] = {0x01, 0x02};
+    BUFFER_FROM_ARRAY(tree_chunk, tree_chunk_array, sizeof(tree_chunk_array));
+    ergo_tx_serializer_box_add_tree(&context, &tree_chunk);
+
+    // 5 pairs take two batches, value 200 takes 2 bytes in VLQ
+    uint8_t tokens_array[5 * 40] = {0};
+    uint8_t expected_hash[6 + 5 * 34] = {0xb9, 0x60, 0x01, 0x02, 0x03, 0x05};
+    size_t expected_len = 6;
+    for (uint8_t i = 0; i < 5; i++) {
+        memset(tokens_array + i * 40, 0xB0 + i, ERGO_ID_LEN);
+        tokens_array[i * 40 + 39] = 200 + i;
+        memset(expected_hash + expected_len, 0xB0 + i, ERGO_ID_LEN);
+        expected_len += ERGO_ID_LEN;
+        expected_hash[expected_len++] = 0x80 | (200 + i);
+        expected_hash[expected_len++] = 0x01;
+    }
+    BUFFER_FROM_ARRAY(tokens, tokens_array, sizeof(tokens_array));
+    assert_int_equal(ergo_tx_serializer_box_add_tokens(&context, &tokens, NULL),
+                     ERGO_TX_SERIALIZER_BOX_RES_OK);
+
+    assert_int_equal(calls.calls, 5);
+    for (uint8_t i = 0; i < 5; i++) {
+        assert_int_equal(calls.ids[i], 0xB0 + i);
+        assert_int_equal(calls.values[i], 200 + i);
+    }
+    VERIFY_HASH(context.hash, expected_hash);
+    assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_TOKENS_ADDED);
+}
+
+static void test_ergo_tx_serializer_box_add_tokens_too_many(void **state) {
+    (void) state;
+
+    ERGO_TX_SERIALIZER_BOX_INIT(context);
+
+    uint8_t tree_chunk_array[] = {0x01, 0x02};
+    BUFFER_FROM_ARRAY(tree_chunk, tree_chunk_array, sizeof(tree_chunk_array));
+    ergo_tx_serializer_box_add_tree(&context, &tree_chunk);
+
+    // Box has 2 tokens
+    uint8_t tokens_array[3 * 40] = {0};
+    BUFFER_FROM_ARRAY(tokens, tokens_array, sizeof(tokens_array));
+    assert_int_equal(ergo_tx_serializer_box_add_tokens(&context, &tokens, NULL),
+                     ERGO_TX_SERIALIZER_BOX_RES_ERR_TOO_MANY_TOKENS);
+    assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_ERROR);
+    _cx_blake2b_free_data(&hash);
+}
+
+static void test_ergo_tx_serializer_box_add_tokens_partial_pair(void **state) {
+    (void) state;
+
+    ERGO_TX_SERIALIZER_BOX_INIT(context);
+
+    uint8_t tree_chunk_array[] = {0x01, 0x02};
+    BUFFER_FROM_ARRAY(tree_chunk, tree_chunk_array, sizeof(tree_chunk_array));
+    ergo_tx_serializer_box_add_tree(&context, &tree_chunk);
+
+    // Value of the second token is cut
+    uint8_t tokens_array[40 + 36] = {0};
+    BUFFER_FROM_ARRAY(tokens, tokens_array, sizeof(tokens_array));
+    assert_int_equal(ergo_tx_serializer_box_add_tokens(&context, &tokens, NULL),
+                     ERGO_TX_SERIALIZER_BOX_RES_ERR_BAD_TOKEN_VALUE);
+    assert_int_equal(context.state, ERGO_TX_SERIALIZER_BOX_STATE_ERROR);
+    _cx_blake2b_free_data(&hash);
+}
+
 static void test_ergo_tx_serializer_box_add_registers(void **state) {
     (void) state;
 
@@ -494,6 +698,12 @@ int main() {
         cmocka_unit_test(test_ergo_tx_serializer_box_add_change_tree_bad_state),
         cmocka_unit_test(test_ergo_tx_serializer_box_add_change_tree_bad_hash),
         cmocka_unit_test(test_ergo_tx_serializer_box_add_tokens),
+        cmocka_unit_test(test_ergo_tx_serializer_box_add_tokens_wide_index),
+        cmocka_unit_test(test_ergo_tx_serializer_box_add_tokens_bad_index),
+        cmocka_unit_test(test_ergo_tx_serializer_box_add_tokens_batches),
+        cmocka_unit_test(test_ergo_tx_serializer_box_add_tokens_full_ids),
+        cmocka_unit_test(test_ergo_tx_serializer_box_add_tokens_too_many),
+        cmocka_unit_test(test_ergo_tx_serializer_box_add_tokens_partial_pair),
         cmocka_unit_test(test_ergo_tx_serializer_box_add_registers),
         cmocka_unit_test(test_ergo_tx_serializer_box_id_hash)};
 
@@ -35,12 +35,23 @@ static void test_ergo_tx_serializer_table_init_too_many_tokens(void **state) {
     (void) state;
 
     ergo_tx_serializer_table_context_t context;
-    uint8_t tokens_count = TOKEN_MAX_COUNT + 1;
+    uint16_t tokens_count = TOKEN_MAX_COUNT + 1;
     token_table_t tokens_table = {0};
     assert_int_equal(ergo_tx_serializer_table_init(&context, tokens_count, &tokens_table),
                      ERGO_TX_SERIALIZER_TABLE_RES_ERR_TOO_MANY_TOKENS);
 }
 
+static void test_ergo_tx_serializer_table_init_max_tokens(void **state) {
+    (void) state;
+
+    ergo_tx_serializer_table_context_t context;
+    uint16_t tokens_count = TOKEN_MAX_COUNT;
+    token_table_t tokens_table = {0};
+    assert_int_equal(ergo_tx_serializer_table_init(&context, tokens_count, &tokens_table),
+                     ERGO_TX_SERIALIZER_TABLE_RES_OK);
+    assert_int_equal(context.distinct_tokens_count, TOKEN_MAX_COUNT);
+}
+
 static void test_ergo_tx_serializer_table_add(void **state) {
     (void) state;
 
@@ -167,16 +178,59 @@ static void test_ergo_tx_serializer_table_hash_bad_hash(void **state) {
                      ERGO_TX_SERIALIZER_TABLE_RES_ERR_HASHER);
 }
 
+static void test_ergo_tx_serializer_table_hash_max_tokens(void **state) {
+    (void) state;
+
+    ergo_tx_serializer_table_context_t context;
+    token_table_t tokens_table = {0};
+    ergo_tx_serializer_table_init(&context, TOKEN_MAX_COUNT, &tokens_table);
+    // 7 ids per chunk, as in APDU
+    uint8_t tokens_array[7 * ERGO_ID_LEN];
+    uint16_t added = 0;
+    while (added < TOKEN_MAX_COUNT) {
+        uint16_t chunk = TOKEN_MAX_COUNT - added > 7 ? 7 : TOKEN_MAX_COUNT - added;
+        for (uint16_t i = 0; i < chunk; i++) {
+            memset(tokens_array + i * ERGO_ID_LEN, (uint8_t) (added + i), ERGO_ID_LEN);
+        }
+        BUFFER_FROM_ARRAY(tokens, tokens_array, chunk * ERGO_ID_LEN);
+        added += chunk;
+        assert_int_equal(ergo_tx_serializer_table_add(&context, &tokens),
+                         added < TOKEN_MAX_COUNT ? ERGO_TX_SERIALIZER_TABLE_RES_MORE_DATA
+                                                 : ERGO_TX_SERIALIZER_TABLE_RES_OK);
+    }
+    assert_int_equal(tokens_table.count, TOKEN_MAX_COUNT);
+    uint8_t last_id[ERGO_ID_LEN];
+    memset(last_id, TOKEN_MAX_COUNT - 1, ERGO_ID_LEN);
+    assert_int_equal(token_table_find_token_index(&tokens_table, last_id), TOKEN_MAX_COUNT - 1);
+    assert_int_equal(token_table_add_token(&tokens_table, last_id), INDEX16_NOT_EXIST);
+
+    cx_blake2b_t hash;
+    blake2b_256_init(&hash);
+    assert_int_equal(ergo_tx_serializer_table_hash(&context, &hash),
+                     ERGO_TX_SERIALIZER_TABLE_RES_OK);
+    uint8_t *data;
+    size_t data_len;
+    _cx_blake2b_get_data(&hash, &data, &data_len);
+    // 255 is 2 bytes in VLQ
+    assert_int_equal(data_len, 2 + TOKEN_MAX_COUNT * ERGO_ID_LEN);
+    assert_int_equal(data[0], 0xFF);
+    assert_int_equal(data[1], 0x01);
+    assert_memory_equal(data + data_len - ERGO_ID_LEN, last_id, ERGO_ID_LEN);
+    _cx_blake2b_free_data(&hash);
+}
+
 int main() {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_ergo_tx_serializer_table_init),
         cmocka_unit_test(test_ergo_tx_serializer_table_init_too_many_tokens),
+        cmocka_unit_test(test_ergo_tx_serializer_table_init_max_tokens),
         cmocka_unit_test(test_ergo_tx_serializer_table_add),
         cmocka_unit_test(test_ergo_tx_serializer_table_add_too_many_tokens),
         cmocka_unit_test(test_ergo_tx_serializer_table_add_bad_token_id),
         cmocka_unit_test(test_ergo_tx_serializer_table_add_more_data),
         cmocka_unit_test(test_ergo_tx_serializer_table_hash),
-        cmocka_unit_test(test_ergo_tx_serializer_table_hash_bad_hash)};
+        cmocka_unit_test(test_ergo_tx_serializer_table_hash_bad_hash),
+        cmocka_unit_test(test_ergo_tx_serializer_table_hash_max_tokens)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
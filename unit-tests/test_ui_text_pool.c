@@ -0,0 +1,128 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "ui/ui_text_pool.h"
+
+static void test_ui_text_pool_not_attached(void **state) {
+    (void) state;
+
+    bool is_cached = true;
+    ui_text_pool_detach();
+    assert_false(ui_text_pool_is_attached());
+    assert_null(ui_text_pool_page(0, &is_cached));
+    assert_false(is_cached);
+}
+
+static void test_ui_text_pool_page_cached(void **state) {
+    (void) state;
+
+    static ui_text_pool_t pool;
+    memset(&pool, 0xFF, sizeof(pool));
+    ui_text_pool_attach(&pool);
+    assert_true(ui_text_pool_is_attached());
+
+    bool is_cached = true;
+    ui_text_page_t *page = ui_text_pool_page(5, &is_cached);
+    assert_non_null(page);
+    assert_false(is_cached);
+    strcpy(page->title, "Fee");
+
+    assert_ptr_equal(ui_text_pool_page(5, &is_cached), page);
+    assert_true(is_cached);
+    assert_string_equal(page->title, "Fee");
+    assert_true(ui_text_pool_page_position(page) < UI_TEXT_POOL_PAGES);
+
+    // Released page is formatted again
+    ui_text_pool_release(page);
+    assert_ptr_equal(ui_text_pool_page(5, &is_cached), page);
+    assert_false(is_cached);
+
+    ui_text_pool_detach();
+}
+
+static void test_ui_text_pool_lru(void **state) {
+    (void) state;
+
+    static ui_text_pool_t pool;
+    ui_text_pool_attach(&pool);
+
+    bool is_cached = false;
+    ui_text_page_t *first = ui_text_pool_page(0, &is_cached);
+    for (uint8_t i = 1; i < UI_TEXT_POOL_PAGES; i++) {
+        assert_true(ui_text_pool_page(i, &is_cached) != first);
+        assert_false(is_cached);
+    }
+    // Keep the first page recently used, the second one is evicted
+    ui_text_pool_page(0, &is_cached);
+    assert_true(is_cached);
+    ui_text_page_t *page = ui_text_pool_page(UI_TEXT_POOL_PAGES, &is_cached);
+    assert_false(is_cached);
+    assert_true(page != first);
+    ui_text_pool_page(1, &is_cached);
+    assert_false(is_cached);
+    assert_ptr_equal(ui_text_pool_page(0, &is_cached), first);
+    assert_true(is_cached);
+
+    ui_text_pool_detach();
+}
+
+static void test_ui_text_pool_aging(void **state) {
+    (void) state;
+
+    static ui_text_pool_t pool;
+    ui_text_pool_attach(&pool);
+
+    // Paging back and forth over two screens overflows use ticks
+    bool is_cached = false;
+    ui_text_page_t *first = ui_text_pool_page(0, &is_cached);
+    ui_text_page_t *second = ui_text_pool_page(1, &is_cached);
+    for (uint16_t i = 0; i < 300; i++) {
+        assert_ptr_equal(ui_text_pool_page(i % 2, &is_cached), i % 2 == 0 ? first : second);
+        assert_true(is_cached);
+    }
+    // Unused pages are allocated before the used ones
+    for (uint8_t i = 2; i < UI_TEXT_POOL_PAGES; i++) {
+        ui_text_page_t *page = ui_text_pool_page(i, &is_cached);
+        assert_true(page != first);
+        assert_true(page != second);
+    }
+
+    ui_text_pool_detach();
+}
+
+static void test_ui_text_pool_wide_keys(void **state) {
+    (void) state;
+
+    static ui_text_pool_t pool;
+    ui_text_pool_attach(&pool);
+
+    // Screens of long reviews have 16-bit indexes, 300 isn't the screen 44
+    bool is_cached = false;
+    ui_text_page_t *low = ui_text_pool_page(44, &is_cached);
+    strcpy(low->title, "Token [22]");
+    ui_text_page_t *high = ui_text_pool_page(300, &is_cached);
+    assert_false(is_cached);
+    assert_true(high != low);
+    assert_int_equal(high->key, 300);
+    assert_ptr_equal(ui_text_pool_page(44, &is_cached), low);
+    assert_true(is_cached);
+    assert_string_equal(low->title, "Token [22]");
+
+    ui_text_pool_detach();
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_ui_text_pool_not_attached),
+                                       cmocka_unit_test(test_ui_text_pool_page_cached),
+                                       cmocka_unit_test(test_ui_text_pool_lru),
+                                       cmocka_unit_test(test_ui_text_pool_aging),
+                                       cmocka_unit_test(test_ui_text_pool_wide_keys)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
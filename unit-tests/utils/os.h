@@ -1,3 +1,6 @@
 #pragma once
 
-#define PIC(x) (x)
\ No newline at end of file
+#define PIC(x) (x)
+
+// defined by the tests using NVM storage
+void nvm_write(void *dst_adr, void *src_adr, unsigned int src_len);